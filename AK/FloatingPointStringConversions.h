@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Optional.h>
+#include <AK/Types.h>
+#include <AK/Vector.h>
+
+namespace AK {
+
+// A decimal number `significand * 10^exponent`.
+struct FloatingPointDecimal {
+    u64 significand { 0 };
+    i32 exponent { 0 };
+};
+
+// Finds the shortest decimal number that parses back to `value`, or the one closest to `value` if there are several (using Ryu).
+// `value` must be finite and greater than zero.
+FloatingPointDecimal convert_to_shortest_decimal(double value);
+
+// The digits of a rounded decimal number `d.ddd * 10^exponent`, without trailing zeroes. No digits means zero.
+struct DecimalDigits {
+    Vector<u8, 32> digits;
+    i32 exponent { 0 };
+};
+
+// These round the exact value of `value` (which must be finite and not negative) half to even, like printf does.
+DecimalDigits round_to_decimal_place(double value, i32 lowest_place);
+DecimalDigits round_to_significant_digits(double value, u32 count);
+
+enum class FloatingPointError {
+    None,
+    NoOrInvalidInput,
+    OutOfRange,
+    RoundedDownToZero,
+};
+
+struct FloatingPointParseResults {
+    const char* end_ptr { nullptr };
+    FloatingPointError error { FloatingPointError::None };
+    double value { 0 };
+};
+
+// Parses `[+-]digits[.digits][(e|E)[+-]digits]` (where either set of digits around the dot may be empty, but not both) from the
+// start of the input, and stops at the first character that doesn't fit. Results are always correctly rounded (using Eisel-Lemire,
+// with an exact fallback for the rare cases where that can't decide).
+FloatingPointParseResults parse_first_floating_point(const char* start, const char* end);
+
+// Like the above, but fails unless all of the input is a number.
+Optional<double> parse_floating_point_completely(const char* start, const char* end);
+
+}
+
+using AK::convert_to_shortest_decimal;
+using AK::DecimalDigits;
+using AK::FloatingPointDecimal;
+using AK::FloatingPointError;
+using AK::FloatingPointParseResults;
+using AK::parse_first_floating_point;
+using AK::parse_floating_point_completely;
+using AK::round_to_decimal_place;
+using AK::round_to_significant_digits;
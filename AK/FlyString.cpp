@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Atomic.h>
 #include <AK/FlyString.h>
 #include <AK/HashTable.h>
 #include <AK/Optional.h>
@@ -31,9 +32,31 @@ static HashTable<StringImpl*, FlyStringImplTraits>& fly_impls()
     return *s_table;
 }
 
+// FlyStrings are also created off the main thread (e.g. by JS::Parser), so the table is
+// guarded by a simple spinlock. It's only ever held for a single table operation.
+static Atomic<bool> s_table_lock;
+
+class FlyStringTableLocker {
+public:
+    FlyStringTableLocker()
+    {
+        while (s_table_lock.exchange(true, AK::memory_order_acquire))
+            ;
+    }
+
+    ~FlyStringTableLocker()
+    {
+        s_table_lock.store(false, AK::memory_order_release);
+    }
+};
+
 void FlyString::did_destroy_impl(Badge<StringImpl>, StringImpl& impl)
 {
-    fly_impls().remove(&impl);
+    FlyStringTableLocker locker;
+    // NOTE: Another thread may already have replaced this dying impl with an equal one.
+    auto it = fly_impls().find(&impl);
+    if (it != fly_impls().end() && *it == &impl)
+        fly_impls().remove(it);
 }
 
 FlyString::FlyString(const String& string)
@@ -44,15 +67,19 @@ FlyString::FlyString(const String& string)
         m_impl = string.impl();
         return;
     }
+    FlyStringTableLocker locker;
     auto it = fly_impls().find(const_cast<StringImpl*>(string.impl()));
-    if (it == fly_impls().end()) {
-        fly_impls().set(const_cast<StringImpl*>(string.impl()));
-        string.impl()->set_fly({}, true);
-        m_impl = string.impl();
-    } else {
+    if (it != fly_impls().end()) {
         VERIFY((*it)->is_fly());
-        m_impl = *it;
+        // If the impl we found is currently being destroyed on another thread, we replace it below.
+        if ((*it)->try_ref()) {
+            m_impl = adopt_ref(**it);
+            return;
+        }
     }
+    fly_impls().set(const_cast<StringImpl*>(string.impl()));
+    string.impl()->set_fly({}, true);
+    m_impl = string.impl();
 }
 
 FlyString::FlyString(const StringView& string)
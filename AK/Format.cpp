@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/FloatingPointStringConversions.h>
 #include <AK/Format.h>
 #include <AK/GenericLexer.h>
 #include <AK/String.h>
@@ -346,10 +347,44 @@ void FormatBuilder::put_f64(
     if (is_negative)
         value = -value;
 
+    if (base == 10) {
+        if (is_negative)
+            string_builder.append('-');
+        else if (sign_mode == SignMode::Always)
+            string_builder.append('+');
+        else if (sign_mode == SignMode::Reserved)
+            string_builder.append(' ');
+
+        if (__builtin_isnan(value) || __builtin_isinf(value)) {
+            string_builder.append(__builtin_isnan(value) ? "nan" : "inf");
+        } else {
+            // Trailing zeroes are left out, so we print exactly the digits we get.
+            auto decimal = round_to_decimal_place(value, -static_cast<i32>(precision));
+            auto digit_at = [&](i32 place) -> char {
+                i32 index = decimal.exponent - place;
+                if (index < 0 || static_cast<size_t>(index) >= decimal.digits.size())
+                    return '0';
+                return '0' + decimal.digits[index];
+            };
+            i32 highest_place = decimal.digits.is_empty() ? 0 : max(decimal.exponent, 0);
+            for (i32 place = highest_place; place >= 0; --place)
+                string_builder.append(digit_at(place));
+            i32 lowest_place = decimal.digits.is_empty() ? 0 : decimal.exponent - static_cast<i32>(decimal.digits.size()) + 1;
+            if (lowest_place < 0) {
+                string_builder.append('.');
+                for (i32 place = -1; place >= lowest_place; --place)
+                    string_builder.append(digit_at(place));
+            }
+        }
+
+        put_string(string_builder.string_view(), align, min_width, NumericLimits<size_t>::max(), fill);
+        return;
+    }
+
     format_builder.put_u64(static_cast<u64>(value), base, false, upper_case, false, Align::Right, 0, ' ', sign_mode, is_negative);
 
     if (precision > 0) {
-        // FIXME: This is a terrible approximation but doing it properly would be a lot of work. If someone is up for that, a good
+        // FIXME: This is a terrible approximation (which only hexadecimal floats still use), but doing it properly would be a lot of work. If someone is up for that, a good
         // place to start would be the following video from CppCon 2019:
         // https://youtu.be/4P_kbF0EbZM (Stephan T. Lavavej “Floating-Point <charconv>: Making Your Code 10x Faster With C++17's Final Boss”)
         value -= static_cast<i64>(value);
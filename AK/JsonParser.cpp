@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/FloatingPointStringConversions.h>
 #include <AK/JsonArray.h>
 #include <AK/JsonObject.h>
 #include <AK/JsonParser.h>
@@ -153,73 +154,72 @@ Optional<JsonValue> JsonParser::parse_number()
 {
     JsonValue value;
     Vector<char, 128> number_buffer;
-    Vector<char, 128> fraction_buffer;
 
+#ifndef KERNEL
     bool is_double = false;
+#endif
     for (;;) {
         char ch = peek();
+        if (ch >= '0' && ch <= '9') {
+            number_buffer.append(ch);
+            ++m_index;
+            continue;
+        }
+        // A sign is only allowed at the very start and at the start of the exponent.
+        if ((ch == '-' || ch == '+') && (number_buffer.is_empty() || number_buffer.last() == 'e' || number_buffer.last() == 'E')) {
+            number_buffer.append(ch);
+            ++m_index;
+            continue;
+        }
         if (ch == '.') {
+#ifndef KERNEL
             is_double = true;
+#endif
+            number_buffer.append(ch);
             ++m_index;
             continue;
         }
-        if (ch == '-' || (ch >= '0' && ch <= '9')) {
-            if (is_double)
-                fraction_buffer.append(ch);
-            else
-                number_buffer.append(ch);
+#ifndef KERNEL
+        // NOTE: The kernel can't do anything sensible with an exponent, so the number ends in front of it there,
+        //       which makes whatever contains the number fail to parse.
+        if (ch == 'e' || ch == 'E') {
+            is_double = true;
+            number_buffer.append(ch);
             ++m_index;
             continue;
         }
+#endif
         break;
     }
 
     StringView number_string(number_buffer.data(), number_buffer.size());
-    StringView fraction_string(fraction_buffer.data(), fraction_buffer.size());
 
 #ifndef KERNEL
     if (is_double) {
-        // FIXME: This logic looks shaky.
-        int whole = 0;
-        auto to_signed_result = number_string.to_uint();
-        if (to_signed_result.has_value()) {
-            whole = to_signed_result.value();
-        } else {
-            auto number = number_string.to_int();
-            if (!number.has_value())
-                return {};
-            whole = number.value();
-        }
-
-        auto fraction_string_uint = fraction_string.to_uint();
-        if (!fraction_string_uint.has_value())
+        auto number = parse_floating_point_completely(number_buffer.data(), number_buffer.data() + number_buffer.size());
+        if (!number.has_value())
             return {};
-        int fraction = fraction_string_uint.value();
-        fraction *= (whole < 0) ? -1 : 1;
+        return JsonValue(number.value());
+    }
+#else
+    // There's no floating point in the kernel, so we just drop the fraction.
+    if (auto dot = number_string.find_first_of('.'); dot.has_value())
+        number_string = number_string.substring_view(0, dot.value());
+#endif
 
-        auto divider = 1;
-        for (size_t i = 0; i < fraction_buffer.size(); ++i) {
-            divider *= 10;
-        }
-        value = JsonValue((double)whole + ((double)fraction / divider));
+    auto to_unsigned_result = number_string.to_uint();
+    if (to_unsigned_result.has_value()) {
+        value = JsonValue(to_unsigned_result.value());
     } else {
-#endif
-        auto to_unsigned_result = number_string.to_uint();
-        if (to_unsigned_result.has_value()) {
-            value = JsonValue(to_unsigned_result.value());
+        auto number = number_string.to_int<i64>();
+        if (!number.has_value())
+            return {};
+        if (number.value() <= NumericLimits<i32>::max()) {
+            value = JsonValue((i32)number.value());
         } else {
-            auto number = number_string.to_int<i64>();
-            if (!number.has_value())
-                return {};
-            if (number.value() <= NumericLimits<i32>::max()) {
-                value = JsonValue((i32)number.value());
-            } else {
-                value = JsonValue(number.value());
-            }
+            value = JsonValue(number.value());
         }
-#ifndef KERNEL
     }
-#endif
 
     return value;
 }
@@ -8,6 +8,9 @@
 
 #include <AK/Format.h>
 #include <AK/StdLibExtras.h>
+#ifndef KERNEL
+#    include <AK/FloatingPointStringConversions.h>
+#endif
 #include <AK/Types.h>
 #include <stdarg.h>
 
@@ -158,28 +161,122 @@ ALWAYS_INLINE int print_u64(PutChFunc putch, char*& bufptr, u64 number, bool lef
     return field_width;
 }
 
-template<typename PutChFunc>
-ALWAYS_INLINE int print_double(PutChFunc putch, char*& bufptr, double number, bool left_pad, bool zero_pad, u32 field_width, u32 fraction_length)
+#ifndef KERNEL
+// Calls `emit` twice, once to find out how long the number is for padding, and once more to actually print it.
+template<typename PutChFunc, typename EmitFunc>
+ALWAYS_INLINE int print_floating_point(PutChFunc putch, char*& bufptr, bool is_negative, EmitFunc emit, bool left_pad, bool zero_pad, u32 field_width, bool always_sign)
 {
-    int length = 0;
+    u32 length = is_negative || always_sign;
+    emit([&](char) { ++length; });
+    u32 padding = field_width > length ? field_width - length : 0;
 
-    if (number < 0) {
+    if (!left_pad && !zero_pad) {
+        for (u32 i = 0; i < padding; ++i)
+            putch(bufptr, ' ');
+    }
+    if (is_negative)
         putch(bufptr, '-');
-        length++;
-        number = 0 - number;
+    else if (always_sign)
+        putch(bufptr, '+');
+    if (!left_pad && zero_pad) {
+        for (u32 i = 0; i < padding; ++i)
+            putch(bufptr, '0');
+    }
+    emit([&](char ch) { putch(bufptr, ch); });
+    if (left_pad) {
+        for (u32 i = 0; i < padding; ++i)
+            putch(bufptr, ' ');
     }
+    return length + padding;
+}
+
+// Prints all the places from the highest digit (or the ones) down to `lowest_place`.
+template<typename SinkFunc>
+ALWAYS_INLINE void emit_fixed_point(SinkFunc sink, const DecimalDigits& decimal, i32 lowest_place, bool alternate_form)
+{
+    auto digit_at = [&](i32 place) -> char {
+        i32 index = decimal.exponent - place;
+        if (index < 0 || static_cast<size_t>(index) >= decimal.digits.size())
+            return '0';
+        return '0' + decimal.digits[index];
+    };
+    i32 highest_place = decimal.digits.is_empty() ? 0 : max(decimal.exponent, 0);
+    for (i32 place = highest_place; place >= 0; --place)
+        sink(digit_at(place));
+    if (lowest_place < 0 || alternate_form)
+        sink('.');
+    for (i32 place = -1; place >= lowest_place; --place)
+        sink(digit_at(place));
+}
 
-    length = print_u64(putch, bufptr, (i64)number, left_pad, zero_pad, field_width);
-    putch(bufptr, '.');
-    length++;
-    double fraction = number - (i64)number;
+template<typename SinkFunc>
+ALWAYS_INLINE void emit_exponential(SinkFunc sink, const DecimalDigits& decimal, size_t digits_count, bool alternate_form)
+{
+    for (size_t i = 0; i < digits_count; ++i) {
+        sink(i < decimal.digits.size() ? '0' + decimal.digits[i] : '0');
+        if (i == 0 && (digits_count > 1 || alternate_form))
+            sink('.');
+    }
+    i32 exponent = decimal.digits.is_empty() ? 0 : decimal.exponent;
+    sink('e');
+    sink(exponent < 0 ? '-' : '+');
+    u32 magnitude = exponent < 0 ? -exponent : exponent;
+    if (magnitude >= 100)
+        sink('0' + magnitude / 100);
+    sink('0' + magnitude / 10 % 10);
+    sink('0' + magnitude % 10);
+}
 
-    for (u32 i = 0; i < fraction_length; ++i)
-        fraction = fraction * 10;
+template<typename PutChFunc>
+ALWAYS_INLINE int print_nan_or_infinity(PutChFunc putch, char*& bufptr, double number, bool left_pad, u32 field_width, bool always_sign)
+{
+    const char* text = __builtin_isnan(number) ? "nan" : "inf";
+    auto emit = [&](auto sink) {
+        for (auto* ch = text; *ch; ++ch)
+            sink(*ch);
+    };
+    return print_floating_point(putch, bufptr, __builtin_signbit(number), emit, left_pad, false, field_width, always_sign);
+}
 
-    return length + print_u64(putch, bufptr, (i64)fraction, false, true, fraction_length);
+template<typename PutChFunc>
+ALWAYS_INLINE int print_double(PutChFunc putch, char*& bufptr, double number, bool left_pad, bool zero_pad, u32 field_width, u32 fraction_length, bool always_sign, bool alternate_form)
+{
+    if (__builtin_isnan(number) || __builtin_isinf(number))
+        return print_nan_or_infinity(putch, bufptr, number, left_pad, field_width, always_sign);
+
+    bool is_negative = __builtin_signbit(number);
+    i32 lowest_place = -static_cast<i32>(fraction_length);
+    auto decimal = round_to_decimal_place(is_negative ? -number : number, lowest_place);
+    auto emit = [&](auto sink) { emit_fixed_point(sink, decimal, lowest_place, alternate_form); };
+    return print_floating_point(putch, bufptr, is_negative, emit, left_pad, zero_pad, field_width, always_sign);
 }
 
+template<typename PutChFunc>
+ALWAYS_INLINE int print_double_with_significant_digits(PutChFunc putch, char*& bufptr, double number, bool left_pad, bool zero_pad, u32 field_width, u32 precision, bool always_sign, bool alternate_form)
+{
+    if (__builtin_isnan(number) || __builtin_isinf(number))
+        return print_nan_or_infinity(putch, bufptr, number, left_pad, field_width, always_sign);
+
+    // This is %g, which uses whichever of %f and %e is shorter, and leaves out trailing zeroes (unless asked not to).
+    bool is_negative = __builtin_signbit(number);
+    if (precision == 0)
+        precision = 1;
+    auto decimal = round_to_significant_digits(is_negative ? -number : number, precision);
+    i32 exponent = decimal.digits.is_empty() ? 0 : decimal.exponent;
+    if (exponent >= -4 && exponent < static_cast<i32>(precision)) {
+        i32 lowest_place = exponent - static_cast<i32>(precision) + 1;
+        if (!alternate_form)
+            lowest_place = min(0, exponent - static_cast<i32>(decimal.digits.size()) + 1);
+        auto emit = [&](auto sink) { emit_fixed_point(sink, decimal, lowest_place, alternate_form); };
+        return print_floating_point(putch, bufptr, is_negative, emit, left_pad, zero_pad, field_width, always_sign);
+    }
+
+    size_t digits_count = alternate_form ? precision : max(decimal.digits.size(), static_cast<size_t>(1));
+    auto emit = [&](auto sink) { emit_exponential(sink, decimal, digits_count, alternate_form); };
+    return print_floating_point(putch, bufptr, is_negative, emit, left_pad, zero_pad, field_width, always_sign);
+}
+#endif
+
 template<typename PutChFunc>
 ALWAYS_INLINE int print_i64(PutChFunc putch, char*& bufptr, i64 number, bool left_pad, bool zero_pad, u32 field_width)
 {
@@ -319,14 +416,16 @@ struct PrintfImpl {
     {
         return print_hex(m_putch, m_bufptr, NextArgument<u64>()(ap), false, false, state.left_pad, state.zero_pad, 16);
     }
+#ifndef KERNEL
     ALWAYS_INLINE int format_g(const ModifierState& state, ArgumentListRefT ap) const
     {
-        return format_f(state, ap);
+        return print_double_with_significant_digits(m_putch, m_bufptr, NextArgument<double>()(ap), state.left_pad, state.zero_pad, state.field_width, state.fraction_length, state.always_sign, state.alternate_form);
     }
     ALWAYS_INLINE int format_f(const ModifierState& state, ArgumentListRefT ap) const
     {
-        return print_double(m_putch, m_bufptr, NextArgument<double>()(ap), state.left_pad, state.zero_pad, state.field_width, state.fraction_length);
+        return print_double(m_putch, m_bufptr, NextArgument<double>()(ap), state.left_pad, state.zero_pad, state.field_width, state.fraction_length, state.always_sign, state.alternate_form);
     }
+#endif
     ALWAYS_INLINE int format_o(const ModifierState& state, ArgumentListRefT ap) const
     {
         if (state.alternate_form)
@@ -422,7 +521,7 @@ ALWAYS_INLINE int printf_internal(PutChFunc putch, char* buffer, const char*& fm
                 if (*(p + 1))
                     goto one_more;
             }
-            if (!state.zero_pad && !state.field_width && *p == '0') {
+            if (!state.zero_pad && !state.field_width && !state.dot && *p == '0') {
                 state.zero_pad = true;
                 if (*(p + 1))
                     goto one_more;
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/BitCast.h>
+#include <AK/FloatingPointStringConversions.h>
+#include <AK/StringView.h>
+
+static void expect_shortest(double value, u64 significand, i32 exponent)
+{
+    auto decimal = convert_to_shortest_decimal(value);
+    EXPECT_EQ(decimal.significand, significand);
+    EXPECT_EQ(decimal.exponent, exponent);
+}
+
+static Optional<double> parse(const StringView& string)
+{
+    return parse_floating_point_completely(string.characters_without_null_termination(), string.characters_without_null_termination() + string.length());
+}
+
+static void expect_parsed(const StringView& string, double expected)
+{
+    auto value = parse(string);
+    EXPECT(value.has_value());
+    EXPECT_EQ(value.value_or(0), expected);
+}
+
+static void expect_parsed_bits(const StringView& string, u64 bits)
+{
+    auto value = parse(string);
+    EXPECT(value.has_value());
+    EXPECT_EQ(bit_cast<u64>(value.value_or(0)), bits);
+}
+
+static void expect_digits(const DecimalDigits& decimal, const StringView& digits, i32 exponent)
+{
+    EXPECT_EQ(decimal.digits.size(), digits.length());
+    for (size_t i = 0; i < min(decimal.digits.size(), digits.length()); ++i)
+        EXPECT_EQ(decimal.digits[i], digits[i] - '0');
+    if (!digits.is_empty())
+        EXPECT_EQ(decimal.exponent, exponent);
+}
+
+TEST_CASE(shortest_decimal)
+{
+    expect_shortest(1.0, 1, 0);
+    expect_shortest(1.5, 15, -1);
+    expect_shortest(100.0, 1, 2);
+    expect_shortest(0.1, 1, -1);
+    expect_shortest(0.1 + 0.2, 30000000000000004, -17);
+    expect_shortest(1e23, 1, 23);
+    expect_shortest(9007199254740993.0, 9007199254740992, 0);
+    expect_shortest(5e-324, 5, -324);
+    expect_shortest(2.2250738585072014e-308, 22250738585072014, -324);
+    expect_shortest(1.7976931348623157e308, 17976931348623157, 292);
+}
+
+TEST_CASE(parse_valid_numbers)
+{
+    expect_parsed("0", 0.0);
+    expect_parsed("-1", -1.0);
+    expect_parsed("+1.5", 1.5);
+    expect_parsed("1.", 1.0);
+    expect_parsed(".25", 0.25);
+    expect_parsed("1e3", 1000.0);
+    expect_parsed("1E-3", 0.001);
+    expect_parsed("0.30000000000000004", 0.1 + 0.2);
+    expect_parsed("123456789012345678901234567890", 123456789012345678901234567890.0);
+    expect_parsed("0.000000000000000000000000000000000000000000001e45", 1.0);
+}
+
+TEST_CASE(parse_invalid_numbers)
+{
+    EXPECT(!parse("").has_value());
+    EXPECT(!parse(".").has_value());
+    EXPECT(!parse("-").has_value());
+    EXPECT(!parse("1e").has_value());
+    EXPECT(!parse("1e+").has_value());
+    EXPECT(!parse("1.5x").has_value());
+    EXPECT(!parse("--1").has_value());
+
+    StringView string = "1.5e+x";
+    auto result = parse_first_floating_point(string.characters_without_null_termination(), string.characters_without_null_termination() + string.length());
+    EXPECT_EQ(result.value, 1.5);
+    EXPECT_EQ(result.end_ptr, string.characters_without_null_termination() + 3);
+}
+
+TEST_CASE(parse_is_correctly_rounded)
+{
+    // Exactly halfway between 1 and the next double, which rounds to even.
+    expect_parsed_bits("1.00000000000000011102230246251565404236316680908203125", 0x3ff0000000000000);
+    expect_parsed_bits("1.00000000000000011102230246251565404236316680908203126", 0x3ff0000000000001);
+    // Halfway between the two doubles around 2^53 + 1, with more digits than fit into 64 bits.
+    expect_parsed_bits("9007199254740993", 0x4340000000000000);
+    expect_parsed_bits("9007199254740993.0000000000000000000000000001", 0x4340000000000001);
+    // Subnormals, and the edges of the range.
+    expect_parsed_bits("2.4703282292062327e-324", 0);
+    expect_parsed_bits("2.4703282292062328e-324", 1);
+    expect_parsed_bits("2.2250738585072011e-308", 0x000fffffffffffff);
+    expect_parsed_bits("1.7976931348623158e308", 0x7fefffffffffffff);
+    expect_parsed_bits("1.7976931348623159e308", 0x7ff0000000000000);
+
+    StringView string = "1e-400";
+    auto result = parse_first_floating_point(string.characters_without_null_termination(), string.characters_without_null_termination() + string.length());
+    EXPECT_EQ(result.error, FloatingPointError::RoundedDownToZero);
+    string = "-1e400";
+    result = parse_first_floating_point(string.characters_without_null_termination(), string.characters_without_null_termination() + string.length());
+    EXPECT_EQ(result.error, FloatingPointError::OutOfRange);
+    EXPECT_EQ(result.value, -__builtin_huge_val());
+}
+
+TEST_CASE(round_to_decimal_place)
+{
+    expect_digits(round_to_decimal_place(0.0, 0), "", 0);
+    expect_digits(round_to_decimal_place(1.25, -1), "12", 0);
+    expect_digits(round_to_decimal_place(1.35, -1), "14", 0);
+    expect_digits(round_to_decimal_place(0.15, -1), "1", -1);
+    expect_digits(round_to_decimal_place(2.5, 0), "2", 0);
+    expect_digits(round_to_decimal_place(9.96, -1), "1", 1);
+    expect_digits(round_to_decimal_place(0.4, 0), "", 0);
+    expect_digits(round_to_decimal_place(0.6, 0), "1", 0);
+    expect_digits(round_to_decimal_place(0.1, -20), "10000000000000000555", -1);
+    expect_digits(round_to_decimal_place(1e23, 0), "99999999999999991611392", 22);
+}
+
+TEST_CASE(round_to_significant_digits)
+{
+    expect_digits(round_to_significant_digits(123456.0, 3), "123", 5);
+    expect_digits(round_to_significant_digits(0.000123456, 2), "12", -4);
+    expect_digits(round_to_significant_digits(999.9, 3), "1", 3);
+    expect_digits(round_to_significant_digits(5e-324, 3), "494", -324);
+    expect_digits(round_to_significant_digits(1e23, 17), "99999999999999992", 22);
+}
@@ -247,9 +247,15 @@ TEST_CASE(no_precision_no_trailing_number)
     EXPECT_EQ(String::formatted("{:.0}", 0.1), "0");
 }
 
-TEST_CASE(yay_this_implementation_sucks)
+TEST_CASE(floating_point_rounding)
 {
-    EXPECT_EQ(String::formatted("{:.0}", .99999999999), "0");
+    EXPECT_EQ(String::formatted("{:.0}", .99999999999), "1");
+    EXPECT_EQ(String::formatted("{:.1}", 0.66), "0.7");
+    EXPECT_EQ(String::formatted("{:.2}", 2.675), "2.67");
+    EXPECT_EQ(String::formatted("{}", 0.3), "0.3");
+    EXPECT_EQ(String::formatted("{}", 1.0 / 3), "0.333333");
+    EXPECT_EQ(String::formatted("{}", 1e20), "100000000000000000000");
+    EXPECT_EQ(String::formatted("{:+}", 2.5), "+2.5");
 }
 
 TEST_CASE(magnitude_less_than_zero)
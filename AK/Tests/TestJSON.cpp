@@ -98,3 +98,18 @@ TEST_CASE(json_duplicate_keys)
     json.set("test", "baz");
     EXPECT_EQ(json.to_string(), "{\"test\":\"baz\"}");
 }
+
+TEST_CASE(json_numbers)
+{
+    EXPECT_EQ(JsonValue::from_string("1e3").value().as_double(), 1000.0);
+    EXPECT_EQ(JsonValue::from_string("-2.5E-1").value().as_double(), -0.25);
+    EXPECT_EQ(JsonValue::from_string("1.5e+2").value().as_double(), 150.0);
+    EXPECT_EQ(JsonValue::from_string("-12").value().as_i32(), -12);
+
+    // Signs are only allowed at the start of the number and of its exponent.
+    EXPECT(!JsonValue::from_string("1-2").has_value());
+    EXPECT(!JsonValue::from_string("1.5+3").has_value());
+    EXPECT(!JsonValue::from_string("--1").has_value());
+    EXPECT(!JsonValue::from_string("1e3-").has_value());
+    EXPECT(!JsonValue::from_string("[1, 2-3]").has_value());
+}
@@ -71,6 +71,7 @@ set(TLS_DEBUG ON)
 set(SPAM_DEBUG ON)
 set(SQL_DEBUG ON)
 set(PARSER_DEBUG ON)
+set(PRELOAD_SCANNER_DEBUG ON)
 set(TOKENIZER_TRACE_DEBUG ON)
 set(IMAGE_LOADER_DEBUG ON)
 set(RESOURCE_DEBUG ON)
@@ -15,6 +15,8 @@
 #include <AK/StringBuilder.h>
 #include <Applications/Browser/TabGML.h>
 #include <LibCore/ConfigFile.h>
+#include <LibCore/File.h>
+#include <LibCore/StandardPaths.h>
 #include <LibGUI/Action.h>
 #include <LibGUI/Application.h>
 #include <LibGUI/BoxLayout.h>
@@ -23,6 +25,7 @@
 #include <LibGUI/InputBox.h>
 #include <LibGUI/Menu.h>
 #include <LibGUI/Menubar.h>
+#include <LibGUI/MessageBox.h>
 #include <LibGUI/Statusbar.h>
 #include <LibGUI/TabWidget.h>
 #include <LibGUI/TextBox.h>
@@ -30,6 +33,9 @@
 #include <LibGUI/ToolbarContainer.h>
 #include <LibGUI/Window.h>
 #include <LibJS/Interpreter.h>
+#include <LibJS/Profiler.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibWeb/Bindings/MainThreadVM.h>
 #include <LibWeb/Dump.h>
 #include <LibWeb/InProcessWebView.h>
 #include <LibWeb/Layout/BlockBox.h>
@@ -69,6 +75,17 @@ void Tab::start_download(const URL& url)
     [[maybe_unused]] auto& unused = window.leak_ref();
 }
 
+void Tab::save_js_profile(const String& profile)
+{
+    auto path = String::formatted("{}/js-profile.perfcore", Core::StandardPaths::home_directory());
+    auto file_or_error = Core::File::open(path, Core::IODevice::WriteOnly);
+    if (file_or_error.is_error() || !file_or_error.value()->write(profile)) {
+        GUI::MessageBox::show_error(window(), String::formatted("Unable to save JavaScript profile to {}", path));
+        return;
+    }
+    GUI::MessageBox::show(window(), String::formatted("JavaScript profile saved to {}, open it with the Profiler.", path), "JavaScript Profile", GUI::MessageBox::Type::Information);
+}
+
 void Tab::view_source(const URL& url, const String& source)
 {
     auto window = GUI::Window::construct(this->window());
@@ -248,6 +265,10 @@ Tab::Tab(Type type)
         view_source(url, source);
     };
 
+    hooks().on_get_js_profile = [this](auto& profile) {
+        save_js_profile(profile);
+    };
+
     hooks().on_js_console_output = [this](auto& method, auto& line) {
         if (m_console_window) {
             auto* console_widget = static_cast<ConsoleWidget*>(m_console_window->main_widget());
@@ -497,6 +518,26 @@ Tab::Tab(Type type)
     line_box_borders_action->set_checked(false);
     debug_menu.add_action(line_box_borders_action);
 
+    auto js_profiling_action = GUI::Action::create_checkable(
+        "Profile &JavaScript", [this](auto& action) {
+            if (m_type == Type::InProcessWebView) {
+                auto& vm = Web::Bindings::main_thread_vm();
+                if (action.is_checked()) {
+                    vm.set_profiler(make<JS::Profiler>(vm));
+                    vm.profiler()->start();
+                } else if (auto* profiler = vm.profiler()) {
+                    profiler->stop();
+                    save_js_profile(profiler->to_perfcore_json());
+                    vm.set_profiler({});
+                }
+            } else {
+                m_web_content_view->debug_request("js-profiling", action.is_checked() ? "on" : "off");
+            }
+        },
+        this);
+    js_profiling_action->set_checked(false);
+    debug_menu.add_action(js_profiling_action);
+
     debug_menu.add_separator();
     debug_menu.add_action(GUI::Action::create("Collect &Garbage", { Mod_Ctrl | Mod_Shift, Key_G }, [this](auto&) {
         if (m_type == Type::InProcessWebView) {
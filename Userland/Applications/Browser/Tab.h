@@ -71,6 +71,7 @@ private:
     void update_bookmark_button(const String& url);
     void start_download(const URL& url);
     void view_source(const URL& url, const String& source);
+    void save_js_profile(const String& profile);
 
     Type m_type;
 
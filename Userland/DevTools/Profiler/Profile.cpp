@@ -295,6 +295,11 @@ Result<NonnullOwnPtr<Profile>, String> Profile::load_from_perfcore_file(const St
         auto stack_array = perf_event.get("stack").as_array();
         for (ssize_t i = stack_array.values().size() - 1; i >= 0; --i) {
             auto& frame = stack_array.at(i);
+            if (frame.is_string()) {
+                // Profiles recorded by LibJS contain function names instead of addresses.
+                event.frames.append({ "JavaScript", frame.as_string(), 0, 0 });
+                continue;
+            }
             auto ptr = frame.to_number<u32>();
             u32 offset = 0;
             FlyString object_name;
@@ -323,11 +328,14 @@ Result<NonnullOwnPtr<Profile>, String> Profile::load_from_perfcore_file(const St
             event.frames.append({ object_name, symbol, ptr, offset });
         }
 
-        if (event.frames.size() < 2)
+        bool is_javascript_sample = !stack_array.is_empty() && stack_array.at(0).is_string();
+        if (event.frames.size() < (is_javascript_sample ? 1 : 2))
             continue;
 
-        FlatPtr innermost_frame_address = event.frames.at(1).address;
-        event.in_kernel = innermost_frame_address >= 0xc0000000;
+        if (!is_javascript_sample) {
+            FlatPtr innermost_frame_address = event.frames.at(1).address;
+            event.in_kernel = innermost_frame_address >= 0xc0000000;
+        }
 
         events.append(move(event));
     }
@@ -5,6 +5,7 @@
  */
 
 #include <AK/Assertions.h>
+#include <AK/FloatingPointStringConversions.h>
 #include <AK/HashMap.h>
 #include <AK/Noncopyable.h>
 #include <AK/StdLibExtras.h>
@@ -377,6 +378,7 @@ double strtod(const char* str, char** endptr)
     // Parse spaces, sign, and base
     char* parse_ptr = const_cast<char*>(str);
     strtons(parse_ptr, &parse_ptr);
+    const char* number_start = parse_ptr;
     const Sign sign = strtosign(parse_ptr, &parse_ptr);
 
     // Parse inf/nan, if applicable.
@@ -424,25 +426,26 @@ double strtod(const char* str, char** endptr)
         }
     }
 
-    // Parse base
-    char exponent_lower;
-    char exponent_upper;
-    int base = 10;
-    if (*parse_ptr == '0') {
-        const char base_ch = *(parse_ptr + 1);
-        if (base_ch == 'x' || base_ch == 'X') {
-            base = 16;
-            parse_ptr += 2;
+    // Decimal numbers have a fast and correctly rounded parser in AK, so all that's left for us is hexadecimal.
+    if (*parse_ptr != '0' || (*(parse_ptr + 1) != 'x' && *(parse_ptr + 1) != 'X')) {
+        auto result = parse_first_floating_point(number_start, number_start + strlen(number_start));
+        if (result.error == FloatingPointError::NoOrInvalidInput) {
+            if (endptr)
+                *endptr = const_cast<char*>(str);
+            return 0.0;
         }
+        if (result.error == FloatingPointError::OutOfRange || result.error == FloatingPointError::RoundedDownToZero)
+            errno = ERANGE;
+        if (endptr)
+            *endptr = const_cast<char*>(result.end_ptr);
+        return result.value;
     }
 
-    if (base == 10) {
-        exponent_lower = 'e';
-        exponent_upper = 'E';
-    } else {
-        exponent_lower = 'p';
-        exponent_upper = 'P';
-    }
+    // Parse base
+    const int base = 16;
+    const char exponent_lower = 'p';
+    const char exponent_upper = 'P';
+    parse_ptr += 2;
 
     // Parse "digits", possibly keeping track of the exponent offset.
     // We parse the most significant digits and the position in the
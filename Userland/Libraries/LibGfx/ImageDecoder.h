@@ -42,6 +42,10 @@ public:
     virtual size_t frame_count() = 0;
     virtual ImageFrameDescriptor frame(size_t i) = 0;
 
+    // Asks the plugin to decode the image at 1/factor of its size (rounded up), where factor is 1, 2, 4 or 8.
+    // Returns false if the plugin can't do that much cheaper than decoding the whole image, in which case it decodes at full size.
+    virtual bool set_downscale_factor(int) { return false; }
+
 protected:
     ImageDecoderPlugin() { }
 };
@@ -69,6 +73,7 @@ public:
     size_t loop_count() const { return m_plugin ? m_plugin->loop_count() : 0; }
     size_t frame_count() const { return m_plugin ? m_plugin->frame_count() : 0; }
     ImageFrameDescriptor frame(size_t i) const { return m_plugin ? m_plugin->frame(i) : ImageFrameDescriptor(); }
+    bool set_downscale_factor(int factor) { return m_plugin ? m_plugin->set_downscale_factor(factor) : false; }
 
 private:
     ImageDecoder(const u8*, size_t);
@@ -195,6 +195,10 @@ struct JPGLoadingContext {
     HuffmanStreamState huffman_stream;
     i32 previous_dc_values[3] = { 0 };
     MacroblockMeta mblock_meta;
+
+    // Each 8x8 block is decoded into (8 / downscale_factor)^2 pixels.
+    u8 downscale_factor { 1 };
+    u32 block_size() const { return 8 / downscale_factor; }
 };
 
 static void generate_huffman_codes(HuffmanTableSpec& table)
@@ -1028,8 +1032,58 @@ static void inverse_dct(const JPGLoadingContext& context, Vector<Macroblock>& ma
     }
 }
 
+// Decodes each block into its top-left block_size x block_size pixels, which (approximately) average the pixels they replace.
+// This is the same inverse DCT as for the whole block, but at block_size points and using only the lowest frequencies.
+static void inverse_dct_downscaled(const JPGLoadingContext& context, Vector<Macroblock>& macroblocks)
+{
+    const u32 block_size = context.block_size();
+
+    // cosines[x][u] = c(u) * cos((2x + 1) * u * pi / (2 * block_size)) / 2, where c(0) = 1 / sqrt(2) and c(u) = 1 otherwise.
+    float cosines[8][8];
+    for (u32 x = 0; x < block_size; ++x) {
+        for (u32 u = 0; u < block_size; ++u) {
+            float c = u == 0 ? M_SQRT1_2 : 1.0f;
+            cosines[x][u] = c * cos((2.0 * x + 1.0) * u * M_PI / (2.0 * block_size)) / 2.0;
+        }
+    }
+
+    for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.vsample_factor) {
+        for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.hsample_factor) {
+            for (auto it = context.components.begin(); it != context.components.end(); ++it) {
+                auto& component = it->value;
+                for (u8 vfactor_i = 0; vfactor_i < component.vsample_factor; vfactor_i++) {
+                    for (u8 hfactor_i = 0; hfactor_i < component.hsample_factor; hfactor_i++) {
+                        u32 mb_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hfactor_i + hcursor);
+                        Macroblock& block = macroblocks[mb_index];
+                        i32* block_component = component.serial_id == 0 ? block.y : (component.serial_id == 1 ? block.cb : block.cr);
+
+                        float rows[8][8];
+                        for (u32 v = 0; v < block_size; ++v) {
+                            for (u32 x = 0; x < block_size; ++x) {
+                                float sum = 0;
+                                for (u32 u = 0; u < block_size; ++u)
+                                    sum += block_component[v * 8 + u] * cosines[x][u];
+                                rows[v][x] = sum;
+                            }
+                        }
+                        for (u32 y = 0; y < block_size; ++y) {
+                            for (u32 x = 0; x < block_size; ++x) {
+                                float sum = 0;
+                                for (u32 v = 0; v < block_size; ++v)
+                                    sum += rows[v][x] * cosines[y][v];
+                                block_component[y * 8 + x] = sum;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
 static void ycbcr_to_rgb(const JPGLoadingContext& context, Vector<Macroblock>& macroblocks)
 {
+    const u8 block_size = context.block_size();
     for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.vsample_factor) {
         for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.hsample_factor) {
             const u32 chroma_block_index = vcursor * context.mblock_meta.hpadded_count + hcursor;
@@ -1041,11 +1095,11 @@ static void ycbcr_to_rgb(const JPGLoadingContext& context, Vector<Macroblock>& m
                     i32* y = macroblocks[mb_index].y;
                     i32* cb = macroblocks[mb_index].cb;
                     i32* cr = macroblocks[mb_index].cr;
-                    for (u8 i = 7; i < 8; --i) {
-                        for (u8 j = 7; j < 8; --j) {
+                    for (u8 i = block_size - 1; i < block_size; --i) {
+                        for (u8 j = block_size - 1; j < block_size; --j) {
                             const u8 pixel = i * 8 + j;
-                            const u32 chroma_pxrow = (i / context.vsample_factor) + 4 * vfactor_i;
-                            const u32 chroma_pxcol = (j / context.hsample_factor) + 4 * hfactor_i;
+                            const u32 chroma_pxrow = (i / context.vsample_factor) + (block_size / 2) * vfactor_i;
+                            const u32 chroma_pxcol = (j / context.hsample_factor) + (block_size / 2) * hfactor_i;
                             const u32 chroma_pixel = chroma_pxrow * 8 + chroma_pxcol;
                             int r = y[pixel] + 1.402f * chroma.cr[chroma_pixel] + 128;
                             int g = y[pixel] - 0.344f * chroma.cb[chroma_pixel] - 0.714f * chroma.cr[chroma_pixel] + 128;
@@ -1063,17 +1117,20 @@ static void ycbcr_to_rgb(const JPGLoadingContext& context, Vector<Macroblock>& m
 
 static bool compose_bitmap(JPGLoadingContext& context, const Vector<Macroblock>& macroblocks)
 {
-    context.bitmap = Bitmap::create_purgeable(BitmapFormat::BGRx8888, { context.frame.width, context.frame.height });
+    const u32 block_size = context.block_size();
+    const u32 width = (context.frame.width + context.downscale_factor - 1) / context.downscale_factor;
+    const u32 height = (context.frame.height + context.downscale_factor - 1) / context.downscale_factor;
+    context.bitmap = Bitmap::create_purgeable(BitmapFormat::BGRx8888, { static_cast<int>(width), static_cast<int>(height) });
     if (!context.bitmap)
         return false;
 
-    for (u32 y = context.frame.height - 1; y < context.frame.height; y--) {
-        const u32 block_row = y / 8;
-        const u32 pixel_row = y % 8;
-        for (u32 x = 0; x < context.frame.width; x++) {
-            const u32 block_column = x / 8;
+    for (u32 y = height - 1; y < height; y--) {
+        const u32 block_row = y / block_size;
+        const u32 pixel_row = y % block_size;
+        for (u32 x = 0; x < width; x++) {
+            const u32 block_column = x / block_size;
             auto& block = macroblocks[block_row * context.mblock_meta.hpadded_count + block_column];
-            const u32 pixel_column = x % 8;
+            const u32 pixel_column = x % block_size;
             const u32 pixel_index = pixel_row * 8 + pixel_column;
             const Color color { (u8)block.y[pixel_index], (u8)block.cb[pixel_index], (u8)block.cr[pixel_index] };
             context.bitmap->set_pixel(x, y, color);
@@ -1213,7 +1270,10 @@ static bool decode_jpg(JPGLoadingContext& context)
 
     auto macroblocks = result.release_value();
     dequantize(context, macroblocks);
-    inverse_dct(context, macroblocks);
+    if (context.downscale_factor == 1)
+        inverse_dct(context, macroblocks);
+    else
+        inverse_dct_downscaled(context, macroblocks);
     ycbcr_to_rgb(context, macroblocks);
     if (!compose_bitmap(context, macroblocks))
         return false;
@@ -1324,6 +1384,16 @@ size_t JPGImageDecoderPlugin::frame_count()
     return 1;
 }
 
+bool JPGImageDecoderPlugin::set_downscale_factor(int factor)
+{
+    if (m_context->state >= JPGLoadingContext::State::BitmapDecoded)
+        return false;
+    if (factor != 1 && factor != 2 && factor != 4 && factor != 8)
+        return false;
+    m_context->downscale_factor = factor;
+    return true;
+}
+
 ImageFrameDescriptor JPGImageDecoderPlugin::frame(size_t i)
 {
     if (i > 0) {
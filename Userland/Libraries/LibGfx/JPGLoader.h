@@ -31,6 +31,7 @@ public:
     virtual size_t loop_count() override;
     virtual size_t frame_count() override;
     virtual ImageFrameDescriptor frame(size_t i) override;
+    virtual bool set_downscale_factor(int) override;
 
 private:
     OwnPtr<JPGLoadingContext> m_context;
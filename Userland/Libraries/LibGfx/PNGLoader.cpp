@@ -97,6 +97,7 @@ struct PNGLoadingContext {
     u8 filter_method { 0 };
     u8 interlace_method { 0 };
     u8 channels { 0 };
+    u8 downscale_factor { 1 };
     bool has_seen_zlib_header { false };
     bool has_alpha() const { return color_type & 4 || palette_transparency_data.size() > 0; }
     Vector<Scanline> scanlines;
@@ -717,8 +718,8 @@ static bool decode_adam7_pass(PNGLoadingContext& context, Streamer& streamer, in
 
     // Copy the subimage data into the main image according to the pass pattern
     for (int y = 0, dy = adam7_starty[pass]; y < subimage_context.height && dy < context.height; ++y, dy += adam7_stepy[pass]) {
-        for (int x = 0, dx = adam7_startx[pass]; x < subimage_context.width && dy < context.width; ++x, dx += adam7_stepx[pass]) {
-            context.bitmap->set_pixel(dx, dy, subimage_context.bitmap->get_pixel(x, y));
+        for (int x = 0, dx = adam7_startx[pass]; x < subimage_context.width && dx < context.width; ++x, dx += adam7_stepx[pass]) {
+            context.bitmap->set_pixel(dx / context.downscale_factor, dy / context.downscale_factor, subimage_context.bitmap->get_pixel(x, y));
         }
     }
     return true;
@@ -727,11 +728,23 @@ static bool decode_adam7_pass(PNGLoadingContext& context, Streamer& streamer, in
 static bool decode_png_adam7(PNGLoadingContext& context)
 {
     Streamer streamer(context.decompression_buffer.data(), context.decompression_buffer.size());
-    context.bitmap = Bitmap::create_purgeable(context.has_alpha() ? BitmapFormat::BGRA8888 : BitmapFormat::BGRx8888, { context.width, context.height });
+    auto factor = context.downscale_factor;
+    IntSize size { (context.width + factor - 1) / factor, (context.height + factor - 1) / factor };
+    context.bitmap = Bitmap::create_purgeable(context.has_alpha() ? BitmapFormat::BGRA8888 : BitmapFormat::BGRx8888, size);
     if (!context.bitmap)
         return false;
 
-    for (int pass = 1; pass <= 7; ++pass) {
+    // The first pass has every 8th pixel in both directions, the first three have every 4th and the first five every other.
+    // So a downscaled image can be made from just those, and the later passes can be skipped.
+    int last_pass = 7;
+    if (factor == 8)
+        last_pass = 1;
+    else if (factor == 4)
+        last_pass = 3;
+    else if (factor == 2)
+        last_pass = 5;
+
+    for (int pass = 1; pass <= last_pass; ++pass) {
         if (!decode_adam7_pass(context, streamer, pass))
             return false;
     }
@@ -1019,6 +1032,21 @@ size_t PNGImageDecoderPlugin::frame_count()
     return 1;
 }
 
+bool PNGImageDecoderPlugin::set_downscale_factor(int factor)
+{
+    if (m_context->state >= PNGLoadingContext::State::BitmapDecoded)
+        return false;
+    if (factor != 1 && factor != 2 && factor != 4 && factor != 8)
+        return false;
+
+    // Only interlaced images contain a smaller version of themselves.
+    if (!decode_png_size(*m_context) || m_context->interlace_method != PngInterlaceMethod::Adam7)
+        return false;
+
+    m_context->downscale_factor = factor;
+    return true;
+}
+
 ImageFrameDescriptor PNGImageDecoderPlugin::frame(size_t i)
 {
     if (i > 0) {
@@ -17,6 +17,9 @@ Client::Client()
 
 void Client::die()
 {
+    auto pending_decodes = move(m_pending_decodes);
+    for (auto& it : pending_decodes)
+        it.value({});
     if (on_death)
         on_death();
 }
@@ -26,8 +29,15 @@ void Client::handshake()
     send_sync<Messages::ImageDecoderServer::Greet>();
 }
 
-void Client::handle(const Messages::ImageDecoderClient::Dummy&)
+static Core::AnonymousBuffer copy_to_anonymous_buffer(const ByteBuffer& encoded_data)
 {
+    auto encoded_buffer = Core::AnonymousBuffer::create_with_size(encoded_data.size());
+    if (!encoded_buffer.is_valid()) {
+        dbgln("Could not allocate encoded buffer");
+        return {};
+    }
+    memcpy(encoded_buffer.data<void>(), encoded_data.data(), encoded_data.size());
+    return encoded_buffer;
 }
 
 Optional<DecodedImage> Client::decode_image(const ByteBuffer& encoded_data)
@@ -35,13 +45,10 @@ Optional<DecodedImage> Client::decode_image(const ByteBuffer& encoded_data)
     if (encoded_data.is_empty())
         return {};
 
-    auto encoded_buffer = Core::AnonymousBuffer::create_with_size(encoded_data.size());
-    if (!encoded_buffer.is_valid()) {
-        dbgln("Could not allocate encoded buffer");
+    auto encoded_buffer = copy_to_anonymous_buffer(encoded_data);
+    if (!encoded_buffer.is_valid())
         return {};
-    }
 
-    memcpy(encoded_buffer.data<void>(), encoded_data.data(), encoded_data.size());
     auto response = send_sync_but_allow_failure<Messages::ImageDecoderServer::DecodeImage>(move(encoded_buffer));
 
     if (!response) {
@@ -61,4 +68,48 @@ Optional<DecodedImage> Client::decode_image(const ByteBuffer& encoded_data)
     return image;
 }
 
+void Client::start_decoding_image(const ByteBuffer& encoded_data, const Gfx::IntSize& ideal_size, Function<void(Optional<DecodedImage>)>&& on_decoded)
+{
+    if (encoded_data.is_empty()) {
+        on_decoded({});
+        return;
+    }
+
+    auto encoded_buffer = copy_to_anonymous_buffer(encoded_data);
+    if (!encoded_buffer.is_valid()) {
+        on_decoded({});
+        return;
+    }
+
+    auto image_id = m_next_image_id++;
+    m_pending_decodes.set(image_id, move(on_decoded));
+    post_message(Messages::ImageDecoderServer::StartDecodingImage(image_id, move(encoded_buffer), ideal_size));
+}
+
+void Client::handle(const Messages::ImageDecoderClient::DidDecodeImage& message)
+{
+    auto it = m_pending_decodes.find(message.image_id());
+    if (it == m_pending_decodes.end())
+        return;
+    auto on_decoded = move(it->value);
+    m_pending_decodes.remove(it);
+
+    if (!message.success()) {
+        on_decoded({});
+        return;
+    }
+
+    DecodedImage image;
+    image.size = message.size();
+    image.is_animated = message.is_animated();
+    image.loop_count = message.loop_count();
+    image.frames.resize(message.bitmaps().size());
+    for (size_t i = 0; i < image.frames.size(); ++i) {
+        auto& frame = image.frames[i];
+        frame.bitmap = message.bitmaps()[i].bitmap();
+        frame.duration = message.durations()[i];
+    }
+    on_decoded(move(image));
+}
+
 }
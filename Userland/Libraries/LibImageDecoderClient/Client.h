@@ -19,6 +19,7 @@ struct Frame {
 };
 
 struct DecodedImage {
+    Gfx::IntSize size;
     bool is_animated { false };
     u32 loop_count { 0 };
     Vector<Frame> frames;
@@ -34,6 +35,10 @@ public:
 
     Optional<DecodedImage> decode_image(const ByteBuffer&);
 
+    // Decodes the image without blocking, calling back once it's done. The decoder may return smaller
+    // bitmaps than the image's natural size (but never smaller than ideal_size) if that's much cheaper.
+    void start_decoding_image(const ByteBuffer&, const Gfx::IntSize& ideal_size, Function<void(Optional<DecodedImage>)>&& on_decoded);
+
     Function<void()> on_death;
 
 private:
@@ -41,7 +46,10 @@ private:
 
     virtual void die() override;
 
-    virtual void handle(const Messages::ImageDecoderClient::Dummy&) override;
+    virtual void handle(const Messages::ImageDecoderClient::DidDecodeImage&) override;
+
+    HashMap<i32, Function<void(Optional<DecodedImage>)>> m_pending_decodes;
+    i32 m_next_image_id { 0 };
 };
 
 }
@@ -185,6 +185,67 @@ public:
     Value execute(Interpreter&, GlobalObject&) const override { return {}; }
 };
 
+// What pre-parsing a function body found out about the functions nested in it: where their
+// bodies end and whether they are strict. Parsing the outer body for real uses this to skip
+// over the nested bodies instead of pre-parsing them again.
+class PreparseData : public RefCounted<PreparseData> {
+public:
+    struct FunctionBody {
+        size_t closing_brace_offset { 0 };
+        Position closing_brace_position;
+        bool is_strict { false };
+    };
+
+    // Keyed by the offset of the opening brace of the body.
+    HashMap<size_t, FunctionBody> function_bodies;
+};
+
+// The body of a function that has only been pre-parsed: the parser checked it for syntax errors
+// and remembered where it is in the source. The AST for it is built the first time it is needed,
+// which is usually the first call.
+class LazyFunctionBody : public RefCounted<LazyFunctionBody> {
+public:
+    static NonnullRefPtr<LazyFunctionBody> create(String source, size_t offset, String filename, Position position, u8 parse_options, bool is_strict_mode, bool is_in_function_context, RefPtr<PreparseData> preparse_data)
+    {
+        return adopt_ref(*new LazyFunctionBody(move(source), offset, move(filename), position, parse_options, is_strict_mode, is_in_function_context, move(preparse_data)));
+    }
+
+    const Statement& statement() const;
+    bool is_parsed() const { return !m_statement.is_null(); }
+
+    // Pre-parsing reports the same syntax errors as parsing, so this should always be null.
+    // Should the two ever disagree, the error is thrown when the function is called.
+    const String& syntax_error() const
+    {
+        statement();
+        return m_syntax_error;
+    }
+
+private:
+    LazyFunctionBody(String source, size_t offset, String filename, Position position, u8 parse_options, bool is_strict_mode, bool is_in_function_context, RefPtr<PreparseData> preparse_data)
+        : m_source(move(source))
+        , m_offset(offset)
+        , m_filename(move(filename))
+        , m_position(position)
+        , m_parse_options(parse_options)
+        , m_is_strict_mode(is_strict_mode)
+        , m_is_in_function_context(is_in_function_context)
+        , m_preparse_data(move(preparse_data))
+    {
+    }
+
+    mutable String m_source;
+    size_t m_offset { 0 };
+    String m_filename;
+    Position m_position;
+    u8 m_parse_options { 0 };
+    bool m_is_strict_mode { false };
+    bool m_is_in_function_context { false };
+    mutable RefPtr<PreparseData> m_preparse_data;
+    mutable RefPtr<Statement> m_statement;
+    mutable String m_syntax_error;
+};
+
 class FunctionNode {
 public:
     struct Parameter {
@@ -194,7 +255,8 @@ public:
     };
 
     const FlyString& name() const { return m_name; }
-    const Statement& body() const { return *m_body; }
+    const Statement& body() const { return m_lazy_body ? m_lazy_body->statement() : *m_body; }
+    RefPtr<LazyFunctionBody> lazy_body() const { return m_lazy_body; }
     const Vector<Parameter>& parameters() const { return m_parameters; };
     i32 function_length() const { return m_function_length; }
     bool is_strict_mode() const { return m_is_strict_mode; }
@@ -210,6 +272,16 @@ protected:
     {
     }
 
+    FunctionNode(const FlyString& name, LazyFunctionBody& lazy_body, Vector<Parameter> parameters, i32 function_length, NonnullRefPtrVector<VariableDeclaration> variables, bool is_strict_mode)
+        : m_name(name)
+        , m_lazy_body(lazy_body)
+        , m_parameters(move(parameters))
+        , m_variables(move(variables))
+        , m_function_length(function_length)
+        , m_is_strict_mode(is_strict_mode)
+    {
+    }
+
     void dump(int indent, const String& class_name) const;
 
     const NonnullRefPtrVector<VariableDeclaration>& variables() const { return m_variables; }
@@ -223,7 +295,8 @@ protected:
 
 private:
     FlyString m_name;
-    NonnullRefPtr<Statement> m_body;
+    RefPtr<Statement> m_body;
+    RefPtr<LazyFunctionBody> m_lazy_body;
     const Vector<Parameter> m_parameters;
     NonnullRefPtrVector<VariableDeclaration> m_variables;
     const i32 m_function_length;
@@ -242,6 +315,12 @@ public:
     {
     }
 
+    FunctionDeclaration(SourceRange source_range, const FlyString& name, LazyFunctionBody& lazy_body, Vector<Parameter> parameters, i32 function_length, NonnullRefPtrVector<VariableDeclaration> variables, bool is_strict_mode = false)
+        : Declaration(move(source_range))
+        , FunctionNode(name, lazy_body, move(parameters), function_length, move(variables), is_strict_mode)
+    {
+    }
+
     virtual Value execute(Interpreter&, GlobalObject&) const override;
     virtual void dump(int indent) const override;
 };
@@ -259,6 +338,13 @@ public:
     {
     }
 
+    FunctionExpression(SourceRange source_range, const FlyString& name, LazyFunctionBody& lazy_body, Vector<Parameter> parameters, i32 function_length, NonnullRefPtrVector<VariableDeclaration> variables, bool is_strict_mode, bool is_arrow_function = false)
+        : Expression(source_range)
+        , FunctionNode(name, lazy_body, move(parameters), function_length, move(variables), is_strict_mode)
+        , m_is_arrow_function(is_arrow_function)
+    {
+    }
+
     virtual Value execute(Interpreter&, GlobalObject&) const override;
     virtual void dump(int indent) const override;
 
@@ -104,6 +104,7 @@ class Allocator;
 class BigInt;
 class BoundFunction;
 class Cell;
+class CompiledRegExp;
 class Console;
 class DeferGC;
 class Error;
@@ -119,7 +120,10 @@ class LexicalEnvironment;
 class MarkedValueList;
 class NativeFunction;
 class NativeProperty;
+class Parser;
 class PrimitiveString;
+class Profiler;
+class Program;
 class PromiseReaction;
 class PromiseReactionJob;
 class PromiseResolveThenableJob;
@@ -127,6 +131,7 @@ class PropertyName;
 class Reference;
 class ScopeNode;
 class ScopeObject;
+class ScriptFunction;
 class Shape;
 class Statement;
 class Symbol;
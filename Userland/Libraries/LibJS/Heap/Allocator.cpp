@@ -5,6 +5,7 @@
  */
 
 #include <AK/Badge.h>
+#include <AK/Debug.h>
 #include <LibJS/Heap/Allocator.h>
 #include <LibJS/Heap/HeapBlock.h>
 
@@ -21,6 +22,9 @@ Allocator::~Allocator()
 
 Cell* Allocator::allocate_cell(Heap& heap)
 {
+    while (m_usable_blocks.is_empty() && !m_blocks_to_sweep.is_empty())
+        sweep_block(*m_blocks_to_sweep.first(), EmptyBlockDisposition::Keep);
+
     if (m_usable_blocks.is_empty()) {
         auto block = HeapBlock::create_with_cell_size(heap, m_cell_size);
         m_usable_blocks.append(*block.leak_ptr());
@@ -34,16 +38,56 @@ Cell* Allocator::allocate_cell(Heap& heap)
     return cell;
 }
 
-void Allocator::block_did_become_empty(Badge<Heap>, HeapBlock& block)
+size_t Allocator::start_lazy_sweep(Badge<Heap>)
 {
-    block.m_list_node.remove();
-    delete &block;
+    VERIFY(m_blocks_to_sweep.is_empty());
+    size_t block_count = 0;
+    while (!m_full_blocks.is_empty()) {
+        m_blocks_to_sweep.append(*m_full_blocks.first());
+        ++block_count;
+    }
+    while (!m_usable_blocks.is_empty()) {
+        m_blocks_to_sweep.append(*m_usable_blocks.first());
+        ++block_count;
+    }
+    return block_count;
 }
 
-void Allocator::block_did_become_usable(Badge<Heap>, HeapBlock& block)
+bool Allocator::sweep_next_block(Badge<Heap>, size_t& freed_block_count)
 {
-    VERIFY(!block.is_full());
-    m_usable_blocks.append(block);
+    if (m_blocks_to_sweep.is_empty())
+        return false;
+    if (sweep_block(*m_blocks_to_sweep.first(), EmptyBlockDisposition::Release))
+        ++freed_block_count;
+    return true;
+}
+
+void Allocator::finish_sweeping(Badge<Heap>, size_t& freed_block_count)
+{
+    while (!m_blocks_to_sweep.is_empty()) {
+        if (sweep_block(*m_blocks_to_sweep.first(), EmptyBlockDisposition::Release))
+            ++freed_block_count;
+    }
+}
+
+bool Allocator::sweep_block(HeapBlock& block, EmptyBlockDisposition disposition)
+{
+    block.m_list_node.remove();
+
+    auto result = block.sweep();
+    m_swept_dead_cell_count += result.collected_cells;
+
+    if (!result.live_cells && disposition == EmptyBlockDisposition::Release) {
+        dbgln_if(HEAP_DEBUG, " - HeapBlock empty @ {}: cell_size={}", &block, block.cell_size());
+        delete &block;
+        return true;
+    }
+
+    if (block.is_full())
+        m_full_blocks.append(block);
+    else
+        m_usable_blocks.append(block);
+    return false;
 }
 
 }
@@ -34,18 +34,37 @@ public:
             if (callback(block) == IterationDecision::Break)
                 return IterationDecision::Break;
         }
+        for (auto& block : m_blocks_to_sweep) {
+            if (callback(block) == IterationDecision::Break)
+                return IterationDecision::Break;
+        }
         return IterationDecision::Continue;
     }
 
-    void block_did_become_empty(Badge<Heap>, HeapBlock&);
-    void block_did_become_usable(Badge<Heap>, HeapBlock&);
+    // After marking, every block is queued for sweeping. Blocks are then swept one at a time
+    // when allocate_cell() runs out of usable blocks, or when the heap sweeps incrementally
+    // through sweep_next_block(). Whatever is left is swept by finish_sweeping() before the
+    // next collection starts marking.
+    size_t start_lazy_sweep(Badge<Heap>);
+    bool sweep_next_block(Badge<Heap>, size_t& freed_block_count);
+    void finish_sweeping(Badge<Heap>, size_t& freed_block_count);
+
+    size_t swept_dead_cell_count() const { return m_swept_dead_cell_count; }
 
 private:
+    enum class EmptyBlockDisposition {
+        Keep,
+        Release,
+    };
+    bool sweep_block(HeapBlock&, EmptyBlockDisposition);
+
     const size_t m_cell_size;
+    size_t m_swept_dead_cell_count { 0 };
 
     typedef IntrusiveList<HeapBlock, RawPtr<HeapBlock>, &HeapBlock::m_list_node> BlockList;
     BlockList m_full_blocks;
     BlockList m_usable_blocks;
+    BlockList m_blocks_to_sweep;
 };
 
 }
@@ -23,6 +23,7 @@ namespace JS {
 Heap::Heap(VM& vm)
     : m_vm(vm)
 {
+    m_lifetime_timer.start();
     m_allocators.append(make<Allocator>(16));
     m_allocators.append(make<Allocator>(32));
     m_allocators.append(make<Allocator>(64));
@@ -58,6 +59,11 @@ Cell* Heap::allocate_cell(size_t size)
         ++m_allocations_since_last_gc;
     }
 
+    if (m_has_blocks_to_sweep && ++m_allocations_since_incremental_sweep >= m_allocations_per_incremental_sweep) {
+        m_allocations_since_incremental_sweep = 0;
+        sweep_next_block();
+    }
+
     auto& allocator = allocator_for_size(size);
     return allocator.allocate_cell(*this);
 }
@@ -67,18 +73,73 @@ void Heap::collect_garbage(CollectionType collection_type, bool print_report)
     VERIFY(!m_collecting_garbage);
     TemporaryChange change(m_collecting_garbage, true);
 
-    Core::ElapsedTimer collection_measurement_timer;
-    collection_measurement_timer.start();
     if (collection_type == CollectionType::CollectGarbage) {
         if (m_gc_deferrals) {
             m_should_gc_when_deferral_ends = true;
             return;
         }
+    }
+
+    // Blocks left over from the previous collection still hold mark bits and unreachable cells,
+    // both of which must be gone before we can scan for roots and mark again.
+    // Usually they've all been swept incrementally by now. If not, that's work left over from the
+    // previous collection, so it doesn't count towards this collection's pause time.
+    size_t freed_blocks = finish_sweeping();
+
+    Core::ElapsedTimer collection_measurement_timer;
+    collection_measurement_timer.start();
+
+    size_t collected_cells_before = swept_dead_cell_count();
+    size_t collected_cell_bytes_before = swept_dead_cell_bytes();
+
+    MarkingResult marking_result;
+    if (collection_type == CollectionType::CollectGarbage) {
         HashTable<Cell*> roots;
         gather_roots(roots);
-        mark_live_cells(roots);
+        marking_result = mark_live_cells(roots);
+    }
+
+    size_t blocks_to_sweep = 0;
+    for (auto& allocator : m_allocators)
+        blocks_to_sweep += allocator->start_lazy_sweep({});
+
+    // When collecting everything, or when asked for a report, sweep eagerly so that all cells
+    // are finalized (and the numbers are accurate) before we return.
+    if (collection_type == CollectionType::CollectEverything || print_report)
+        freed_blocks += finish_sweeping();
+
+    int time_spent = collection_measurement_timer.elapsed();
+
+    ++m_statistics.collection_count;
+    m_statistics.last_pause_ms = time_spent;
+    m_statistics.total_pause_ms += time_spent;
+    m_statistics.max_pause_ms = max(m_statistics.max_pause_ms, (i64)time_spent);
+    m_statistics.live_cells = marking_result.live_cells;
+    m_statistics.live_cell_bytes = marking_result.live_cell_bytes;
+
+    m_max_allocations_between_gc = max(minimum_allocations_between_gc, marking_result.live_cells);
+
+    m_has_blocks_to_sweep = blocks_to_sweep > 0;
+    m_allocations_since_incremental_sweep = 0;
+    if (m_has_blocks_to_sweep)
+        m_allocations_per_incremental_sweep = max((size_t)1, m_max_allocations_between_gc / (2 * blocks_to_sweep));
+
+    if (print_report) {
+        size_t live_block_count = 0;
+        for_each_block([&](auto&) {
+            ++live_block_count;
+            return IterationDecision::Continue;
+        });
+
+        dbgln("Garbage collection report");
+        dbgln("=============================================");
+        dbgln("     Time spent: {} ms", time_spent);
+        dbgln("     Live cells: {} ({} bytes)", marking_result.live_cells, marking_result.live_cell_bytes);
+        dbgln("Collected cells: {} ({} bytes)", swept_dead_cell_count() - collected_cells_before, swept_dead_cell_bytes() - collected_cell_bytes_before);
+        dbgln("    Live blocks: {} ({} bytes)", live_block_count, live_block_count * HeapBlock::block_size);
+        dbgln("   Freed blocks: {} ({} bytes)", freed_blocks, freed_blocks * HeapBlock::block_size);
+        dbgln("=============================================");
     }
-    sweep_dead_cells(print_report, collection_measurement_timer);
 }
 
 void Heap::gather_roots(HashTable<Cell*>& roots)
@@ -157,67 +218,46 @@ public:
 
     virtual void visit_impl(Cell* cell)
     {
-        if (cell->is_marked())
+        auto* block = HeapBlock::from_cell(cell);
+        if (block->is_marked(cell))
             return;
         dbgln_if(HEAP_DEBUG, "  ! {}", cell);
-        cell->set_marked(true);
-        cell->visit_edges(*this);
+        block->set_marked(cell);
+        ++m_result.live_cells;
+        m_result.live_cell_bytes += block->cell_size();
+        m_work_queue.append(cell);
     }
+
+    // NOTE: Edges are traced from an explicit work queue rather than recursively,
+    //       so that long chains of objects (linked lists, deep DOM trees) can't
+    //       exhaust the native stack during marking.
+    Heap::MarkingResult mark_all_reachable_cells()
+    {
+        while (!m_work_queue.is_empty())
+            m_work_queue.take_last()->visit_edges(*this);
+        return m_result;
+    }
+
+private:
+    Vector<Cell*> m_work_queue;
+    Heap::MarkingResult m_result;
 };
 
-void Heap::mark_live_cells(const HashTable<Cell*>& roots)
+Heap::MarkingResult Heap::mark_live_cells(const HashTable<Cell*>& roots)
 {
     dbgln_if(HEAP_DEBUG, "mark_live_cells:");
     MarkingVisitor visitor;
     for (auto* root : roots)
         visitor.visit(root);
+    return visitor.mark_all_reachable_cells();
 }
 
-void Heap::sweep_dead_cells(bool print_report, const Core::ElapsedTimer& measurement_timer)
+size_t Heap::finish_sweeping()
 {
-    dbgln_if(HEAP_DEBUG, "sweep_dead_cells:");
-    Vector<HeapBlock*, 32> empty_blocks;
-    Vector<HeapBlock*, 32> full_blocks_that_became_usable;
-
-    size_t collected_cells = 0;
-    size_t live_cells = 0;
-    size_t collected_cell_bytes = 0;
-    size_t live_cell_bytes = 0;
-
-    for_each_block([&](auto& block) {
-        bool block_has_live_cells = false;
-        bool block_was_full = block.is_full();
-        block.for_each_cell([&](Cell* cell) {
-            if (cell->is_live()) {
-                if (!cell->is_marked()) {
-                    dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
-                    block.deallocate(cell);
-                    ++collected_cells;
-                    collected_cell_bytes += block.cell_size();
-                } else {
-                    cell->set_marked(false);
-                    block_has_live_cells = true;
-                    ++live_cells;
-                    live_cell_bytes += block.cell_size();
-                }
-            }
-        });
-        if (!block_has_live_cells)
-            empty_blocks.append(&block);
-        else if (block_was_full != block.is_full())
-            full_blocks_that_became_usable.append(&block);
-        return IterationDecision::Continue;
-    });
-
-    for (auto* block : empty_blocks) {
-        dbgln_if(HEAP_DEBUG, " - HeapBlock empty @ {}: cell_size={}", block, block->cell_size());
-        allocator_for_size(block->cell_size()).block_did_become_empty({}, *block);
-    }
-
-    for (auto* block : full_blocks_that_became_usable) {
-        dbgln_if(HEAP_DEBUG, " - HeapBlock usable again @ {}: cell_size={}", block, block->cell_size());
-        allocator_for_size(block->cell_size()).block_did_become_usable({}, *block);
-    }
+    dbgln_if(HEAP_DEBUG, "finish_sweeping:");
+    size_t freed_blocks = 0;
+    for (auto& allocator : m_allocators)
+        allocator->finish_sweeping({}, freed_blocks);
 
     if constexpr (HEAP_DEBUG) {
         for_each_block([&](auto& block) {
@@ -225,25 +265,60 @@ void Heap::sweep_dead_cells(bool print_report, const Core::ElapsedTimer& measure
             return IterationDecision::Continue;
         });
     }
+    return freed_blocks;
+}
 
-    int time_spent = measurement_timer.elapsed();
+void Heap::sweep_next_block()
+{
+    size_t freed_blocks = 0;
+    for (auto& allocator : m_allocators) {
+        if (allocator->sweep_next_block({}, freed_blocks))
+            return;
+    }
+    m_has_blocks_to_sweep = false;
+}
 
-    if (print_report) {
-        size_t live_block_count = 0;
-        for_each_block([&](auto&) {
-            ++live_block_count;
-            return IterationDecision::Continue;
-        });
+size_t Heap::swept_dead_cell_count() const
+{
+    size_t count = 0;
+    for (auto& allocator : m_allocators)
+        count += allocator->swept_dead_cell_count();
+    return count;
+}
 
-        dbgln("Garbage collection report");
-        dbgln("=============================================");
-        dbgln("     Time spent: {} ms", time_spent);
-        dbgln("     Live cells: {} ({} bytes)", live_cells, live_cell_bytes);
-        dbgln("Collected cells: {} ({} bytes)", collected_cells, collected_cell_bytes);
-        dbgln("    Live blocks: {} ({} bytes)", live_block_count, live_block_count * HeapBlock::block_size);
-        dbgln("   Freed blocks: {} ({} bytes)", empty_blocks.size(), empty_blocks.size() * HeapBlock::block_size);
-        dbgln("=============================================");
-    }
+size_t Heap::swept_dead_cell_bytes() const
+{
+    size_t bytes = 0;
+    for (auto& allocator : m_allocators)
+        bytes += allocator->swept_dead_cell_count() * allocator->cell_size();
+    return bytes;
+}
+
+HeapStatistics Heap::statistics() const
+{
+    auto statistics = m_statistics;
+    statistics.total_collected_cells = swept_dead_cell_count();
+    statistics.total_collected_bytes = swept_dead_cell_bytes();
+    statistics.lifetime_ms = m_lifetime_timer.elapsed();
+    return statistics;
+}
+
+void Heap::dump_statistics() const
+{
+    auto statistics = this->statistics();
+    double lifetime_seconds = static_cast<double>(statistics.lifetime_ms) / 1000.0;
+    double collections_per_second = lifetime_seconds > 0 ? statistics.collection_count / lifetime_seconds : 0;
+    i64 average_pause_ms = statistics.collection_count ? statistics.total_pause_ms / (i64)statistics.collection_count : 0;
+
+    dbgln("Garbage collection statistics");
+    dbgln("=============================================");
+    dbgln("        Collections: {} ({:.2} per second)", statistics.collection_count, collections_per_second);
+    dbgln("   Total pause time: {} ms ({} ms lifetime)", statistics.total_pause_ms, statistics.lifetime_ms);
+    dbgln("     Average pause: {} ms", average_pause_ms);
+    dbgln("     Longest pause: {} ms", statistics.max_pause_ms);
+    dbgln("   Collected cells: {} ({} bytes)", statistics.total_collected_cells, statistics.total_collected_bytes);
+    dbgln("        Live cells: {} ({} bytes)", statistics.live_cells, statistics.live_cell_bytes);
+    dbgln("=============================================");
 }
 
 void Heap::did_create_handle(Badge<HandleImpl>, HandleImpl& impl)
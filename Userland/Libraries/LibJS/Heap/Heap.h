@@ -11,6 +11,7 @@
 #include <AK/NonnullOwnPtr.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
+#include <LibCore/ElapsedTimer.h>
 #include <LibCore/Forward.h>
 #include <LibJS/Forward.h>
 #include <LibJS/Heap/Allocator.h>
@@ -20,6 +21,18 @@
 
 namespace JS {
 
+struct HeapStatistics {
+    size_t collection_count { 0 };
+    i64 total_pause_ms { 0 };
+    i64 max_pause_ms { 0 };
+    i64 last_pause_ms { 0 };
+    size_t total_collected_cells { 0 };
+    size_t total_collected_bytes { 0 };
+    size_t live_cells { 0 };
+    size_t live_cell_bytes { 0 };
+    i64 lifetime_ms { 0 };
+};
+
 class Heap {
     AK_MAKE_NONCOPYABLE(Heap);
     AK_MAKE_NONMOVABLE(Heap);
@@ -60,6 +73,9 @@ public:
 
     VM& vm() { return m_vm; }
 
+    HeapStatistics statistics() const;
+    void dump_statistics() const;
+
     bool should_collect_on_every_allocation() const { return m_should_collect_on_every_allocation; }
     void set_should_collect_on_every_allocation(bool b) { m_should_collect_on_every_allocation = b; }
 
@@ -72,13 +88,22 @@ public:
     void defer_gc(Badge<DeferGC>);
     void undefer_gc(Badge<DeferGC>);
 
+    struct MarkingResult {
+        size_t live_cells { 0 };
+        size_t live_cell_bytes { 0 };
+    };
+
 private:
     Cell* allocate_cell(size_t);
 
     void gather_roots(HashTable<Cell*>&);
     void gather_conservative_roots(HashTable<Cell*>&);
-    void mark_live_cells(const HashTable<Cell*>& live_cells);
-    void sweep_dead_cells(bool print_report, const Core::ElapsedTimer&);
+    MarkingResult mark_live_cells(const HashTable<Cell*>& live_cells);
+    size_t finish_sweeping();
+    void sweep_next_block();
+
+    size_t swept_dead_cell_count() const;
+    size_t swept_dead_cell_bytes() const;
 
     Allocator& allocator_for_size(size_t);
 
@@ -91,9 +116,19 @@ private:
         }
     }
 
-    size_t m_max_allocations_between_gc { 10000 };
+    static constexpr size_t minimum_allocations_between_gc = 10000;
+
+    // The allocation budget grows with the number of cells that survived the last
+    // collection, so that large heaps aren't marked over and over for little gain.
+    size_t m_max_allocations_between_gc { minimum_allocations_between_gc };
     size_t m_allocations_since_last_gc { 0 };
 
+    // Blocks queued for sweeping by the last collection are swept one at a time as cells
+    // are allocated, spread out so that they're all done halfway to the next collection.
+    bool m_has_blocks_to_sweep { false };
+    size_t m_allocations_per_incremental_sweep { 1 };
+    size_t m_allocations_since_incremental_sweep { 0 };
+
     bool m_should_collect_on_every_allocation { false };
 
     VM& m_vm;
@@ -107,6 +142,9 @@ private:
     bool m_should_gc_when_deferral_ends { false };
 
     bool m_collecting_garbage { false };
+
+    HeapStatistics m_statistics;
+    Core::ElapsedTimer m_lifetime_timer;
 };
 
 }
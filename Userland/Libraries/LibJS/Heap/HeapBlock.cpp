@@ -5,6 +5,7 @@
  */
 
 #include <AK/Assertions.h>
+#include <AK/Debug.h>
 #include <AK/NonnullOwnPtr.h>
 #include <LibJS/Heap/HeapBlock.h>
 #include <stdio.h>
@@ -57,7 +58,7 @@ void HeapBlock::deallocate(Cell* cell)
     VERIFY(is_valid_cell_pointer(cell));
     VERIFY(!m_freelist || is_valid_cell_pointer(m_freelist));
     VERIFY(cell->is_live());
-    VERIFY(!cell->is_marked());
+    VERIFY(!is_marked(cell));
     cell->~Cell();
     auto* freelist_entry = new (cell) FreelistEntry();
     freelist_entry->set_live(false);
@@ -65,4 +66,22 @@ void HeapBlock::deallocate(Cell* cell)
     m_freelist = freelist_entry;
 }
 
+HeapBlock::SweepResult HeapBlock::sweep()
+{
+    SweepResult result;
+    for_each_cell([&](Cell* cell) {
+        if (!cell->is_live())
+            return;
+        if (is_marked(cell)) {
+            ++result.live_cells;
+            return;
+        }
+        dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
+        deallocate(cell);
+        ++result.collected_cells;
+    });
+    __builtin_memset(m_mark_bits, 0, sizeof(m_mark_bits));
+    return result;
+}
+
 }
@@ -37,6 +37,27 @@ public:
 
     void deallocate(Cell*);
 
+    // NOTE: Mark bits live in a side bitmap rather than in the cells themselves,
+    //       so that resetting them after a sweep is a single memset per block.
+    bool is_marked(const Cell* cell) const
+    {
+        auto index = cell_index(cell);
+        return m_mark_bits[index / 64] & (1ull << (index % 64));
+    }
+
+    void set_marked(const Cell* cell)
+    {
+        auto index = cell_index(cell);
+        m_mark_bits[index / 64] |= (1ull << (index % 64));
+    }
+
+    struct SweepResult {
+        size_t collected_cells { 0 };
+        size_t live_cells { 0 };
+    };
+
+    SweepResult sweep();
+
     template<typename Callback>
     void for_each_cell(Callback callback)
     {
@@ -71,6 +92,13 @@ public:
 private:
     HeapBlock(Heap&, size_t cell_size);
 
+    size_t cell_index(const Cell* cell) const
+    {
+        return (reinterpret_cast<FlatPtr>(cell) - reinterpret_cast<FlatPtr>(m_storage)) / m_cell_size;
+    }
+
+    static constexpr size_t max_cell_count = block_size / sizeof(Cell);
+
     struct FreelistEntry final : public Cell {
         FreelistEntry* next { nullptr };
 
@@ -90,6 +118,7 @@ private:
     Heap& m_heap;
     size_t m_cell_size { 0 };
     FreelistEntry* m_freelist { nullptr };
+    u64 m_mark_bits[max_cell_count / 64] {};
     alignas(Cell) u8 m_storage[];
 };
 
@@ -7,6 +7,7 @@
 #include <AK/StringBuilder.h>
 #include <LibJS/AST.h>
 #include <LibJS/Interpreter.h>
+#include <LibJS/Profiler.h>
 #include <LibJS/Runtime/GlobalObject.h>
 #include <LibJS/Runtime/LexicalEnvironment.h>
 #include <LibJS/Runtime/Object.h>
@@ -81,7 +82,7 @@ const GlobalObject& Interpreter::global_object() const
 void Interpreter::enter_scope(const ScopeNode& scope_node, ScopeType scope_type, GlobalObject& global_object)
 {
     for (auto& declaration : scope_node.functions()) {
-        auto* function = ScriptFunction::create(global_object, declaration.name(), declaration.body(), declaration.parameters(), declaration.function_length(), current_scope(), declaration.is_strict_mode());
+        auto* function = ScriptFunction::create(global_object, declaration, current_scope(), declaration.is_strict_mode());
         vm().set_variable(declaration.name(), function, global_object);
     }
 
@@ -138,6 +139,9 @@ void Interpreter::push_scope(ScopeFrame frame)
 
 Value Interpreter::execute_statement(GlobalObject& global_object, const Statement& statement, ScopeType scope_type)
 {
+    if (auto* profiler = vm().profiler())
+        profiler->did_reach_safepoint();
+
     if (!is<ScopeNode>(statement))
         return statement.execute(*this, global_object);
 
@@ -145,6 +149,8 @@ Value Interpreter::execute_statement(GlobalObject& global_object, const Statemen
     enter_scope(block, scope_type, global_object);
 
     for (auto& node : block.children()) {
+        if (auto* profiler = vm().profiler())
+            profiler->did_reach_safepoint();
         auto value = node.execute(*this, global_object);
         if (!value.is_empty())
             vm().set_last_value({}, value);
@@ -25,115 +25,116 @@ Lexer::Lexer(StringView source, StringView filename, size_t line_number, size_t
     , m_line_number(line_number)
     , m_line_column(line_column)
 {
-    if (s_keywords.is_empty()) {
-        s_keywords.set("await", TokenType::Await);
-        s_keywords.set("break", TokenType::Break);
-        s_keywords.set("case", TokenType::Case);
-        s_keywords.set("catch", TokenType::Catch);
-        s_keywords.set("class", TokenType::Class);
-        s_keywords.set("const", TokenType::Const);
-        s_keywords.set("continue", TokenType::Continue);
-        s_keywords.set("debugger", TokenType::Debugger);
-        s_keywords.set("default", TokenType::Default);
-        s_keywords.set("delete", TokenType::Delete);
-        s_keywords.set("do", TokenType::Do);
-        s_keywords.set("else", TokenType::Else);
-        s_keywords.set("enum", TokenType::Enum);
-        s_keywords.set("export", TokenType::Export);
-        s_keywords.set("extends", TokenType::Extends);
-        s_keywords.set("false", TokenType::BoolLiteral);
-        s_keywords.set("finally", TokenType::Finally);
-        s_keywords.set("for", TokenType::For);
-        s_keywords.set("function", TokenType::Function);
-        s_keywords.set("if", TokenType::If);
-        s_keywords.set("import", TokenType::Import);
-        s_keywords.set("in", TokenType::In);
-        s_keywords.set("instanceof", TokenType::Instanceof);
-        s_keywords.set("let", TokenType::Let);
-        s_keywords.set("new", TokenType::New);
-        s_keywords.set("null", TokenType::NullLiteral);
-        s_keywords.set("return", TokenType::Return);
-        s_keywords.set("super", TokenType::Super);
-        s_keywords.set("switch", TokenType::Switch);
-        s_keywords.set("this", TokenType::This);
-        s_keywords.set("throw", TokenType::Throw);
-        s_keywords.set("true", TokenType::BoolLiteral);
-        s_keywords.set("try", TokenType::Try);
-        s_keywords.set("typeof", TokenType::Typeof);
-        s_keywords.set("var", TokenType::Var);
-        s_keywords.set("void", TokenType::Void);
-        s_keywords.set("while", TokenType::While);
-        s_keywords.set("with", TokenType::With);
-        s_keywords.set("yield", TokenType::Yield);
-    }
-
-    if (s_three_char_tokens.is_empty()) {
-        s_three_char_tokens.set("===", TokenType::EqualsEqualsEquals);
-        s_three_char_tokens.set("!==", TokenType::ExclamationMarkEqualsEquals);
-        s_three_char_tokens.set("**=", TokenType::DoubleAsteriskEquals);
-        s_three_char_tokens.set("<<=", TokenType::ShiftLeftEquals);
-        s_three_char_tokens.set(">>=", TokenType::ShiftRightEquals);
-        s_three_char_tokens.set("&&=", TokenType::DoubleAmpersandEquals);
-        s_three_char_tokens.set("||=", TokenType::DoublePipeEquals);
-        s_three_char_tokens.set("\?\?=", TokenType::DoubleQuestionMarkEquals);
-        s_three_char_tokens.set(">>>", TokenType::UnsignedShiftRight);
-        s_three_char_tokens.set("...", TokenType::TripleDot);
-    }
-
-    if (s_two_char_tokens.is_empty()) {
-        s_two_char_tokens.set("=>", TokenType::Arrow);
-        s_two_char_tokens.set("+=", TokenType::PlusEquals);
-        s_two_char_tokens.set("-=", TokenType::MinusEquals);
-        s_two_char_tokens.set("*=", TokenType::AsteriskEquals);
-        s_two_char_tokens.set("/=", TokenType::SlashEquals);
-        s_two_char_tokens.set("%=", TokenType::PercentEquals);
-        s_two_char_tokens.set("&=", TokenType::AmpersandEquals);
-        s_two_char_tokens.set("|=", TokenType::PipeEquals);
-        s_two_char_tokens.set("^=", TokenType::CaretEquals);
-        s_two_char_tokens.set("&&", TokenType::DoubleAmpersand);
-        s_two_char_tokens.set("||", TokenType::DoublePipe);
-        s_two_char_tokens.set("??", TokenType::DoubleQuestionMark);
-        s_two_char_tokens.set("**", TokenType::DoubleAsterisk);
-        s_two_char_tokens.set("==", TokenType::EqualsEquals);
-        s_two_char_tokens.set("<=", TokenType::LessThanEquals);
-        s_two_char_tokens.set(">=", TokenType::GreaterThanEquals);
-        s_two_char_tokens.set("!=", TokenType::ExclamationMarkEquals);
-        s_two_char_tokens.set("--", TokenType::MinusMinus);
-        s_two_char_tokens.set("++", TokenType::PlusPlus);
-        s_two_char_tokens.set("<<", TokenType::ShiftLeft);
-        s_two_char_tokens.set(">>", TokenType::ShiftRight);
-        s_two_char_tokens.set("?.", TokenType::QuestionMarkPeriod);
-    }
-
-    if (s_single_char_tokens.is_empty()) {
-        s_single_char_tokens.set('&', TokenType::Ampersand);
-        s_single_char_tokens.set('*', TokenType::Asterisk);
-        s_single_char_tokens.set('[', TokenType::BracketOpen);
-        s_single_char_tokens.set(']', TokenType::BracketClose);
-        s_single_char_tokens.set('^', TokenType::Caret);
-        s_single_char_tokens.set(':', TokenType::Colon);
-        s_single_char_tokens.set(',', TokenType::Comma);
-        s_single_char_tokens.set('{', TokenType::CurlyOpen);
-        s_single_char_tokens.set('}', TokenType::CurlyClose);
-        s_single_char_tokens.set('=', TokenType::Equals);
-        s_single_char_tokens.set('!', TokenType::ExclamationMark);
-        s_single_char_tokens.set('-', TokenType::Minus);
-        s_single_char_tokens.set('(', TokenType::ParenOpen);
-        s_single_char_tokens.set(')', TokenType::ParenClose);
-        s_single_char_tokens.set('%', TokenType::Percent);
-        s_single_char_tokens.set('.', TokenType::Period);
-        s_single_char_tokens.set('|', TokenType::Pipe);
-        s_single_char_tokens.set('+', TokenType::Plus);
-        s_single_char_tokens.set('?', TokenType::QuestionMark);
-        s_single_char_tokens.set(';', TokenType::Semicolon);
-        s_single_char_tokens.set('/', TokenType::Slash);
-        s_single_char_tokens.set('~', TokenType::Tilde);
-        s_single_char_tokens.set('<', TokenType::LessThan);
-        s_single_char_tokens.set('>', TokenType::GreaterThan);
-    }
+    // NOTE: Lexers are also created on other threads to parse scripts off the main thread,
+    //       so we rely on function-local statics being initialized exactly once.
+    [[maybe_unused]] static bool token_tables_initialized = (initialize_token_tables(), true);
     consume();
 }
 
+void Lexer::initialize_token_tables()
+{
+    s_keywords.set("await", TokenType::Await);
+    s_keywords.set("break", TokenType::Break);
+    s_keywords.set("case", TokenType::Case);
+    s_keywords.set("catch", TokenType::Catch);
+    s_keywords.set("class", TokenType::Class);
+    s_keywords.set("const", TokenType::Const);
+    s_keywords.set("continue", TokenType::Continue);
+    s_keywords.set("debugger", TokenType::Debugger);
+    s_keywords.set("default", TokenType::Default);
+    s_keywords.set("delete", TokenType::Delete);
+    s_keywords.set("do", TokenType::Do);
+    s_keywords.set("else", TokenType::Else);
+    s_keywords.set("enum", TokenType::Enum);
+    s_keywords.set("export", TokenType::Export);
+    s_keywords.set("extends", TokenType::Extends);
+    s_keywords.set("false", TokenType::BoolLiteral);
+    s_keywords.set("finally", TokenType::Finally);
+    s_keywords.set("for", TokenType::For);
+    s_keywords.set("function", TokenType::Function);
+    s_keywords.set("if", TokenType::If);
+    s_keywords.set("import", TokenType::Import);
+    s_keywords.set("in", TokenType::In);
+    s_keywords.set("instanceof", TokenType::Instanceof);
+    s_keywords.set("let", TokenType::Let);
+    s_keywords.set("new", TokenType::New);
+    s_keywords.set("null", TokenType::NullLiteral);
+    s_keywords.set("return", TokenType::Return);
+    s_keywords.set("super", TokenType::Super);
+    s_keywords.set("switch", TokenType::Switch);
+    s_keywords.set("this", TokenType::This);
+    s_keywords.set("throw", TokenType::Throw);
+    s_keywords.set("true", TokenType::BoolLiteral);
+    s_keywords.set("try", TokenType::Try);
+    s_keywords.set("typeof", TokenType::Typeof);
+    s_keywords.set("var", TokenType::Var);
+    s_keywords.set("void", TokenType::Void);
+    s_keywords.set("while", TokenType::While);
+    s_keywords.set("with", TokenType::With);
+    s_keywords.set("yield", TokenType::Yield);
+
+    s_three_char_tokens.set("===", TokenType::EqualsEqualsEquals);
+    s_three_char_tokens.set("!==", TokenType::ExclamationMarkEqualsEquals);
+    s_three_char_tokens.set("**=", TokenType::DoubleAsteriskEquals);
+    s_three_char_tokens.set("<<=", TokenType::ShiftLeftEquals);
+    s_three_char_tokens.set(">>=", TokenType::ShiftRightEquals);
+    s_three_char_tokens.set("&&=", TokenType::DoubleAmpersandEquals);
+    s_three_char_tokens.set("||=", TokenType::DoublePipeEquals);
+    s_three_char_tokens.set("\?\?=", TokenType::DoubleQuestionMarkEquals);
+    s_three_char_tokens.set(">>>", TokenType::UnsignedShiftRight);
+    s_three_char_tokens.set("...", TokenType::TripleDot);
+
+
+    s_two_char_tokens.set("=>", TokenType::Arrow);
+    s_two_char_tokens.set("+=", TokenType::PlusEquals);
+    s_two_char_tokens.set("-=", TokenType::MinusEquals);
+    s_two_char_tokens.set("*=", TokenType::AsteriskEquals);
+    s_two_char_tokens.set("/=", TokenType::SlashEquals);
+    s_two_char_tokens.set("%=", TokenType::PercentEquals);
+    s_two_char_tokens.set("&=", TokenType::AmpersandEquals);
+    s_two_char_tokens.set("|=", TokenType::PipeEquals);
+    s_two_char_tokens.set("^=", TokenType::CaretEquals);
+    s_two_char_tokens.set("&&", TokenType::DoubleAmpersand);
+    s_two_char_tokens.set("||", TokenType::DoublePipe);
+    s_two_char_tokens.set("??", TokenType::DoubleQuestionMark);
+    s_two_char_tokens.set("**", TokenType::DoubleAsterisk);
+    s_two_char_tokens.set("==", TokenType::EqualsEquals);
+    s_two_char_tokens.set("<=", TokenType::LessThanEquals);
+    s_two_char_tokens.set(">=", TokenType::GreaterThanEquals);
+    s_two_char_tokens.set("!=", TokenType::ExclamationMarkEquals);
+    s_two_char_tokens.set("--", TokenType::MinusMinus);
+    s_two_char_tokens.set("++", TokenType::PlusPlus);
+    s_two_char_tokens.set("<<", TokenType::ShiftLeft);
+    s_two_char_tokens.set(">>", TokenType::ShiftRight);
+    s_two_char_tokens.set("?.", TokenType::QuestionMarkPeriod);
+
+
+    s_single_char_tokens.set('&', TokenType::Ampersand);
+    s_single_char_tokens.set('*', TokenType::Asterisk);
+    s_single_char_tokens.set('[', TokenType::BracketOpen);
+    s_single_char_tokens.set(']', TokenType::BracketClose);
+    s_single_char_tokens.set('^', TokenType::Caret);
+    s_single_char_tokens.set(':', TokenType::Colon);
+    s_single_char_tokens.set(',', TokenType::Comma);
+    s_single_char_tokens.set('{', TokenType::CurlyOpen);
+    s_single_char_tokens.set('}', TokenType::CurlyClose);
+    s_single_char_tokens.set('=', TokenType::Equals);
+    s_single_char_tokens.set('!', TokenType::ExclamationMark);
+    s_single_char_tokens.set('-', TokenType::Minus);
+    s_single_char_tokens.set('(', TokenType::ParenOpen);
+    s_single_char_tokens.set(')', TokenType::ParenClose);
+    s_single_char_tokens.set('%', TokenType::Percent);
+    s_single_char_tokens.set('.', TokenType::Period);
+    s_single_char_tokens.set('|', TokenType::Pipe);
+    s_single_char_tokens.set('+', TokenType::Plus);
+    s_single_char_tokens.set('?', TokenType::QuestionMark);
+    s_single_char_tokens.set(';', TokenType::Semicolon);
+    s_single_char_tokens.set('/', TokenType::Slash);
+    s_single_char_tokens.set('~', TokenType::Tilde);
+    s_single_char_tokens.set('<', TokenType::LessThan);
+    s_single_char_tokens.set('>', TokenType::GreaterThan);
+}
+
 void Lexer::consume()
 {
     auto did_reach_eof = [this] {
@@ -192,6 +193,18 @@ void Lexer::consume()
     m_current_char = m_source[m_position++];
 }
 
+void Lexer::seek(size_t offset, size_t line_number, size_t line_column)
+{
+    VERIFY(offset <= m_source.length());
+    // Pretend to be on a character just before the offset, then step onto it.
+    m_position = offset;
+    m_current_char = ' ';
+    m_line_number = line_number;
+    m_line_column = line_column - 1;
+    m_regex_is_in_character_class = false;
+    consume();
+}
+
 bool Lexer::consume_exponent()
 {
     consume();
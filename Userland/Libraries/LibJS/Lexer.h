@@ -20,10 +20,16 @@ public:
 
     Token next();
 
+    // Continues lexing at the given offset into the source, which has to be inside the same
+    // template literals as the current position, if any.
+    void seek(size_t offset, size_t line_number, size_t line_column);
+
     const StringView& source() const { return m_source; };
     const StringView& filename() const { return m_filename; };
 
 private:
+    static void initialize_token_tables();
+
     void consume();
     bool consume_exponent();
     bool consume_octal_number();
@@ -13,14 +13,18 @@
 
 namespace JS {
 
-static bool statement_is_use_strict_directive(NonnullRefPtr<Statement> statement)
+static bool statement_is_directive(const Statement& statement)
 {
-    if (!is<ExpressionStatement>(*statement))
+    if (!is<ExpressionStatement>(statement))
         return false;
-    auto& expression_statement = static_cast<ExpressionStatement&>(*statement);
-    auto& expression = expression_statement.expression();
-    if (!is<StringLiteral>(expression))
+    return is<StringLiteral>(static_cast<const ExpressionStatement&>(statement).expression());
+}
+
+static bool statement_is_use_strict_directive(const Statement& statement)
+{
+    if (!statement_is_directive(statement))
         return false;
+    auto& expression = static_cast<const ExpressionStatement&>(statement).expression();
     return static_cast<const StringLiteral&>(expression).is_use_strict_directive();
 }
 
@@ -230,26 +234,29 @@ NonnullRefPtr<Program> Parser::parse_program()
     ScopePusher scope(*this, ScopePusher::Var | ScopePusher::Let | ScopePusher::Function);
     auto program = adopt_ref(*new Program({ m_filename, rule_start.position(), position() }));
 
-    bool first = true;
+    bool in_directive_prologue = true;
     while (!done()) {
         if (match_declaration()) {
             program->append(parse_declaration());
+            in_directive_prologue = false;
         } else if (match_statement()) {
             auto statement = parse_statement();
             program->append(statement);
             if (statement_is_use_strict_directive(statement)) {
-                if (first) {
+                if (in_directive_prologue) {
                     program->set_strict_mode();
                     m_parser_state.m_strict_mode = true;
                 }
                 if (m_parser_state.m_string_legacy_octal_escape_sequence_in_scope)
                     syntax_error("Octal escape sequence in string literal not allowed in strict mode");
             }
+            if (!statement_is_directive(statement))
+                in_directive_prologue = false;
         } else {
             expected("statement or declaration");
             consume();
+            in_directive_prologue = false;
         }
-        first = false;
     }
     if (m_parser_state.m_var_scopes.size() == 1) {
         program->add_variables(m_parser_state.m_var_scopes.last());
@@ -385,9 +392,20 @@ RefPtr<FunctionExpression> Parser::try_parse_arrow_function_expression(bool expe
     ScopeGuard guard([&]() {
         m_parser_state.m_labels_in_scope = move(old_labels_in_scope);
     });
+    TemporaryChange break_context_rollback(m_parser_state.m_in_break_context, false);
+    TemporaryChange continue_context_rollback(m_parser_state.m_in_continue_context, false);
 
     bool is_strict = false;
 
+    if (m_lazy_function_parsing_enabled) {
+        TemporaryChange change(m_parser_state.m_in_arrow_function_context, true);
+        if (auto lazy_body = skip_function_body(true, is_strict)) {
+            state_rollback_guard.disarm();
+            discard_saved_state();
+            return create_ast_node<FunctionExpression>({ m_parser_state.m_current_token.filename(), rule_start.position(), position() }, "", *lazy_body, move(parameters), function_length, m_parser_state.m_var_scopes.take_last(), is_strict, true);
+        }
+    }
+
     auto function_body_result = [&]() -> RefPtr<BlockStatement> {
         TemporaryChange change(m_parser_state.m_in_arrow_function_context, true);
         if (match(TokenType::CurlyOpen)) {
@@ -1276,7 +1294,7 @@ NonnullRefPtr<BlockStatement> Parser::parse_block_statement(bool& is_strict)
     auto block = create_ast_node<BlockStatement>({ m_parser_state.m_current_token.filename(), rule_start.position(), position() });
     consume(TokenType::CurlyOpen);
 
-    bool first = true;
+    bool in_directive_prologue = true;
     bool initial_strict_mode_state = m_parser_state.m_strict_mode;
     if (initial_strict_mode_state)
         is_strict = true;
@@ -1284,22 +1302,25 @@ NonnullRefPtr<BlockStatement> Parser::parse_block_statement(bool& is_strict)
     while (!done() && !match(TokenType::CurlyClose)) {
         if (match_declaration()) {
             block->append(parse_declaration());
+            in_directive_prologue = false;
         } else if (match_statement()) {
             auto statement = parse_statement();
             block->append(statement);
             if (statement_is_use_strict_directive(statement)) {
-                if (first && !initial_strict_mode_state) {
+                if (in_directive_prologue && !initial_strict_mode_state) {
                     is_strict = true;
                     m_parser_state.m_strict_mode = true;
                 }
                 if (m_parser_state.m_string_legacy_octal_escape_sequence_in_scope)
                     syntax_error("Octal escape sequence in string literal not allowed in strict mode");
             }
+            if (!statement_is_directive(statement))
+                in_directive_prologue = false;
         } else {
             expected("statement or declaration");
             consume();
+            in_directive_prologue = false;
         }
-        first = false;
     }
     m_parser_state.m_strict_mode = initial_strict_mode_state;
     m_parser_state.m_string_legacy_octal_escape_sequence_in_scope = false;
@@ -1339,14 +1360,1218 @@ NonnullRefPtr<FunctionNodeType> Parser::parse_function_node(u8 parse_options)
     ScopeGuard guard([&]() {
         m_parser_state.m_labels_in_scope = move(old_labels_in_scope);
     });
+    TemporaryChange break_context_rollback(m_parser_state.m_in_break_context, false);
+    TemporaryChange continue_context_rollback(m_parser_state.m_in_continue_context, false);
 
     bool is_strict = false;
+    if (m_lazy_function_parsing_enabled) {
+        if (auto lazy_body = skip_function_body(false, is_strict))
+            return create_ast_node<FunctionNodeType>({ m_parser_state.m_current_token.filename(), rule_start.position(), position() }, name, *lazy_body, move(parameters), function_length, NonnullRefPtrVector<VariableDeclaration>(), is_strict);
+    }
+
     auto body = parse_block_statement(is_strict);
     body->add_variables(m_parser_state.m_var_scopes.last());
     body->add_functions(m_parser_state.m_function_scopes.last());
     return create_ast_node<FunctionNodeType>({ m_parser_state.m_current_token.filename(), rule_start.position(), position() }, name, move(body), move(parameters), function_length, NonnullRefPtrVector<VariableDeclaration>(), is_strict);
 }
 
+RefPtr<LazyFunctionBody> Parser::skip_function_body(bool is_arrow_function, bool& is_strict)
+{
+    if (!match(TokenType::CurlyOpen))
+        return {};
+
+    u8 parse_options = 0;
+    if (is_arrow_function)
+        parse_options |= FunctionNodeParseOptions::IsArrowFunction;
+    if (m_parser_state.m_allow_super_property_lookup)
+        parse_options |= FunctionNodeParseOptions::AllowSuperPropertyLookup;
+    if (m_parser_state.m_allow_super_constructor_call)
+        parse_options |= FunctionNodeParseOptions::AllowSuperConstructorCall;
+    bool is_in_function_context = m_parser_state.m_in_function_context;
+
+    auto& source = m_parser_state.m_lexer.source();
+    if (m_lazy_function_source.is_null()) {
+        m_lazy_function_source = source;
+        m_lazy_function_filename = m_parser_state.m_lexer.filename();
+    }
+
+    auto& open_token = m_parser_state.m_current_token;
+    size_t offset = lazy_function_source_offset(open_token);
+    Position position { open_token.line_number(), open_token.line_column() };
+
+    if (m_preparse_data) {
+        if (auto body = m_preparse_data->function_bodies.get(offset); body.has_value()) {
+            // We already pre-parsed this body as part of the function we're parsing, so we can jump straight to its end.
+            m_parser_state.m_lexer.seek(body->closing_brace_offset - m_lazy_function_source_offset, body->closing_brace_position.line, body->closing_brace_position.column);
+            consume(TokenType::CurlyOpen);
+            consume(TokenType::CurlyClose);
+            m_parser_state.m_string_legacy_octal_escape_sequence_in_scope = false;
+            is_strict = body->is_strict;
+            return LazyFunctionBody::create(m_lazy_function_source, offset, m_lazy_function_filename, position, parse_options, is_strict, is_in_function_context, m_preparse_data);
+        }
+    }
+
+    auto lexer_at_body_start = m_parser_state.m_lexer;
+    auto token_at_body_start = m_parser_state.m_current_token;
+    auto error_count = m_parser_state.m_errors.size();
+    auto string_legacy_octal_escape_sequence_in_scope = m_parser_state.m_string_legacy_octal_escape_sequence_in_scope;
+
+    m_recorded_preparse_data = nullptr;
+    preparse_block_statement(is_strict);
+    auto preparse_data = move(m_recorded_preparse_data);
+
+    if (m_parser_state.m_errors.size() != error_count) {
+        // Let the caller parse the body after all, so the errors are reported exactly like without lazy parsing.
+        m_parser_state.m_lexer = move(lexer_at_body_start);
+        m_parser_state.m_current_token = move(token_at_body_start);
+        m_parser_state.m_errors.shrink(error_count);
+        m_parser_state.m_string_legacy_octal_escape_sequence_in_scope = string_legacy_octal_escape_sequence_in_scope;
+        is_strict = false;
+        return {};
+    }
+
+    return LazyFunctionBody::create(m_lazy_function_source, offset, m_lazy_function_filename, position, parse_options, is_strict, is_in_function_context, move(preparse_data));
+}
+
+size_t Parser::lazy_function_source_offset(const Token& token) const
+{
+    return m_lazy_function_source_offset + (token.value().characters_without_null_termination() - m_parser_state.m_lexer.source().characters_without_null_termination());
+}
+
+NonnullRefPtr<BlockStatement> Parser::parse_lazy_function_body(u8 parse_options, bool is_strict, bool is_in_function_context)
+{
+    bool is_arrow_function = parse_options & FunctionNodeParseOptions::IsArrowFunction;
+    TemporaryChange strict_mode_rollback(m_parser_state.m_strict_mode, is_strict);
+    TemporaryChange super_property_access_rollback(m_parser_state.m_allow_super_property_lookup, !!(parse_options & FunctionNodeParseOptions::AllowSuperPropertyLookup));
+    TemporaryChange super_constructor_call_rollback(m_parser_state.m_allow_super_constructor_call, !!(parse_options & FunctionNodeParseOptions::AllowSuperConstructorCall));
+    TemporaryChange function_context_rollback(m_parser_state.m_in_function_context, is_in_function_context);
+    TemporaryChange arrow_function_context_rollback(m_parser_state.m_in_arrow_function_context, is_arrow_function);
+
+    ScopePusher scope(*this, ScopePusher::Var | ScopePusher::Function);
+
+    bool body_is_strict = false;
+    auto body = parse_block_statement(body_is_strict);
+    // NOTE: Just like with eagerly parsed arrow functions, their var declarations don't end up in the body.
+    if (!is_arrow_function)
+        body->add_variables(m_parser_state.m_var_scopes.last());
+    body->add_functions(m_parser_state.m_function_scopes.last());
+    return body;
+}
+
+const Statement& LazyFunctionBody::statement() const
+{
+    if (m_statement)
+        return *m_statement;
+
+    // NOTE: The lexer counts columns from the first character it consumes.
+    Parser parser(Lexer(m_source.substring_view(m_offset), m_filename, m_position.line, m_position.column - 1));
+    parser.set_lazy_function_parsing_enabled(true);
+    parser.m_lazy_function_source = m_source;
+    parser.m_lazy_function_filename = m_filename;
+    parser.m_lazy_function_source_offset = m_offset;
+    parser.m_preparse_data = m_preparse_data;
+    m_statement = parser.parse_lazy_function_body(m_parse_options, m_is_strict_mode, m_is_in_function_context);
+    if (parser.has_errors())
+        m_syntax_error = parser.errors().first().to_string();
+
+    // Functions nested in this one hold on to the source and preparse data themselves if they need them.
+    m_source = {};
+    m_preparse_data = nullptr;
+    return *m_statement;
+}
+
+void Parser::preparse_declaration()
+{
+    switch (m_parser_state.m_current_token.type()) {
+    case TokenType::Class:
+        preparse_class_expression(true);
+        return;
+    case TokenType::Function:
+        preparse_function_node(FunctionNodeParseOptions::CheckForFunctionAndName, true);
+        return;
+    case TokenType::Let:
+    case TokenType::Const:
+        preparse_variable_declaration();
+        return;
+    default:
+        expected("declaration");
+        consume();
+    }
+}
+
+Parser::PreparsedNode Parser::preparse_statement()
+{
+    switch (m_parser_state.m_current_token.type()) {
+    case TokenType::CurlyOpen:
+        preparse_block_statement();
+        break;
+    case TokenType::Return:
+        preparse_return_statement();
+        break;
+    case TokenType::Var:
+        preparse_variable_declaration();
+        break;
+    case TokenType::For:
+        preparse_for_statement();
+        break;
+    case TokenType::If:
+        preparse_if_statement();
+        break;
+    case TokenType::Throw:
+        preparse_throw_statement();
+        break;
+    case TokenType::Try:
+        preparse_try_statement();
+        break;
+    case TokenType::Break:
+        preparse_break_statement();
+        break;
+    case TokenType::Continue:
+        preparse_continue_statement();
+        break;
+    case TokenType::Switch:
+        preparse_switch_statement();
+        break;
+    case TokenType::Do:
+        preparse_do_while_statement();
+        break;
+    case TokenType::While:
+        preparse_while_statement();
+        break;
+    case TokenType::With:
+        if (m_parser_state.m_strict_mode)
+            syntax_error("'with' statement not allowed in strict mode");
+        preparse_with_statement();
+        break;
+    case TokenType::Debugger:
+        consume();
+        consume_or_insert_semicolon();
+        break;
+    case TokenType::Semicolon:
+        consume();
+        break;
+    default:
+        if (match(TokenType::Identifier) && try_preparse_labelled_statement())
+            break;
+        if (match_expression()) {
+            if (match(TokenType::Function))
+                syntax_error("Function declaration not allowed in single-statement context");
+            // The kind of an expression statement is that of its expression, which is how directives are found.
+            auto expression = preparse_expression(0);
+            consume_or_insert_semicolon();
+            return expression;
+        }
+        expected("statement");
+        consume();
+    }
+    return PreparsedNode::Other;
+}
+
+bool Parser::try_preparse_arrow_function_expression(bool expect_parens)
+{
+    auto lexer = m_parser_state.m_lexer;
+    auto token = m_parser_state.m_current_token;
+    auto error_count = m_parser_state.m_errors.size();
+    auto string_legacy_octal_escape_sequence_in_scope = m_parser_state.m_string_legacy_octal_escape_sequence_in_scope;
+    auto rollback = [&] {
+        m_parser_state.m_lexer = move(lexer);
+        m_parser_state.m_current_token = move(token);
+        m_parser_state.m_errors.shrink(error_count);
+        m_parser_state.m_string_legacy_octal_escape_sequence_in_scope = string_legacy_octal_escape_sequence_in_scope;
+        return false;
+    };
+
+    if (expect_parens) {
+        preparse_function_parameters(FunctionNodeParseOptions::IsArrowFunction);
+        if (m_parser_state.m_errors.size() > error_count && m_parser_state.m_errors[error_count].message.starts_with("Unexpected token"))
+            return rollback();
+        if (!match(TokenType::ParenClose))
+            return rollback();
+        consume();
+    } else {
+        if (!match(TokenType::Identifier))
+            return rollback();
+        consume();
+    }
+    if (m_parser_state.m_current_token.trivia_contains_line_terminator())
+        return rollback();
+    if (!match(TokenType::Arrow))
+        return rollback();
+    consume();
+
+    auto old_labels_in_scope = move(m_parser_state.m_labels_in_scope);
+    ScopeGuard guard([&]() {
+        m_parser_state.m_labels_in_scope = move(old_labels_in_scope);
+    });
+    TemporaryChange break_context_rollback(m_parser_state.m_in_break_context, false);
+    TemporaryChange continue_context_rollback(m_parser_state.m_in_continue_context, false);
+
+    TemporaryChange change(m_parser_state.m_in_arrow_function_context, true);
+    if (match(TokenType::CurlyOpen)) {
+        preparse_function_body();
+        return true;
+    }
+    if (match_expression()) {
+        preparse_expression(2);
+        return true;
+    }
+    return rollback();
+}
+
+bool Parser::try_preparse_labelled_statement()
+{
+    auto lexer = m_parser_state.m_lexer;
+    auto token = m_parser_state.m_current_token;
+
+    auto rollback = [&] {
+        m_parser_state.m_lexer = move(lexer);
+        m_parser_state.m_current_token = move(token);
+        return false;
+    };
+
+    auto identifier = consume(TokenType::Identifier).value();
+    if (!match(TokenType::Colon))
+        return rollback();
+    consume(TokenType::Colon);
+
+    if (!match_statement())
+        return rollback();
+    m_parser_state.m_labels_in_scope.set(identifier);
+    preparse_statement();
+    m_parser_state.m_labels_in_scope.remove(identifier);
+    return true;
+}
+
+bool Parser::try_preparse_new_target_expression()
+{
+    auto lexer = m_parser_state.m_lexer;
+    auto token = m_parser_state.m_current_token;
+
+    consume(TokenType::New);
+    if (match(TokenType::Period)) {
+        consume();
+        if (match(TokenType::Identifier) && consume().value() == "target")
+            return true;
+    }
+
+    m_parser_state.m_lexer = move(lexer);
+    m_parser_state.m_current_token = move(token);
+    return false;
+}
+
+void Parser::preparse_class_expression(bool expect_class_name)
+{
+    TemporaryChange strict_mode_rollback(m_parser_state.m_strict_mode, true);
+
+    consume(TokenType::Class);
+
+    if (expect_class_name || match(TokenType::Identifier))
+        consume(TokenType::Identifier);
+
+    bool has_super_class = false;
+    if (match(TokenType::Extends)) {
+        consume();
+        preparse_primary_expression();
+        has_super_class = true;
+    }
+
+    consume(TokenType::CurlyOpen);
+
+    bool has_constructor = false;
+    while (!done() && !match(TokenType::CurlyClose)) {
+        bool has_property_key = false;
+        bool is_static = false;
+        bool is_constructor = false;
+        auto method_kind = ClassMethod::Kind::Method;
+
+        if (match(TokenType::Semicolon)) {
+            consume();
+            continue;
+        }
+
+        if (match_property_key()) {
+            StringView name;
+            String string_literal_value;
+            if (match(TokenType::Identifier) && m_parser_state.m_current_token.value() == "static") {
+                consume();
+                is_static = true;
+            }
+
+            if (match(TokenType::Identifier)) {
+                auto identifier_name = m_parser_state.m_current_token.value();
+
+                if (identifier_name == "get") {
+                    method_kind = ClassMethod::Kind::Getter;
+                    consume();
+                } else if (identifier_name == "set") {
+                    method_kind = ClassMethod::Kind::Setter;
+                    consume();
+                }
+            }
+
+            if (match_property_key()) {
+                switch (m_parser_state.m_current_token.type()) {
+                case TokenType::Identifier:
+                    name = consume().value();
+                    break;
+                case TokenType::StringLiteral:
+                    // NOTE: Escape sequences can spell "constructor", so this needs the string's actual value.
+                    string_literal_value = parse_string_literal(consume())->value();
+                    name = string_literal_value;
+                    break;
+                default:
+                    preparse_property_key();
+                    break;
+                }
+                has_property_key = true;
+            } else {
+                expected("property key");
+            }
+
+            if (!is_static && name == "constructor") {
+                if (method_kind != ClassMethod::Kind::Method)
+                    syntax_error("Class constructor may not be an accessor");
+                if (has_constructor)
+                    syntax_error("Classes may not have more than one constructor");
+
+                is_constructor = true;
+            }
+        }
+
+        if (match(TokenType::ParenOpen)) {
+            u8 parse_options = FunctionNodeParseOptions::AllowSuperPropertyLookup;
+            if (has_super_class)
+                parse_options |= FunctionNodeParseOptions::AllowSuperConstructorCall;
+            if (method_kind == ClassMethod::Kind::Getter)
+                parse_options |= FunctionNodeParseOptions::IsGetterFunction;
+            if (method_kind == ClassMethod::Kind::Setter)
+                parse_options |= FunctionNodeParseOptions::IsSetterFunction;
+            preparse_function_node(parse_options);
+            if (is_constructor)
+                has_constructor = true;
+            else if (!has_property_key)
+                syntax_error("No key for class method");
+        } else {
+            expected("ParenOpen");
+            consume();
+        }
+    }
+
+    consume(TokenType::CurlyClose);
+}
+
+Parser::PreparsedNode Parser::preparse_primary_expression()
+{
+    if (match_unary_prefixed_expression()) {
+        preparse_unary_prefixed_expression();
+        return PreparsedNode::Other;
+    }
+
+    switch (m_parser_state.m_current_token.type()) {
+    case TokenType::ParenOpen: {
+        auto paren_position = position();
+        consume(TokenType::ParenOpen);
+        if ((match(TokenType::ParenClose) || match(TokenType::Identifier) || match(TokenType::TripleDot)) && !try_parse_arrow_function_expression_failed_at_position(paren_position)) {
+            if (try_preparse_arrow_function_expression(true))
+                return PreparsedNode::Other;
+
+            set_try_parse_arrow_function_expression_failed_at_position(paren_position, true);
+        }
+        auto expression = preparse_expression(0);
+        consume(TokenType::ParenClose);
+        return expression;
+    }
+    case TokenType::Class:
+        preparse_class_expression(false);
+        return PreparsedNode::Other;
+    case TokenType::Super:
+        consume();
+        if (!m_parser_state.m_allow_super_property_lookup)
+            syntax_error("'super' keyword unexpected here");
+        return PreparsedNode::SuperExpression;
+    case TokenType::Identifier: {
+        if (!try_parse_arrow_function_expression_failed_at_position(position())) {
+            if (try_preparse_arrow_function_expression(false))
+                return PreparsedNode::Other;
+
+            set_try_parse_arrow_function_expression_failed_at_position(position(), true);
+        }
+        auto name = consume().value();
+        if (name == "eval" || name == "arguments")
+            return PreparsedNode::EvalOrArguments;
+        return PreparsedNode::Identifier;
+    }
+    case TokenType::NumericLiteral:
+        consume_and_validate_numeric_literal();
+        return PreparsedNode::Other;
+    case TokenType::This:
+    case TokenType::BigIntLiteral:
+    case TokenType::BoolLiteral:
+    case TokenType::NullLiteral:
+        consume();
+        return PreparsedNode::Other;
+    case TokenType::StringLiteral:
+        return preparse_string_literal(consume());
+    case TokenType::CurlyOpen:
+        preparse_object_expression();
+        return PreparsedNode::Other;
+    case TokenType::Function:
+        preparse_function_node(FunctionNodeParseOptions::CheckForFunctionAndName);
+        return PreparsedNode::Other;
+    case TokenType::BracketOpen:
+        preparse_array_expression();
+        return PreparsedNode::Other;
+    case TokenType::RegexLiteral:
+        consume();
+        if (match(TokenType::RegexFlags))
+            consume();
+        return PreparsedNode::Other;
+    case TokenType::TemplateLiteralStart:
+        preparse_template_literal();
+        return PreparsedNode::Other;
+    case TokenType::New: {
+        auto new_start = position();
+        if (try_preparse_new_target_expression()) {
+            if (!m_parser_state.m_in_function_context)
+                syntax_error("'new.target' not allowed outside of a function", new_start);
+            return PreparsedNode::Other;
+        }
+        preparse_new_expression();
+        return PreparsedNode::Other;
+    }
+    default:
+        expected("primary expression");
+        consume();
+        return PreparsedNode::Other;
+    }
+}
+
+void Parser::preparse_unary_prefixed_expression()
+{
+    auto type = m_parser_state.m_current_token.type();
+    auto precedence = g_operator_precedence.get(type);
+    auto associativity = operator_associativity(type);
+    consume();
+    auto rhs_start = position();
+    auto rhs = preparse_expression(precedence, associativity);
+    if (type != TokenType::PlusPlus && type != TokenType::MinusMinus)
+        return;
+    if (rhs != PreparsedNode::Identifier && rhs != PreparsedNode::EvalOrArguments && rhs != PreparsedNode::MemberExpression) {
+        auto operator_name = type == TokenType::PlusPlus ? "increment" : "decrement";
+        syntax_error(String::formatted("Right-hand side of prefix {} operator must be identifier or member expression", operator_name), rhs_start);
+    }
+}
+
+void Parser::preparse_property_key()
+{
+    if (match(TokenType::StringLiteral)) {
+        preparse_string_literal(consume());
+    } else if (match(TokenType::NumericLiteral) || match(TokenType::BigIntLiteral)) {
+        consume();
+    } else if (match(TokenType::BracketOpen)) {
+        consume(TokenType::BracketOpen);
+        preparse_expression(0);
+        consume(TokenType::BracketClose);
+    } else {
+        if (!match_identifier_name())
+            expected("IdentifierName");
+        consume();
+    }
+}
+
+void Parser::preparse_object_expression()
+{
+    consume(TokenType::CurlyOpen);
+
+    auto skip_to_next_property = [&] {
+        while (!done() && !match(TokenType::Comma) && !match(TokenType::CurlyOpen))
+            consume();
+    };
+
+    while (!done() && !match(TokenType::CurlyClose)) {
+        auto property_type = ObjectProperty::Type::KeyValue;
+        bool is_shorthand_property = false;
+
+        if (match(TokenType::TripleDot)) {
+            consume();
+            preparse_expression(4);
+            if (!match(TokenType::Comma))
+                break;
+            consume(TokenType::Comma);
+            continue;
+        }
+
+        if (match(TokenType::Identifier)) {
+            auto identifier = consume().value();
+            if (identifier == "get" && match_property_key()) {
+                property_type = ObjectProperty::Type::Getter;
+                preparse_property_key();
+            } else if (identifier == "set" && match_property_key()) {
+                property_type = ObjectProperty::Type::Setter;
+                preparse_property_key();
+            } else {
+                is_shorthand_property = true;
+            }
+        } else {
+            preparse_property_key();
+        }
+
+        if (property_type == ObjectProperty::Type::Getter || property_type == ObjectProperty::Type::Setter) {
+            if (!match(TokenType::ParenOpen)) {
+                syntax_error("Expected '(' for object getter or setter property");
+                skip_to_next_property();
+                continue;
+            }
+        }
+
+        if (match(TokenType::ParenOpen)) {
+            u8 parse_options = FunctionNodeParseOptions::AllowSuperPropertyLookup;
+            if (property_type == ObjectProperty::Type::Getter)
+                parse_options |= FunctionNodeParseOptions::IsGetterFunction;
+            if (property_type == ObjectProperty::Type::Setter)
+                parse_options |= FunctionNodeParseOptions::IsSetterFunction;
+            preparse_function_node(parse_options);
+        } else if (match(TokenType::Colon)) {
+            consume();
+            preparse_expression(2);
+        } else if (!is_shorthand_property) {
+            syntax_error("Expected a property");
+            skip_to_next_property();
+            continue;
+        }
+
+        if (!match(TokenType::Comma))
+            break;
+        consume(TokenType::Comma);
+    }
+
+    consume(TokenType::CurlyClose);
+}
+
+void Parser::preparse_array_expression()
+{
+    consume(TokenType::BracketOpen);
+
+    while (match_expression() || match(TokenType::TripleDot) || match(TokenType::Comma)) {
+        if (match(TokenType::TripleDot)) {
+            consume(TokenType::TripleDot);
+            preparse_expression(2);
+        } else if (match_expression()) {
+            preparse_expression(2);
+        }
+
+        if (!match(TokenType::Comma))
+            break;
+        consume(TokenType::Comma);
+    }
+
+    consume(TokenType::BracketClose);
+}
+
+Parser::PreparsedNode Parser::preparse_string_literal(const Token& token, bool in_template_literal)
+{
+    // Only escape sequences can make a string literal invalid, so we don't have to decode the others.
+    if (token.value().contains('\\')) {
+        auto status = Token::StringValueStatus::Ok;
+        token.string_value(status);
+        if (status == Token::StringValueStatus::LegacyOctalEscapeSequence) {
+            m_parser_state.m_string_legacy_octal_escape_sequence_in_scope = true;
+            if (in_template_literal)
+                syntax_error("Octal escape sequence not allowed in template literal", Position { token.line_number(), token.line_column() });
+            else if (m_parser_state.m_strict_mode)
+                syntax_error("Octal escape sequence in string literal not allowed in strict mode", Position { token.line_number(), token.line_column() });
+        } else if (status != Token::StringValueStatus::Ok) {
+            syntax_error("Malformed escape sequence", Position { token.line_number(), token.line_column() });
+        }
+    }
+
+    if (!in_template_literal && (token.value() == "'use strict'" || token.value() == "\"use strict\""))
+        return PreparsedNode::UseStrictDirective;
+    return PreparsedNode::StringLiteral;
+}
+
+void Parser::preparse_template_literal()
+{
+    consume(TokenType::TemplateLiteralStart);
+
+    while (!done() && !match(TokenType::TemplateLiteralEnd) && !match(TokenType::UnterminatedTemplateLiteral)) {
+        if (match(TokenType::TemplateLiteralString)) {
+            preparse_string_literal(consume(), true);
+        } else if (match(TokenType::TemplateLiteralExprStart)) {
+            consume(TokenType::TemplateLiteralExprStart);
+            if (match(TokenType::TemplateLiteralExprEnd)) {
+                syntax_error("Empty template literal expression block");
+                return;
+            }
+
+            preparse_expression(0);
+            if (match(TokenType::UnterminatedTemplateLiteral)) {
+                syntax_error("Unterminated template literal");
+                return;
+            }
+            consume(TokenType::TemplateLiteralExprEnd);
+        } else {
+            expected("Template literal string or expression");
+            break;
+        }
+    }
+
+    if (match(TokenType::UnterminatedTemplateLiteral))
+        syntax_error("Unterminated template literal");
+    else
+        consume(TokenType::TemplateLiteralEnd);
+}
+
+Parser::PreparsedNode Parser::preparse_expression(int min_precedence, Associativity associativity, const Vector<TokenType>& forbidden)
+{
+    auto expression = preparse_primary_expression();
+    while (match(TokenType::TemplateLiteralStart)) {
+        preparse_template_literal();
+        expression = PreparsedNode::Other;
+    }
+    while (match_secondary_expression(forbidden)) {
+        int new_precedence = g_operator_precedence.get(m_parser_state.m_current_token.type());
+        if (new_precedence < min_precedence)
+            break;
+        if (new_precedence == min_precedence && associativity == Associativity::Left)
+            break;
+
+        Associativity new_associativity = operator_associativity(m_parser_state.m_current_token.type());
+        expression = preparse_secondary_expression(expression, new_precedence, new_associativity);
+        while (match(TokenType::TemplateLiteralStart)) {
+            preparse_template_literal();
+            expression = PreparsedNode::Other;
+        }
+    }
+    if (match(TokenType::Comma) && min_precedence <= 1) {
+        while (match(TokenType::Comma)) {
+            consume();
+            preparse_expression(2);
+        }
+        expression = PreparsedNode::Other;
+    }
+    return expression;
+}
+
+Parser::PreparsedNode Parser::preparse_secondary_expression(PreparsedNode lhs, int min_precedence, Associativity associativity)
+{
+    switch (m_parser_state.m_current_token.type()) {
+    case TokenType::PlusEquals:
+    case TokenType::MinusEquals:
+    case TokenType::AsteriskEquals:
+    case TokenType::SlashEquals:
+    case TokenType::PercentEquals:
+    case TokenType::DoubleAsteriskEquals:
+    case TokenType::AmpersandEquals:
+    case TokenType::PipeEquals:
+    case TokenType::CaretEquals:
+    case TokenType::ShiftLeftEquals:
+    case TokenType::ShiftRightEquals:
+    case TokenType::UnsignedShiftRightEquals:
+    case TokenType::Equals:
+    case TokenType::DoubleAmpersandEquals:
+    case TokenType::DoublePipeEquals:
+    case TokenType::DoubleQuestionMarkEquals:
+        preparse_assignment_expression(lhs, min_precedence, associativity);
+        return PreparsedNode::Other;
+    case TokenType::ParenOpen:
+        if (!m_parser_state.m_allow_super_constructor_call && lhs == PreparsedNode::SuperExpression)
+            syntax_error("'super' keyword unexpected here");
+        preparse_call_arguments();
+        return PreparsedNode::CallExpression;
+    case TokenType::Period:
+        consume();
+        if (!match_identifier_name())
+            expected("IdentifierName");
+        consume();
+        return PreparsedNode::MemberExpression;
+    case TokenType::BracketOpen:
+        consume(TokenType::BracketOpen);
+        preparse_expression(0);
+        consume(TokenType::BracketClose);
+        return PreparsedNode::MemberExpression;
+    case TokenType::PlusPlus:
+    case TokenType::MinusMinus:
+        if (lhs != PreparsedNode::Identifier && lhs != PreparsedNode::EvalOrArguments && lhs != PreparsedNode::MemberExpression)
+            syntax_error("Left-hand side of postfix increment operator must be identifier or member expression");
+        consume();
+        return PreparsedNode::Other;
+    case TokenType::QuestionMark:
+        consume(TokenType::QuestionMark);
+        preparse_expression(2);
+        consume(TokenType::Colon);
+        preparse_expression(2);
+        return PreparsedNode::Other;
+    default:
+        // Everything else match_secondary_expression() accepts is a binary or logical operator.
+        consume();
+        preparse_expression(min_precedence, associativity);
+        return PreparsedNode::Other;
+    }
+}
+
+void Parser::preparse_assignment_expression(PreparsedNode lhs, int min_precedence, Associativity associativity)
+{
+    consume();
+    if (lhs != PreparsedNode::Identifier && lhs != PreparsedNode::EvalOrArguments && lhs != PreparsedNode::MemberExpression && lhs != PreparsedNode::CallExpression)
+        syntax_error("Invalid left-hand side in assignment");
+    else if (m_parser_state.m_strict_mode && lhs == PreparsedNode::EvalOrArguments)
+        syntax_error("'eval' or 'arguments' cannot be assigned to in strict mode code");
+    else if (m_parser_state.m_strict_mode && lhs == PreparsedNode::CallExpression)
+        syntax_error("Cannot assign to function call");
+    preparse_expression(min_precedence, associativity);
+}
+
+void Parser::preparse_call_arguments()
+{
+    consume(TokenType::ParenOpen);
+    while (match_expression() || match(TokenType::TripleDot)) {
+        if (match(TokenType::TripleDot))
+            consume();
+        preparse_expression(2);
+        if (!match(TokenType::Comma))
+            break;
+        consume();
+    }
+    consume(TokenType::ParenClose);
+}
+
+void Parser::preparse_new_expression()
+{
+    consume(TokenType::New);
+    preparse_expression(g_operator_precedence.get(TokenType::New), Associativity::Right, { TokenType::ParenOpen });
+    if (match(TokenType::ParenOpen))
+        preparse_call_arguments();
+}
+
+void Parser::preparse_return_statement()
+{
+    if (!m_parser_state.m_in_function_context && !m_parser_state.m_in_arrow_function_context)
+        syntax_error("'return' not allowed outside of a function");
+
+    consume(TokenType::Return);
+
+    if (m_parser_state.m_current_token.trivia_contains_line_terminator())
+        return;
+
+    if (match_expression())
+        preparse_expression(0);
+    consume_or_insert_semicolon();
+}
+
+void Parser::preparse_block_statement()
+{
+    bool dummy = false;
+    preparse_block_statement(dummy);
+}
+
+Token Parser::preparse_block_statement(bool& is_strict)
+{
+    consume(TokenType::CurlyOpen);
+
+    bool in_directive_prologue = true;
+    bool initial_strict_mode_state = m_parser_state.m_strict_mode;
+    if (initial_strict_mode_state)
+        is_strict = true;
+
+    while (!done() && !match(TokenType::CurlyClose)) {
+        if (match_declaration()) {
+            preparse_declaration();
+            in_directive_prologue = false;
+        } else if (match_statement()) {
+            auto statement = preparse_statement();
+            if (statement == PreparsedNode::UseStrictDirective) {
+                if (in_directive_prologue && !initial_strict_mode_state) {
+                    is_strict = true;
+                    m_parser_state.m_strict_mode = true;
+                }
+                if (m_parser_state.m_string_legacy_octal_escape_sequence_in_scope)
+                    syntax_error("Octal escape sequence in string literal not allowed in strict mode");
+            }
+            if (statement != PreparsedNode::StringLiteral && statement != PreparsedNode::UseStrictDirective)
+                in_directive_prologue = false;
+        } else {
+            expected("statement or declaration");
+            consume();
+            in_directive_prologue = false;
+        }
+    }
+    m_parser_state.m_strict_mode = initial_strict_mode_state;
+    m_parser_state.m_string_legacy_octal_escape_sequence_in_scope = false;
+    return consume(TokenType::CurlyClose);
+}
+
+void Parser::preparse_function_node(u8 parse_options, bool must_have_name)
+{
+    TemporaryChange super_property_access_rollback(m_parser_state.m_allow_super_property_lookup, !!(parse_options & FunctionNodeParseOptions::AllowSuperPropertyLookup));
+    TemporaryChange super_constructor_call_rollback(m_parser_state.m_allow_super_constructor_call, !!(parse_options & FunctionNodeParseOptions::AllowSuperConstructorCall));
+
+    if (parse_options & FunctionNodeParseOptions::CheckForFunctionAndName) {
+        consume(TokenType::Function);
+        if (must_have_name || match(TokenType::Identifier))
+            consume(TokenType::Identifier);
+    }
+    consume(TokenType::ParenOpen);
+    preparse_function_parameters(parse_options);
+    consume(TokenType::ParenClose);
+
+    TemporaryChange change(m_parser_state.m_in_function_context, true);
+    auto old_labels_in_scope = move(m_parser_state.m_labels_in_scope);
+    ScopeGuard guard([&]() {
+        m_parser_state.m_labels_in_scope = move(old_labels_in_scope);
+    });
+    TemporaryChange break_context_rollback(m_parser_state.m_in_break_context, false);
+    TemporaryChange continue_context_rollback(m_parser_state.m_in_continue_context, false);
+
+    preparse_function_body();
+}
+
+void Parser::preparse_function_body()
+{
+    auto opening_brace = m_parser_state.m_current_token;
+    bool is_strict = false;
+    auto closing_brace = preparse_block_statement(is_strict);
+    if (opening_brace.type() != TokenType::CurlyOpen || closing_brace.type() != TokenType::CurlyClose)
+        return;
+
+    if (!m_recorded_preparse_data)
+        m_recorded_preparse_data = adopt_ref(*new PreparseData);
+    m_recorded_preparse_data->function_bodies.set(lazy_function_source_offset(opening_brace), { lazy_function_source_offset(closing_brace), { closing_brace.line_number(), closing_brace.line_column() }, is_strict });
+}
+
+void Parser::preparse_function_parameters(u8 parse_options)
+{
+    bool has_default_parameter = false;
+    bool has_rest_parameter = false;
+
+    Vector<StringView, 8> parameter_names;
+
+    auto consume_and_validate_identifier = [&] {
+        auto token = consume(TokenType::Identifier);
+        auto parameter_name = token.value();
+
+        if (parameter_names.contains_slow(parameter_name)) {
+            String message;
+            if (parse_options & FunctionNodeParseOptions::IsArrowFunction)
+                message = String::formatted("Duplicate parameter '{}' not allowed in arrow function", parameter_name);
+            else if (m_parser_state.m_strict_mode)
+                message = String::formatted("Duplicate parameter '{}' not allowed in strict mode", parameter_name);
+            else if (has_default_parameter || match(TokenType::Equals))
+                message = String::formatted("Duplicate parameter '{}' not allowed in function with default parameter", parameter_name);
+            else if (has_rest_parameter)
+                message = String::formatted("Duplicate parameter '{}' not allowed in function with rest parameter", parameter_name);
+            if (!message.is_empty())
+                syntax_error(message, Position { token.line_number(), token.line_column() });
+        }
+        parameter_names.append(parameter_name);
+    };
+
+    while (match(TokenType::Identifier) || match(TokenType::TripleDot)) {
+        if (parse_options & FunctionNodeParseOptions::IsGetterFunction)
+            syntax_error("Getter function must have no arguments");
+        if (parse_options & FunctionNodeParseOptions::IsSetterFunction && (parameter_names.size() >= 1 || match(TokenType::TripleDot)))
+            syntax_error("Setter function must have one argument");
+        if (match(TokenType::TripleDot)) {
+            consume();
+            has_rest_parameter = true;
+            consume_and_validate_identifier();
+            break;
+        }
+        consume_and_validate_identifier();
+        if (match(TokenType::Equals)) {
+            consume();
+            has_default_parameter = true;
+            preparse_expression(2);
+        }
+        if (match(TokenType::ParenClose))
+            break;
+        consume(TokenType::Comma);
+    }
+    if (parse_options & FunctionNodeParseOptions::IsSetterFunction && parameter_names.is_empty())
+        syntax_error("Setter function must have one argument");
+}
+
+Parser::PreparsedVariableDeclaration Parser::preparse_variable_declaration(bool for_loop_variable_declaration)
+{
+    bool is_const = match(TokenType::Const);
+    consume();
+
+    PreparsedVariableDeclaration declaration;
+    for (;;) {
+        consume(TokenType::Identifier);
+        bool has_init = false;
+        if (match(TokenType::Equals)) {
+            consume();
+            preparse_expression(2);
+            has_init = true;
+        } else if (!for_loop_variable_declaration && is_const) {
+            syntax_error("Missing initializer in 'const' variable declaration");
+        }
+        if (declaration.declarator_count++ == 0)
+            declaration.first_declarator_has_init = has_init;
+        if (!has_init)
+            declaration.has_declarator_without_init = true;
+        if (match(TokenType::Comma)) {
+            consume();
+            continue;
+        }
+        break;
+    }
+    if (!for_loop_variable_declaration)
+        consume_or_insert_semicolon();
+    return declaration;
+}
+
+void Parser::preparse_throw_statement()
+{
+    consume(TokenType::Throw);
+
+    if (m_parser_state.m_current_token.trivia_contains_line_terminator()) {
+        syntax_error("No line break is allowed between 'throw' and its expression");
+        return;
+    }
+
+    preparse_expression(0);
+    consume_or_insert_semicolon();
+}
+
+void Parser::preparse_break_statement()
+{
+    consume(TokenType::Break);
+    bool has_label = false;
+    if (match(TokenType::Semicolon)) {
+        consume();
+    } else {
+        if (match(TokenType::Identifier) && !m_parser_state.m_current_token.trivia_contains_line_terminator()) {
+            auto target_label = consume().value();
+            has_label = true;
+            if (!m_parser_state.m_labels_in_scope.contains(target_label))
+                syntax_error(String::formatted("Label '{}' not found", target_label));
+        }
+        consume_or_insert_semicolon();
+    }
+
+    if (!has_label && !m_parser_state.m_in_break_context)
+        syntax_error("Unlabeled 'break' not allowed outside of a loop or switch statement");
+}
+
+void Parser::preparse_continue_statement()
+{
+    if (!m_parser_state.m_in_continue_context)
+        syntax_error("'continue' not allow outside of a loop");
+
+    consume(TokenType::Continue);
+    if (match(TokenType::Semicolon)) {
+        consume();
+        return;
+    }
+    if (match(TokenType::Identifier) && !m_parser_state.m_current_token.trivia_contains_line_terminator()) {
+        auto target_label = consume().value();
+        if (!m_parser_state.m_labels_in_scope.contains(target_label))
+            syntax_error(String::formatted("Label '{}' not found", target_label));
+    }
+    consume_or_insert_semicolon();
+}
+
+void Parser::preparse_try_statement()
+{
+    consume(TokenType::Try);
+
+    preparse_block_statement();
+
+    bool has_handler = match(TokenType::Catch);
+    if (has_handler)
+        preparse_catch_clause();
+
+    bool has_finalizer = match(TokenType::Finally);
+    if (has_finalizer) {
+        consume();
+        preparse_block_statement();
+    }
+
+    if (!has_handler && !has_finalizer)
+        syntax_error("try statement must have a 'catch' or 'finally' clause");
+}
+
+void Parser::preparse_do_while_statement()
+{
+    consume(TokenType::Do);
+
+    {
+        TemporaryChange break_change(m_parser_state.m_in_break_context, true);
+        TemporaryChange continue_change(m_parser_state.m_in_continue_context, true);
+        preparse_statement();
+    }
+
+    consume(TokenType::While);
+    consume(TokenType::ParenOpen);
+    preparse_expression(0);
+    consume(TokenType::ParenClose);
+
+    if (match(TokenType::Semicolon))
+        consume();
+}
+
+void Parser::preparse_while_statement()
+{
+    consume(TokenType::While);
+    consume(TokenType::ParenOpen);
+    preparse_expression(0);
+    consume(TokenType::ParenClose);
+
+    TemporaryChange break_change(m_parser_state.m_in_break_context, true);
+    TemporaryChange continue_change(m_parser_state.m_in_continue_context, true);
+    preparse_statement();
+}
+
+void Parser::preparse_switch_statement()
+{
+    consume(TokenType::Switch);
+
+    consume(TokenType::ParenOpen);
+    preparse_expression(0);
+    consume(TokenType::ParenClose);
+
+    consume(TokenType::CurlyOpen);
+
+    auto has_default = false;
+    while (match(TokenType::Case) || match(TokenType::Default)) {
+        if (match(TokenType::Default)) {
+            if (has_default)
+                syntax_error("Multiple 'default' clauses in switch statement");
+            has_default = true;
+        }
+        preparse_switch_case();
+    }
+
+    consume(TokenType::CurlyClose);
+}
+
+void Parser::preparse_with_statement()
+{
+    consume(TokenType::With);
+    consume(TokenType::ParenOpen);
+    preparse_expression(0);
+    consume(TokenType::ParenClose);
+    preparse_statement();
+}
+
+void Parser::preparse_switch_case()
+{
+    if (consume().type() == TokenType::Case)
+        preparse_expression(0);
+
+    consume(TokenType::Colon);
+
+    TemporaryChange break_change(m_parser_state.m_in_break_context, true);
+    for (;;) {
+        if (match_declaration())
+            preparse_declaration();
+        else if (match_statement())
+            preparse_statement();
+        else
+            break;
+    }
+}
+
+void Parser::preparse_catch_clause()
+{
+    consume(TokenType::Catch);
+
+    if (match(TokenType::ParenOpen)) {
+        consume();
+        consume(TokenType::Identifier);
+        consume(TokenType::ParenClose);
+    }
+
+    preparse_block_statement();
+}
+
+void Parser::preparse_if_statement()
+{
+    consume(TokenType::If);
+    consume(TokenType::ParenOpen);
+    preparse_expression(0);
+    consume(TokenType::ParenClose);
+
+    if (!m_parser_state.m_strict_mode && match(TokenType::Function))
+        preparse_declaration();
+    else
+        preparse_statement();
+
+    if (match(TokenType::Else)) {
+        consume();
+        if (!m_parser_state.m_strict_mode && match(TokenType::Function))
+            preparse_declaration();
+        else
+            preparse_statement();
+    }
+}
+
+void Parser::preparse_for_statement()
+{
+    auto match_for_in_of = [&]() {
+        return match(TokenType::In) || (match(TokenType::Identifier) && m_parser_state.m_current_token.value() == "of");
+    };
+
+    consume(TokenType::For);
+
+    consume(TokenType::ParenOpen);
+
+    if (!match(TokenType::Semicolon)) {
+        if (match_expression()) {
+            preparse_expression(0, Associativity::Right, { TokenType::In });
+            if (match_for_in_of()) {
+                preparse_for_in_of_statement(nullptr);
+                return;
+            }
+        } else if (match_variable_declaration()) {
+            bool is_const = match(TokenType::Const);
+            auto declaration = preparse_variable_declaration(true);
+            if (match_for_in_of()) {
+                preparse_for_in_of_statement(&declaration);
+                return;
+            }
+            if (is_const && declaration.has_declarator_without_init)
+                syntax_error("Missing initializer in 'const' variable declaration");
+        } else {
+            syntax_error("Unexpected token in for loop");
+        }
+    }
+    consume(TokenType::Semicolon);
+
+    if (!match(TokenType::Semicolon))
+        preparse_expression(0);
+
+    consume(TokenType::Semicolon);
+
+    if (!match(TokenType::ParenClose))
+        preparse_expression(0);
+
+    consume(TokenType::ParenClose);
+
+    TemporaryChange break_change(m_parser_state.m_in_break_context, true);
+    TemporaryChange continue_change(m_parser_state.m_in_continue_context, true);
+    preparse_statement();
+}
+
+void Parser::preparse_for_in_of_statement(const PreparsedVariableDeclaration* declaration)
+{
+    if (declaration) {
+        if (declaration->declarator_count > 1)
+            syntax_error("multiple declarations not allowed in for..in/of");
+        if (declaration->first_declarator_has_init)
+            syntax_error("variable initializer not allowed in for..in/of");
+    }
+    consume();
+    preparse_expression(0);
+    consume(TokenType::ParenClose);
+
+    TemporaryChange break_change(m_parser_state.m_in_break_context, true);
+    TemporaryChange continue_change(m_parser_state.m_in_continue_context, true);
+    preparse_statement();
+}
+
 Vector<FunctionNode::Parameter> Parser::parse_function_parameters(int& function_length, u8 parse_options)
 {
     auto rule_start = push_start();
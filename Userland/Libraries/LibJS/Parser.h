@@ -38,6 +38,11 @@ public:
 
     NonnullRefPtr<Program> parse_program();
 
+    // When enabled, function bodies are only pre-parsed, and their AST is built when
+    // the function is first called. Pre-parsing finds the same syntax errors as parsing,
+    // so a broken function body still fails the whole parse.
+    void set_lazy_function_parsing_enabled(bool enabled) { m_lazy_function_parsing_enabled = enabled; }
+
     template<typename FunctionNodeType>
     NonnullRefPtr<FunctionNodeType> parse_function_node(u8 parse_options = FunctionNodeParseOptions::CheckForFunctionAndName);
     Vector<FunctionNode::Parameter> parse_function_parameters(int& function_length, u8 parse_options = 0);
@@ -133,6 +138,71 @@ public:
 
 private:
     friend class ScopePusher;
+    friend class LazyFunctionBody;
+
+    RefPtr<LazyFunctionBody> skip_function_body(bool is_arrow_function, bool& is_strict);
+    size_t lazy_function_source_offset(const Token&) const;
+    NonnullRefPtr<BlockStatement> parse_lazy_function_body(u8 parse_options, bool is_strict, bool is_in_function_context);
+
+    // Pre-parsing walks the same grammar as parsing and reports the same syntax errors, but doesn't
+    // build an AST. The few errors that depend on what was parsed only need to know which kind
+    // of node the parser would have built.
+    enum class PreparsedNode {
+        Identifier,
+        EvalOrArguments,
+        MemberExpression,
+        CallExpression,
+        SuperExpression,
+        StringLiteral,
+        UseStrictDirective,
+        Other,
+    };
+
+    struct PreparsedVariableDeclaration {
+        size_t declarator_count { 0 };
+        bool first_declarator_has_init { false };
+        bool has_declarator_without_init { false };
+    };
+
+    void preparse_declaration();
+    PreparsedNode preparse_statement();
+    void preparse_block_statement();
+    // Returns the closing curly brace, so function bodies know where they end.
+    Token preparse_block_statement(bool& is_strict);
+    void preparse_function_node(u8 parse_options, bool must_have_name = false);
+    void preparse_function_body();
+    void preparse_function_parameters(u8 parse_options);
+    void preparse_return_statement();
+    PreparsedVariableDeclaration preparse_variable_declaration(bool for_loop_variable_declaration = false);
+    void preparse_for_statement();
+    void preparse_for_in_of_statement(const PreparsedVariableDeclaration*);
+    void preparse_if_statement();
+    void preparse_throw_statement();
+    void preparse_try_statement();
+    void preparse_catch_clause();
+    void preparse_switch_statement();
+    void preparse_switch_case();
+    void preparse_break_statement();
+    void preparse_continue_statement();
+    void preparse_do_while_statement();
+    void preparse_while_statement();
+    void preparse_with_statement();
+    bool try_preparse_labelled_statement();
+    PreparsedNode preparse_expression(int min_precedence, Associativity associate = Associativity::Right, const Vector<TokenType>& forbidden = {});
+    PreparsedNode preparse_primary_expression();
+    void preparse_unary_prefixed_expression();
+    void preparse_object_expression();
+    void preparse_array_expression();
+    PreparsedNode preparse_string_literal(const Token&, bool in_template_literal = false);
+    void preparse_template_literal();
+    PreparsedNode preparse_secondary_expression(PreparsedNode lhs, int min_precedence, Associativity associate = Associativity::Right);
+    void preparse_assignment_expression(PreparsedNode lhs, int min_precedence, Associativity);
+    void preparse_call_arguments();
+    void preparse_new_expression();
+    void preparse_class_expression(bool expect_class_name);
+    void preparse_property_key();
+    bool try_preparse_arrow_function_expression(bool expect_parens);
+    bool try_preparse_new_target_expression();
 
     Associativity operator_associativity(TokenType) const;
     bool match_expression() const;
@@ -225,5 +295,16 @@ private:
     FlyString m_filename;
     Vector<ParserState> m_saved_state;
     HashMap<Position, TokenMemoization, PositionKeyTraits> m_token_memoizations;
+
+    bool m_lazy_function_parsing_enabled { false };
+    // The source that function bodies skipped by this parser are parsed from later.
+    // Our lexer starts at m_lazy_function_source_offset into it.
+    String m_lazy_function_source;
+    String m_lazy_function_filename;
+    size_t m_lazy_function_source_offset { 0 };
+    // What pre-parsing found out about the functions nested in the body we're parsing, if any.
+    RefPtr<PreparseData> m_preparse_data;
+    // What the pre-parse that's currently running found out so far.
+    RefPtr<PreparseData> m_recorded_preparse_data;
 };
 }
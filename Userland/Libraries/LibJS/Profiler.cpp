@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonArraySerializer.h>
+#include <AK/JsonObjectSerializer.h>
+#include <AK/QuickSort.h>
+#include <AK/StringBuilder.h>
+#include <LibJS/AST.h>
+#include <LibJS/Profiler.h>
+#include <LibJS/Runtime/ScriptFunction.h>
+#include <LibJS/Runtime/VM.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace JS {
+
+static u64 current_time_in_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<u64>(ts.tv_sec) * 1'000'000'000 + ts.tv_nsec;
+}
+
+Profiler::Profiler(VM& vm, u32 sample_interval_in_ms)
+    : m_vm(vm)
+    , m_sample_interval_in_ms(max(sample_interval_in_ms, 1u))
+{
+}
+
+Profiler::~Profiler()
+{
+    stop();
+}
+
+void Profiler::start()
+{
+    if (m_running)
+        return;
+    m_running = true;
+    m_start_timestamp_in_ms = current_time_in_ns() / 1'000'000;
+    m_has_sampler_thread = pthread_create(&m_sampler_thread, nullptr, sampler_thread_entry, this) == 0;
+    if (!m_has_sampler_thread)
+        dbgln("Profiler: Failed to create sampler thread, only function statistics will be recorded");
+}
+
+void Profiler::stop()
+{
+    if (!m_running)
+        return;
+    m_running = false;
+    if (m_has_sampler_thread)
+        pthread_join(m_sampler_thread, nullptr);
+    m_has_sampler_thread = false;
+    m_sample_requested = false;
+
+    // Functions that are still running (e.g. when stopping from inside a nested event loop)
+    // are accounted for up to this point.
+    while (!m_activations.is_empty())
+        did_exit_function_at(current_time_in_ns());
+}
+
+void* Profiler::sampler_thread_entry(void* argument)
+{
+    auto& profiler = *static_cast<Profiler*>(argument);
+    while (profiler.m_running) {
+        usleep(profiler.m_sample_interval_in_ms * 1000);
+        profiler.m_sample_requested = true;
+    }
+    return nullptr;
+}
+
+u32 Profiler::intern_symbol(const String& symbol)
+{
+    if (auto it = m_symbol_ids.find(symbol); it != m_symbol_ids.end())
+        return it->value;
+    u32 id = m_symbols.size();
+    m_symbols.append(symbol);
+    m_symbol_ids.set(symbol, id);
+    return id;
+}
+
+String Profiler::name_for_function(const ScriptFunction& function) const
+{
+    auto& position = function.body().source_range().start;
+    auto& name = function.name();
+    return String::formatted("{} ({}:{})", name.is_empty() ? "(anonymous)" : name, position.line, position.column);
+}
+
+Profiler::FunctionStatistics& Profiler::statistics_for(const ScriptFunction& function)
+{
+    auto* body = &function.body();
+    if (auto it = m_function_statistics.find(body); it != m_function_statistics.end())
+        return *it->value;
+    auto statistics = make<FunctionStatistics>();
+    statistics->body = body;
+    statistics->name = name_for_function(function);
+    auto& result = *statistics;
+    m_function_statistics.set(body, move(statistics));
+    return result;
+}
+
+void Profiler::take_sample()
+{
+    m_sample_requested = false;
+
+    Sample sample;
+    sample.timestamp_in_ms = current_time_in_ns() / 1'000'000;
+    auto& call_stack = m_vm.call_stack();
+    sample.stack.ensure_capacity(call_stack.size());
+
+    // Innermost frame first, like the kernel's stack traces.
+    for (ssize_t i = call_stack.size() - 1; i >= 0; --i) {
+        auto& call_frame = *call_stack[i];
+        auto& callee = call_frame.callee;
+        if (callee.is_object() && is<ScriptFunction>(callee.as_object())) {
+            sample.stack.append(intern_symbol(statistics_for(static_cast<const ScriptFunction&>(callee.as_object())).name));
+        } else if (callee.is_object()) {
+            sample.stack.append(intern_symbol(String::formatted("{} (native)", call_frame.function_name)));
+        } else {
+            static const String global_symbol = "(global)";
+            sample.stack.append(intern_symbol(global_symbol));
+        }
+    }
+
+    if (!sample.stack.is_empty())
+        m_samples.append(move(sample));
+}
+
+void Profiler::did_enter_function(const ScriptFunction& function)
+{
+    if (!m_running)
+        return;
+    auto& statistics = statistics_for(function);
+    ++statistics.call_count;
+    ++statistics.active_count;
+    m_activations.append({ &statistics, current_time_in_ns(), 0 });
+    did_reach_safepoint();
+}
+
+void Profiler::did_exit_function(const ScriptFunction& function)
+{
+    if (m_activations.is_empty())
+        return;
+    // A profiler started while this function was already running has no activation for it.
+    if (m_activations.last().statistics != m_function_statistics.get(&function.body()).value_or(nullptr))
+        return;
+    did_exit_function_at(current_time_in_ns());
+}
+
+void Profiler::did_exit_function_at(u64 now_in_ns)
+{
+    auto activation = m_activations.take_last();
+    auto elapsed = now_in_ns - activation.start_time_in_ns;
+    auto& statistics = *activation.statistics;
+    statistics.self_time_in_ns += elapsed - min(elapsed, activation.time_in_callees_in_ns);
+    // Only the outermost activation of a recursive function counts towards its total time,
+    // otherwise the time spent in the inner activations would be counted more than once.
+    if (--statistics.active_count == 0)
+        statistics.total_time_in_ns += elapsed;
+    if (!m_activations.is_empty())
+        m_activations.last().time_in_callees_in_ns += elapsed;
+}
+
+String Profiler::to_perfcore_json() const
+{
+    StringBuilder builder;
+    JsonObjectSerializer object(builder);
+    auto events = object.add_array("events");
+
+    auto pid = getpid();
+    {
+        auto event = events.add_object();
+        event.add("type", "process_create");
+        event.add("pid", pid);
+        event.add("tid", pid);
+        event.add("parent_pid", 0);
+        event.add("timestamp", m_start_timestamp_in_ms);
+        event.add("executable", "JavaScript");
+    }
+
+    for (auto& sample : m_samples) {
+        auto event = events.add_object();
+        event.add("type", "sample");
+        event.add("pid", pid);
+        event.add("tid", pid);
+        event.add("timestamp", sample.timestamp_in_ms);
+        auto stack = event.add_array("stack");
+        for (auto symbol_id : sample.stack)
+            stack.add(m_symbols[symbol_id]);
+    }
+
+    events.finish();
+    object.finish();
+    return builder.to_string();
+}
+
+String Profiler::to_statistics_table() const
+{
+    Vector<const FunctionStatistics*> statistics;
+    statistics.ensure_capacity(m_function_statistics.size());
+    for (auto& it : m_function_statistics)
+        statistics.append(it.value.ptr());
+    quick_sort(statistics, [](auto* a, auto* b) { return a->self_time_in_ns > b->self_time_in_ns; });
+
+    StringBuilder builder;
+    builder.appendff("{:>10} {:>12} {:>12}  {}\n", "Calls", "Self (ms)", "Total (ms)", "Function");
+    for (auto* entry : statistics) {
+        builder.appendff("{:>10} {:>12.3} {:>12.3}  {}\n",
+            entry->call_count,
+            entry->self_time_in_ns / 1'000'000.0,
+            entry->total_time_in_ns / 1'000'000.0,
+            entry->name);
+    }
+    return builder.to_string();
+}
+
+}
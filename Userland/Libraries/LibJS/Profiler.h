@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/HashMap.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/RefPtr.h>
+#include <AK/String.h>
+#include <AK/Vector.h>
+#include <LibJS/Forward.h>
+#include <pthread.h>
+
+namespace JS {
+
+// The profiler has two parts:
+// - A sampler: a timer thread periodically asks the VM for a sample, which is taken at
+//   the next safepoint (statement boundaries and function entries) by walking the call stack.
+//   The samples can be written out in the perfcore format understood by the Profiler app.
+// - Exact per-function statistics: every ScriptFunction activation is counted and timed.
+class Profiler {
+    AK_MAKE_NONCOPYABLE(Profiler);
+    AK_MAKE_NONMOVABLE(Profiler);
+
+public:
+    explicit Profiler(VM&, u32 sample_interval_in_ms = 1);
+    ~Profiler();
+
+    void start();
+    void stop();
+    bool is_running() const { return m_running; }
+
+    ALWAYS_INLINE void did_reach_safepoint()
+    {
+        if (m_sample_requested.load(AK::MemoryOrder::memory_order_relaxed))
+            take_sample();
+    }
+
+    void did_enter_function(const ScriptFunction&);
+    void did_exit_function(const ScriptFunction&);
+
+    size_t sample_count() const { return m_samples.size(); }
+
+    String to_perfcore_json() const;
+    String to_statistics_table() const;
+
+    template<typename Callback>
+    void for_each_function_statistics(Callback callback) const
+    {
+        for (auto& it : m_function_statistics)
+            callback(it.value->name, it.value->call_count);
+    }
+
+private:
+    struct Sample {
+        u64 timestamp_in_ms { 0 };
+        Vector<u32> stack;
+    };
+
+    struct FunctionStatistics {
+        // Keeps the body (which is also the key) alive, so its address can't be reused by another function's body.
+        RefPtr<const Statement> body;
+        String name;
+        u64 call_count { 0 };
+        u64 total_time_in_ns { 0 };
+        u64 self_time_in_ns { 0 };
+        u32 active_count { 0 };
+    };
+
+    struct Activation {
+        FunctionStatistics* statistics { nullptr };
+        u64 start_time_in_ns { 0 };
+        u64 time_in_callees_in_ns { 0 };
+    };
+
+    static void* sampler_thread_entry(void*);
+    void take_sample();
+    void did_exit_function_at(u64 now_in_ns);
+    u32 intern_symbol(const String&);
+    String name_for_function(const ScriptFunction&) const;
+    FunctionStatistics& statistics_for(const ScriptFunction&);
+
+    VM& m_vm;
+    u32 m_sample_interval_in_ms { 1 };
+    pthread_t m_sampler_thread {};
+    bool m_has_sampler_thread { false };
+    Atomic<bool> m_running { false };
+    Atomic<bool> m_sample_requested { false };
+
+    u64 m_start_timestamp_in_ms { 0 };
+    Vector<Sample> m_samples;
+    Vector<String> m_symbols;
+    HashMap<String, u32> m_symbol_ids;
+
+    // Keyed by function body, so that all closures created from the same code share an entry.
+    HashMap<const Statement*, NonnullOwnPtr<FunctionStatistics>> m_function_statistics;
+    Vector<Activation> m_activations;
+};
+
+}
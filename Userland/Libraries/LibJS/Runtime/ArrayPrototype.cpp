@@ -88,6 +88,53 @@ static Function* callback_from_args(GlobalObject& global_object, const String& n
     return &callback.as_function();
 }
 
+// Packed number storage has no holes and no accessors, so its elements can be read directly.
+static const SimpleIndexedPropertyStorage* packed_number_storage(const Object& object)
+{
+    if (!object.is_array() || !object.indexed_properties().is_simple_storage())
+        return nullptr;
+    auto& storage = object.indexed_properties().simple_storage();
+    if (!storage.is_packed())
+        return nullptr;
+    return &storage;
+}
+
+// Reads an element straight from an ordinary Array's simple storage when it's there, which saves
+// the PropertyName conversion and own-property lookup of Object::get(). Anything unusual (holes,
+// accessors, generic storage, non-Array receivers) takes the regular path.
+ALWAYS_INLINE static Value get_element(Object& object, size_t index)
+{
+    if (object.is_array() && object.indexed_properties().is_simple_storage()) {
+        auto& storage = object.indexed_properties().simple_storage();
+        if (index < storage.array_like_size()) {
+            auto value = storage.value_at(index);
+            if (!value.is_empty() && !value.is_accessor())
+                return value;
+        }
+    }
+    return object.get(index);
+}
+
+template<typename Callback>
+static i32 find_in_packed_number_storage(const SimpleIndexedPropertyStorage& storage, i32 from_index, i32 length, Callback matches)
+{
+    auto end = min((size_t)length, storage.array_like_size());
+    if (storage.elements_kind() == SimpleIndexedPropertyStorage::ElementsKind::PackedInt32) {
+        auto& elements = storage.int32_elements();
+        for (size_t i = from_index; i < end; ++i) {
+            if (matches((double)elements[i]))
+                return i;
+        }
+    } else {
+        auto& elements = storage.double_elements();
+        for (size_t i = from_index; i < end; ++i) {
+            if (matches(elements[i]))
+                return i;
+        }
+    }
+    return -1;
+}
+
 static void for_each_item(VM& vm, GlobalObject& global_object, const String& name, AK::Function<IterationDecision(size_t index, Value value, Value callback_result)> callback, bool skip_empty = true)
 {
     auto* this_object = vm.this_value(global_object).to_object(global_object);
@@ -105,7 +152,7 @@ static void for_each_item(VM& vm, GlobalObject& global_object, const String& nam
     auto this_value = vm.argument(1);
 
     for (size_t i = 0; i < initial_length; ++i) {
-        auto value = this_object->get(i);
+        auto value = get_element(*this_object, i);
         if (vm.exception())
             return;
         if (value.is_empty()) {
@@ -155,7 +202,8 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::map)
     for_each_item(vm, global_object, "map", [&](auto index, auto, auto callback_result) {
         if (vm.exception())
             return IterationDecision::Break;
-        new_array->define_property(index, callback_result);
+        // new_array is an ordinary Array we just created, so we can store into it directly.
+        new_array->indexed_properties().put(new_array, index, callback_result);
         return IterationDecision::Continue;
     });
     return Value(new_array);
@@ -330,7 +378,7 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::join)
     for (size_t i = 0; i < length; ++i) {
         if (i > 0)
             builder.append(separator);
-        auto value = this_object->get(i).value_or(js_undefined());
+        auto value = get_element(*this_object, i).value_or(js_undefined());
         if (vm.exception())
             return {};
         if (value.is_nullish())
@@ -407,7 +455,7 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::slice)
     }
 
     for (ssize_t i = start_slice; i < end_slice; ++i) {
-        new_array->indexed_properties().append(array->get(i));
+        new_array->indexed_properties().append(get_element(*array, i));
         if (vm.exception())
             return {};
     }
@@ -436,8 +484,16 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::index_of)
             from_index = max(length + from_index, 0);
     }
     auto search_element = vm.argument(0);
+    if (auto* storage = packed_number_storage(*this_object)) {
+        if (!search_element.is_number())
+            return Value(-1);
+        auto number_to_find = search_element.as_double();
+        return Value(find_in_packed_number_storage(*storage, from_index, length, [&](double element) {
+            return element == number_to_find;
+        }));
+    }
     for (i32 i = from_index; i < length; ++i) {
-        auto element = this_object->get(i);
+        auto element = get_element(*this_object, i);
         if (vm.exception())
             return {};
         if (strict_eq(element, search_element))
@@ -576,111 +632,137 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::reverse)
     return array;
 }
 
-static void array_merge_sort(VM& vm, GlobalObject& global_object, Function* compare_func, MarkedValueList& arr_to_sort)
+// Stable merge sort over a permutation of indices. Short runs are sorted with binary insertion,
+// then merged bottom-up. A merge is skipped entirely when its two runs are already in order, so
+// (nearly) sorted input only needs a linear number of comparisons.
+template<typename IsGreater>
+static void merge_sort_indices(VM& vm, Vector<size_t>& indices, IsGreater is_greater)
 {
-    // FIXME: it would probably be better to switch to insertion sort for small arrays for
-    // better performance
-    if (arr_to_sort.size() <= 1)
-        return;
-
-    MarkedValueList left(vm.heap());
-    MarkedValueList right(vm.heap());
-
-    left.ensure_capacity(arr_to_sort.size() / 2);
-    right.ensure_capacity(arr_to_sort.size() / 2 + (arr_to_sort.size() & 1));
-
-    for (size_t i = 0; i < arr_to_sort.size(); ++i) {
-        if (i < arr_to_sort.size() / 2) {
-            left.append(arr_to_sort[i]);
-        } else {
-            right.append(arr_to_sort[i]);
+    constexpr size_t insertion_sort_run_length = 8;
+    auto size = indices.size();
+
+    for (size_t run_start = 0; run_start < size; run_start += insertion_sort_run_length) {
+        auto run_end = min(run_start + insertion_sort_run_length, size);
+        for (size_t i = run_start + 1; i < run_end; ++i) {
+            auto item = indices[i];
+            // Insert after any equal elements to keep the sort stable.
+            size_t low = run_start;
+            size_t high = i;
+            while (low < high) {
+                auto middle = low + (high - low) / 2;
+                bool middle_is_greater = is_greater(indices[middle], item);
+                if (vm.exception())
+                    return;
+                if (middle_is_greater)
+                    high = middle;
+                else
+                    low = middle + 1;
+            }
+            for (size_t j = i; j > low; --j)
+                indices[j] = indices[j - 1];
+            indices[low] = item;
         }
     }
 
-    array_merge_sort(vm, global_object, compare_func, left);
-    if (vm.exception())
-        return;
-    array_merge_sort(vm, global_object, compare_func, right);
-    if (vm.exception())
-        return;
-
-    arr_to_sort.clear();
-
-    size_t left_index = 0, right_index = 0;
+    Vector<size_t> scratch;
+    scratch.resize(size);
+    for (size_t width = insertion_sort_run_length; width < size; width *= 2) {
+        for (size_t left = 0; left + width < size; left += 2 * width) {
+            auto middle = left + width;
+            auto right = min(left + 2 * width, size);
 
-    while (left_index < left.size() && right_index < right.size()) {
-        auto x = left[left_index];
-        auto y = right[right_index];
-
-        double comparison_result;
-
-        if (x.is_undefined() && y.is_undefined()) {
-            comparison_result = 0;
-        } else if (x.is_undefined()) {
-            comparison_result = 1;
-        } else if (y.is_undefined()) {
-            comparison_result = -1;
-        } else if (compare_func) {
-            auto call_result = vm.call(*compare_func, js_undefined(), left[left_index], right[right_index]);
+            bool needs_merge = is_greater(indices[middle - 1], indices[middle]);
             if (vm.exception())
                 return;
+            if (!needs_merge)
+                continue;
 
-            if (call_result.is_nan()) {
-                comparison_result = 0;
-            } else {
-                comparison_result = call_result.to_double(global_object);
+            size_t i = left;
+            size_t j = middle;
+            size_t k = left;
+            while (i < middle && j < right) {
+                bool take_right = is_greater(indices[i], indices[j]);
                 if (vm.exception())
                     return;
+                scratch[k++] = take_right ? indices[j++] : indices[i++];
             }
-        } else {
-            // FIXME: It would probably be much better to be smarter about this and implement
-            // the Abstract Relational Comparison in line once iterating over code points, rather
-            // than calling it twice after creating two primitive strings.
-
-            auto x_string = x.to_primitive_string(global_object);
-            if (vm.exception())
-                return;
-            auto y_string = y.to_primitive_string(global_object);
-            if (vm.exception())
-                return;
-
-            auto x_string_value = Value(x_string);
-            auto y_string_value = Value(y_string);
+            while (i < middle)
+                scratch[k++] = indices[i++];
+            while (j < right)
+                scratch[k++] = indices[j++];
+            for (k = left; k < right; ++k)
+                indices[k] = scratch[k];
+        }
+    }
+}
 
-            // Because they are called with primitive strings, these abstract_relation calls
-            // should never result in a VM exception.
-            auto x_lt_y_relation = abstract_relation(global_object, true, x_string_value, y_string_value);
-            VERIFY(x_lt_y_relation != TriState::Unknown);
-            auto y_lt_x_relation = abstract_relation(global_object, true, y_string_value, x_string_value);
-            VERIFY(y_lt_x_relation != TriState::Unknown);
+// Sorts values (which must not contain undefined) according to SortCompare.
+static void array_merge_sort(VM& vm, GlobalObject& global_object, Function* compare_func, MarkedValueList& values_to_sort)
+{
+    if (values_to_sort.size() <= 1)
+        return;
 
-            if (x_lt_y_relation == TriState::True) {
-                comparison_result = -1;
-            } else if (y_lt_x_relation == TriState::True) {
-                comparison_result = 1;
-            } else {
-                comparison_result = 0;
+    Vector<size_t> indices;
+    indices.ensure_capacity(values_to_sort.size());
+    for (size_t i = 0; i < values_to_sort.size(); ++i)
+        indices.unchecked_append(i);
+
+    if (compare_func) {
+        merge_sort_indices(vm, indices, [&](size_t x_index, size_t y_index) {
+            auto call_result = vm.call(*compare_func, js_undefined(), values_to_sort[x_index], values_to_sort[y_index]);
+            if (vm.exception() || call_result.is_nan())
+                return false;
+            auto comparison_result = call_result.to_double(global_object);
+            if (vm.exception())
+                return false;
+            return comparison_result > 0;
+        });
+    } else {
+        // Converting primitives (other than symbols) to strings can't have side effects,
+        // so we can do it once per element instead of twice per comparison.
+        bool can_precompute_strings = true;
+        for (auto& value : values_to_sort) {
+            if (value.is_object() || value.is_symbol()) {
+                can_precompute_strings = false;
+                break;
             }
         }
 
-        if (comparison_result <= 0) {
-            arr_to_sort.append(left[left_index]);
-            left_index++;
+        if (can_precompute_strings) {
+            Vector<String> strings;
+            strings.ensure_capacity(values_to_sort.size());
+            for (auto& value : values_to_sort)
+                strings.unchecked_append(value.to_string(global_object));
+            // NOTE: Comparing UTF-8 bytes orders strings by code point, just like abstract_relation().
+            merge_sort_indices(vm, indices, [&](size_t x_index, size_t y_index) {
+                return StringView(strings[y_index]) < StringView(strings[x_index]);
+            });
         } else {
-            arr_to_sort.append(right[right_index]);
-            right_index++;
+            merge_sort_indices(vm, indices, [&](size_t x_index, size_t y_index) {
+                auto* x_string = values_to_sort[x_index].to_primitive_string(global_object);
+                if (vm.exception())
+                    return false;
+                auto* y_string = values_to_sort[y_index].to_primitive_string(global_object);
+                if (vm.exception())
+                    return false;
+                // Because it is called with primitive strings, this abstract_relation call
+                // should never result in a VM exception.
+                auto y_lt_x_relation = abstract_relation(global_object, true, Value(y_string), Value(x_string));
+                VERIFY(y_lt_x_relation != TriState::Unknown);
+                return y_lt_x_relation == TriState::True;
+            });
         }
     }
+    if (vm.exception())
+        return;
 
-    while (left_index < left.size()) {
-        arr_to_sort.append(left[left_index]);
-        left_index++;
-    }
-
-    while (right_index < right.size()) {
-        arr_to_sort.append(right[right_index]);
-        right_index++;
-    }
+    // NOTE: Every value stays reachable through values_to_sort while we shuffle them around.
+    Vector<Value> sorted_values;
+    sorted_values.ensure_capacity(values_to_sort.size());
+    for (auto index : indices)
+        sorted_values.unchecked_append(values_to_sort[index]);
+    for (size_t i = 0; i < sorted_values.size(); ++i)
+        values_to_sort[i] = sorted_values[i];
 }
 
 JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::sort)
@@ -700,21 +782,23 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::sort)
         return {};
 
     MarkedValueList values_to_sort(vm.heap());
+    size_t undefined_count = 0;
 
     for (size_t i = 0; i < original_length; ++i) {
-        auto element_val = array->get(i);
+        auto element_val = get_element(*array, i);
         if (vm.exception())
             return {};
 
-        if (!element_val.is_empty())
-            values_to_sort.append(element_val);
+        if (element_val.is_empty())
+            continue;
+        // undefined always sorts after every other value, regardless of the compare function.
+        if (element_val.is_undefined()) {
+            ++undefined_count;
+            continue;
+        }
+        values_to_sort.append(element_val);
     }
 
-    // Perform sorting by merge sort. This isn't as efficient compared to quick sort, but
-    // quicksort can't be used in all cases because the spec requires Array.prototype.sort()
-    // to be stable. FIXME: when initially scanning through the array, maintain a flag
-    // for if an unstable sort would be indistinguishable from a stable sort (such as just
-    // just strings or numbers), and in that case use quick sort instead for better performance.
     array_merge_sort(vm, global_object, callback.is_undefined() ? nullptr : &callback.as_function(), values_to_sort);
     if (vm.exception())
         return {};
@@ -725,10 +809,16 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::sort)
             return {};
     }
 
+    auto sorted_count = values_to_sort.size() + undefined_count;
+    for (size_t i = values_to_sort.size(); i < sorted_count; ++i) {
+        array->put(i, js_undefined());
+        if (vm.exception())
+            return {};
+    }
+
     // The empty parts of the array are always sorted to the end, regardless of the
-    // compare function. FIXME: For performance, a similar process could be used
-    // for undefined, which are sorted to right before the empty values.
-    for (size_t i = values_to_sort.size(); i < original_length; ++i) {
+    // compare function.
+    for (size_t i = sorted_count; i < original_length; ++i) {
         array->delete_property(i);
         if (vm.exception())
             return {};
@@ -789,8 +879,17 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::includes)
             from_index = max(length + from_index, 0);
     }
     auto value_to_find = vm.argument(0);
+    if (auto* storage = packed_number_storage(*this_object)) {
+        if (!value_to_find.is_number())
+            return Value(false);
+        auto number_to_find = value_to_find.as_double();
+        bool looking_for_nan = __builtin_isnan(number_to_find);
+        return Value(find_in_packed_number_storage(*storage, from_index, length, [&](double element) {
+            return looking_for_nan ? __builtin_isnan(element) : element == number_to_find;
+        }) != -1);
+    }
     for (i32 i = from_index; i < length; ++i) {
-        auto element = this_object->get(i).value_or(js_undefined());
+        auto element = get_element(*this_object, i).value_or(js_undefined());
         if (vm.exception())
             return {};
         if (same_value_zero(element, value_to_find))
@@ -23,9 +23,6 @@ public:
     virtual void initialize(GlobalObject&) { }
     virtual ~Cell() { }
 
-    bool is_marked() const { return m_mark; }
-    void set_marked(bool b) { m_mark = b; }
-
     bool is_live() const { return m_live; }
     void set_live(bool b) { m_live = b; }
 
@@ -50,7 +47,6 @@ protected:
     Cell() { }
 
 private:
-    bool m_mark { false };
     bool m_live { true };
 };
 
@@ -13,13 +13,28 @@ namespace JS {
 const u32 SPARSE_ARRAY_HOLE_THRESHOLD = 200;
 
 SimpleIndexedPropertyStorage::SimpleIndexedPropertyStorage(Vector<Value>&& initial_values)
-    : m_array_size(initial_values.size())
+    : m_elements_kind(ElementsKind::Values)
+    , m_array_size(initial_values.size())
     , m_packed_elements(move(initial_values))
 {
 }
 
+bool SimpleIndexedPropertyStorage::is_packed() const
+{
+    return m_elements_kind != ElementsKind::Values;
+}
+
+size_t SimpleIndexedPropertyStorage::size() const
+{
+    if (is_packed())
+        return m_array_size;
+    return m_packed_elements.size();
+}
+
 bool SimpleIndexedPropertyStorage::has_index(u32 index) const
 {
+    if (is_packed())
+        return index < m_array_size;
     return index < m_array_size && !m_packed_elements[index].is_empty();
 }
 
@@ -27,7 +42,52 @@ Optional<ValueAndAttributes> SimpleIndexedPropertyStorage::get(u32 index) const
 {
     if (index >= m_array_size)
         return {};
-    return ValueAndAttributes { m_packed_elements[index], default_attributes };
+    return ValueAndAttributes { value_at(index), default_attributes };
+}
+
+bool SimpleIndexedPropertyStorage::can_store_without_transition(Value value) const
+{
+    switch (m_elements_kind) {
+    case ElementsKind::PackedInt32:
+        return value.type() == Value::Type::Int32;
+    case ElementsKind::PackedDouble:
+        return value.is_number();
+    case ElementsKind::Values:
+        return true;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+void SimpleIndexedPropertyStorage::transition_to_fit(Value value)
+{
+    if (can_store_without_transition(value))
+        return;
+    if (m_elements_kind == ElementsKind::PackedInt32 && value.is_number())
+        transition_to_double_elements();
+    else
+        transition_to_value_elements();
+}
+
+void SimpleIndexedPropertyStorage::transition_to_double_elements()
+{
+    VERIFY(m_elements_kind == ElementsKind::PackedInt32);
+    m_double_elements.ensure_capacity(m_int32_elements.size());
+    for (auto element : m_int32_elements)
+        m_double_elements.unchecked_append(element);
+    m_int32_elements.clear();
+    m_elements_kind = ElementsKind::PackedDouble;
+}
+
+void SimpleIndexedPropertyStorage::transition_to_value_elements()
+{
+    if (m_elements_kind == ElementsKind::Values)
+        return;
+    m_packed_elements.ensure_capacity(m_array_size);
+    for (size_t i = 0; i < m_array_size; ++i)
+        m_packed_elements.unchecked_append(value_at(i));
+    m_int32_elements.clear();
+    m_double_elements.clear();
+    m_elements_kind = ElementsKind::Values;
 }
 
 void SimpleIndexedPropertyStorage::grow_storage_if_needed()
@@ -42,48 +102,123 @@ void SimpleIndexedPropertyStorage::put(u32 index, Value value, PropertyAttribute
 {
     VERIFY(attributes == default_attributes);
 
-    if (index >= m_array_size) {
-        m_array_size = index + 1;
-        grow_storage_if_needed();
+    // Writing past the end would leave holes, which packed storage can't represent.
+    if (index > m_array_size)
+        transition_to_value_elements();
+    transition_to_fit(value);
+
+    switch (m_elements_kind) {
+    case ElementsKind::PackedInt32:
+        if (index == m_array_size) {
+            m_int32_elements.append(value.as_i32());
+            ++m_array_size;
+        } else {
+            m_int32_elements[index] = value.as_i32();
+        }
+        return;
+    case ElementsKind::PackedDouble:
+        if (index == m_array_size) {
+            m_double_elements.append(value.as_double());
+            ++m_array_size;
+        } else {
+            m_double_elements[index] = value.as_double();
+        }
+        return;
+    case ElementsKind::Values:
+        if (index >= m_array_size) {
+            m_array_size = index + 1;
+            grow_storage_if_needed();
+        }
+        m_packed_elements[index] = value;
+        return;
     }
-    m_packed_elements[index] = value;
+    VERIFY_NOT_REACHED();
 }
 
 void SimpleIndexedPropertyStorage::remove(u32 index)
 {
-    if (index < m_array_size)
-        m_packed_elements[index] = {};
+    if (index >= m_array_size)
+        return;
+    transition_to_value_elements();
+    m_packed_elements[index] = {};
 }
 
 void SimpleIndexedPropertyStorage::insert(u32 index, Value value, PropertyAttributes attributes)
 {
     VERIFY(attributes == default_attributes);
+    if (index > m_array_size)
+        transition_to_value_elements();
+    transition_to_fit(value);
+
     m_array_size++;
-    m_packed_elements.insert(index, value);
+    switch (m_elements_kind) {
+    case ElementsKind::PackedInt32:
+        m_int32_elements.insert(index, value.as_i32());
+        return;
+    case ElementsKind::PackedDouble:
+        m_double_elements.insert(index, value.as_double());
+        return;
+    case ElementsKind::Values:
+        m_packed_elements.insert(index, value);
+        return;
+    }
+    VERIFY_NOT_REACHED();
 }
 
 ValueAndAttributes SimpleIndexedPropertyStorage::take_first()
 {
     m_array_size--;
-    return { m_packed_elements.take_first(), default_attributes };
+    switch (m_elements_kind) {
+    case ElementsKind::PackedInt32:
+        return { Value(m_int32_elements.take_first()), default_attributes };
+    case ElementsKind::PackedDouble:
+        return { Value(m_double_elements.take_first()), default_attributes };
+    case ElementsKind::Values:
+        return { m_packed_elements.take_first(), default_attributes };
+    }
+    VERIFY_NOT_REACHED();
 }
 
 ValueAndAttributes SimpleIndexedPropertyStorage::take_last()
 {
     m_array_size--;
-    auto last_element = m_packed_elements[m_array_size];
-    m_packed_elements[m_array_size] = {};
-    return { last_element, default_attributes };
+    switch (m_elements_kind) {
+    case ElementsKind::PackedInt32:
+        return { Value(m_int32_elements.take_last()), default_attributes };
+    case ElementsKind::PackedDouble:
+        return { Value(m_double_elements.take_last()), default_attributes };
+    case ElementsKind::Values: {
+        auto last_element = m_packed_elements[m_array_size];
+        m_packed_elements[m_array_size] = {};
+        return { last_element, default_attributes };
+    }
+    }
+    VERIFY_NOT_REACHED();
 }
 
 void SimpleIndexedPropertyStorage::set_array_like_size(size_t new_size)
 {
+    if (new_size > m_array_size)
+        transition_to_value_elements();
+
     m_array_size = new_size;
-    m_packed_elements.resize(new_size);
+    switch (m_elements_kind) {
+    case ElementsKind::PackedInt32:
+        m_int32_elements.shrink(new_size);
+        return;
+    case ElementsKind::PackedDouble:
+        m_double_elements.shrink(new_size);
+        return;
+    case ElementsKind::Values:
+        m_packed_elements.resize(new_size);
+        return;
+    }
+    VERIFY_NOT_REACHED();
 }
 
 GenericIndexedPropertyStorage::GenericIndexedPropertyStorage(SimpleIndexedPropertyStorage&& storage)
 {
+    storage.transition_to_value_elements();
     m_array_size = storage.array_like_size();
     for (size_t i = 0; i < storage.m_packed_elements.size(); ++i) {
         m_sparse_elements.set(i, { storage.m_packed_elements[i], default_attributes });
@@ -332,9 +467,14 @@ Vector<u32> IndexedProperties::indices() const
 {
     if (m_storage->is_simple_storage()) {
         const auto& storage = static_cast<const SimpleIndexedPropertyStorage&>(*m_storage);
-        const auto& elements = storage.elements();
         Vector<u32> indices;
         indices.ensure_capacity(storage.array_like_size());
+        if (storage.is_packed()) {
+            for (size_t i = 0; i < storage.array_like_size(); ++i)
+                indices.unchecked_append(i);
+            return indices;
+        }
+        const auto& elements = storage.elements();
         for (size_t i = 0; i < elements.size(); ++i) {
             if (!elements.at(i).is_empty())
                 indices.unchecked_append(i);
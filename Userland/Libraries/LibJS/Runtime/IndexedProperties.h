@@ -43,6 +43,15 @@ public:
 
 class SimpleIndexedPropertyStorage final : public IndexedPropertyStorage {
 public:
+    // Like V8's "elements kinds", dense arrays that only ever held numbers store them unboxed.
+    // Storage transitions PackedInt32 -> PackedDouble -> Values (never back), and switches to
+    // Values as soon as a non-number or a hole would have to be stored.
+    enum class ElementsKind {
+        PackedInt32,
+        PackedDouble,
+        Values,
+    };
+
     SimpleIndexedPropertyStorage() = default;
     explicit SimpleIndexedPropertyStorage(Vector<Value>&& initial_values);
 
@@ -55,19 +64,61 @@ public:
     virtual ValueAndAttributes take_first() override;
     virtual ValueAndAttributes take_last() override;
 
-    virtual size_t size() const override { return m_packed_elements.size(); }
+    virtual size_t size() const override;
     virtual size_t array_like_size() const override { return m_array_size; }
     virtual void set_array_like_size(size_t new_size) override;
 
     virtual bool is_simple_storage() const override { return true; }
+
+    ElementsKind elements_kind() const { return m_elements_kind; }
+    bool is_packed() const;
+
+    // Only valid for the corresponding elements kind.
+    const Vector<i32>& int32_elements() const { return m_int32_elements; }
+    const Vector<double>& double_elements() const { return m_double_elements; }
     const Vector<Value>& elements() const { return m_packed_elements; }
 
+    Value value_at(u32 index) const
+    {
+        switch (m_elements_kind) {
+        case ElementsKind::PackedInt32:
+            return Value(m_int32_elements[index]);
+        case ElementsKind::PackedDouble:
+            return Value(m_double_elements[index]);
+        case ElementsKind::Values:
+            return m_packed_elements[index];
+        }
+        VERIFY_NOT_REACHED();
+    }
+
+    template<typename Callback>
+    void for_each_value(Callback callback) const
+    {
+        if (m_elements_kind == ElementsKind::Values) {
+            for (auto& value : m_packed_elements)
+                callback(value);
+            return;
+        }
+        for (size_t i = 0; i < m_array_size; ++i) {
+            auto value = value_at(i);
+            callback(value);
+        }
+    }
+
 private:
     friend GenericIndexedPropertyStorage;
 
+    bool can_store_without_transition(Value) const;
+    void transition_to_fit(Value);
+    void transition_to_double_elements();
+    void transition_to_value_elements();
+
     void grow_storage_if_needed();
 
+    ElementsKind m_elements_kind { ElementsKind::PackedInt32 };
     size_t m_array_size { 0 };
+    Vector<i32> m_int32_elements;
+    Vector<double> m_double_elements;
     Vector<Value> m_packed_elements;
 };
 
@@ -144,12 +195,26 @@ public:
 
     Vector<u32> indices() const;
 
+    // Packed number elements never need to be visited by the garbage collector.
+    bool may_contain_cells() const
+    {
+        if (!m_storage->is_simple_storage())
+            return true;
+        return static_cast<const SimpleIndexedPropertyStorage&>(*m_storage).elements_kind() == SimpleIndexedPropertyStorage::ElementsKind::Values;
+    }
+
+    bool is_simple_storage() const { return m_storage->is_simple_storage(); }
+    const SimpleIndexedPropertyStorage& simple_storage() const
+    {
+        VERIFY(m_storage->is_simple_storage());
+        return static_cast<const SimpleIndexedPropertyStorage&>(*m_storage);
+    }
+
     template<typename Callback>
     void for_each_value(Callback callback)
     {
         if (m_storage->is_simple_storage()) {
-            for (auto& value : static_cast<SimpleIndexedPropertyStorage&>(*m_storage).elements())
-                callback(value);
+            static_cast<const SimpleIndexedPropertyStorage&>(*m_storage).for_each_value(callback);
         } else {
             for (auto& element : static_cast<const GenericIndexedPropertyStorage&>(*m_storage).sparse_elements())
                 callback(element.value.value);
@@ -4,11 +4,11 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/FloatingPointStringConversions.h>
+#include <AK/FlyString.h>
 #include <AK/Function.h>
-#include <AK/JsonArray.h>
-#include <AK/JsonObject.h>
-#include <AK/JsonParser.h>
 #include <AK/StringBuilder.h>
+#include <LibJS/Heap/DeferGC.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/BigIntObject.h>
 #include <LibJS/Runtime/BooleanObject.h>
@@ -18,6 +18,7 @@
 #include <LibJS/Runtime/NumberObject.h>
 #include <LibJS/Runtime/Object.h>
 #include <LibJS/Runtime/StringObject.h>
+#include <ctype.h>
 
 namespace JS {
 
@@ -106,13 +107,14 @@ String JSONObject::stringify_impl(GlobalObject& global_object, Value value, Valu
     wrapper->define_property(String::empty(), value);
     if (vm.exception())
         return {};
-    auto result = serialize_json_property(global_object, state, String::empty(), wrapper);
+    StringBuilder builder;
+    bool has_result = serialize_json_property(global_object, state, builder, String::empty(), wrapper, value);
     if (vm.exception())
         return {};
-    if (result.is_null())
+    if (!has_result)
         return {};
 
-    return result;
+    return builder.to_string();
 }
 
 JS_DEFINE_NATIVE_FUNCTION(JSONObject::stringify)
@@ -131,27 +133,25 @@ JS_DEFINE_NATIVE_FUNCTION(JSONObject::stringify)
     return js_string(vm, string);
 }
 
-String JSONObject::serialize_json_property(GlobalObject& global_object, StringifyState& state, const PropertyName& key, Object* holder)
+bool JSONObject::serialize_json_property(GlobalObject& global_object, StringifyState& state, StringBuilder& builder, const PropertyName& key, Object* holder, Value value)
 {
+    // NOTE: The caller has already looked up `value` in `holder`, which lets it skip the lookup for plain data properties.
     auto& vm = global_object.vm();
-    auto value = holder->get(key);
-    if (vm.exception())
-        return {};
     if (value.is_object()) {
         auto to_json = value.as_object().get(vm.names.toJSON);
         if (vm.exception())
-            return {};
+            return false;
         if (to_json.is_function()) {
             value = vm.call(to_json.as_function(), value, js_string(vm, key.to_string()));
             if (vm.exception())
-                return {};
+                return false;
         }
     }
 
     if (state.replacer_function) {
         value = vm.call(*state.replacer_function, holder, js_string(vm, key.to_string()), value);
         if (vm.exception())
-            return {};
+            return false;
     }
 
     if (value.is_object()) {
@@ -160,184 +160,192 @@ String JSONObject::serialize_json_property(GlobalObject& global_object, Stringif
             value = value_object.value_of();
     }
 
-    if (value.is_null())
-        return "null";
-    if (value.is_boolean())
-        return value.as_bool() ? "true" : "false";
-    if (value.is_string())
-        return quote_json_string(value.as_string().string());
+    if (value.is_null()) {
+        builder.append("null");
+        return true;
+    }
+    if (value.is_boolean()) {
+        builder.append(value.as_bool() ? "true" : "false");
+        return true;
+    }
+    if (value.is_string()) {
+        serialize_json_string(builder, value.as_string().string());
+        return true;
+    }
     if (value.is_number()) {
         if (value.is_finite_number())
-            return value.to_string(global_object);
-        return "null";
+            builder.append(value.to_string_without_side_effects());
+        else
+            builder.append("null");
+        return true;
     }
     if (value.is_object() && !value.is_function()) {
         if (value.is_array())
-            return serialize_json_array(global_object, state, static_cast<Array&>(value.as_object()));
-        return serialize_json_object(global_object, state, value.as_object());
+            serialize_json_array(global_object, state, builder, static_cast<Array&>(value.as_object()));
+        else
+            serialize_json_object(global_object, state, builder, value.as_object());
+        return true;
     }
     if (value.is_bigint())
         vm.throw_exception<TypeError>(global_object, ErrorType::JsonBigInt);
-    return {};
+    return false;
 }
 
-String JSONObject::serialize_json_object(GlobalObject& global_object, StringifyState& state, Object& object)
+void JSONObject::serialize_json_object(GlobalObject& global_object, StringifyState& state, StringBuilder& builder, Object& object)
 {
     auto& vm = global_object.vm();
     if (state.seen_objects.contains(&object)) {
         vm.throw_exception<TypeError>(global_object, ErrorType::JsonCircular);
-        return {};
+        return;
     }
 
     state.seen_objects.set(&object);
     String previous_indent = state.indent;
     state.indent = String::formatted("{}{}", state.indent, state.gap);
-    Vector<String> property_strings;
+    bool has_properties = false;
+
+    builder.append('{');
 
-    auto process_property = [&](const PropertyName& key) {
+    auto process_property = [&](const PropertyName& key, Value value) {
         if (key.is_symbol())
             return;
-        auto serialized_property_string = serialize_json_property(global_object, state, key, &object);
-        if (vm.exception())
+        // The key is written before we know whether the value is serializable, and taken back out if it isn't.
+        auto length_before_property = builder.length();
+        if (has_properties)
+            builder.append(',');
+        if (!state.gap.is_empty()) {
+            builder.append('\n');
+            builder.append(state.indent);
+        }
+        serialize_json_string(builder, key.to_string());
+        builder.append(':');
+        if (!state.gap.is_empty())
+            builder.append(' ');
+        if (!serialize_json_property(global_object, state, builder, key, &object, value)) {
+            builder.trim(builder.length() - length_before_property);
             return;
-        if (!serialized_property_string.is_null()) {
-            property_strings.append(String::formatted(
-                "{}:{}{}",
-                quote_json_string(key.to_string()),
-                state.gap.is_empty() ? "" : " ",
-                serialized_property_string));
         }
+        has_properties = true;
     };
 
     if (state.property_list.has_value()) {
         auto property_list = state.property_list.value();
         for (auto& property : property_list) {
-            process_property(property);
+            auto value = object.get(property);
             if (vm.exception())
-                return {};
+                return;
+            process_property(property, value);
+            if (vm.exception())
+                return;
         }
     } else {
         for (auto& entry : object.indexed_properties()) {
             auto value_and_attributes = entry.value_and_attributes(&object);
             if (!value_and_attributes.attributes.is_enumerable())
                 continue;
-            process_property(entry.index());
+            auto value = object.get(entry.index());
             if (vm.exception())
-                return {};
+                return;
+            process_property(entry.index(), value);
+            if (vm.exception())
+                return;
         }
-        for (auto& [key, metadata] : object.shape().property_table_ordered()) {
+        auto& shape = object.shape();
+        for (auto& [key, metadata] : shape.property_table_ordered()) {
             if (!metadata.attributes.is_enumerable())
                 continue;
-            process_property(key);
+            // Plain data properties can be read straight from the object's storage, as long as the properties haven't been
+            // changed in the meantime (e.g. by a toJSON method).
+            Value value;
+            if (&object.shape() == &shape && !shape.is_unique())
+                value = object.get_direct(metadata.offset);
+            if (value.is_empty() || value.is_accessor() || value.is_native_property()) {
+                value = object.get(key);
+                if (vm.exception())
+                    return;
+            }
+            process_property(key, value);
             if (vm.exception())
-                return {};
+                return;
         }
     }
-    StringBuilder builder;
-    if (property_strings.is_empty()) {
-        builder.append("{}");
-    } else {
-        bool first = true;
-        builder.append('{');
-        if (state.gap.is_empty()) {
-            for (auto& property_string : property_strings) {
-                if (!first)
-                    builder.append(',');
-                first = false;
-                builder.append(property_string);
-            }
-        } else {
-            builder.append('\n');
-            builder.append(state.indent);
-            auto separator = String::formatted(",\n{}", state.indent);
-            for (auto& property_string : property_strings) {
-                if (!first)
-                    builder.append(separator);
-                first = false;
-                builder.append(property_string);
-            }
-            builder.append('\n');
-            builder.append(previous_indent);
-        }
-        builder.append('}');
+
+    if (has_properties && !state.gap.is_empty()) {
+        builder.append('\n');
+        builder.append(previous_indent);
     }
+    builder.append('}');
 
     state.seen_objects.remove(&object);
     state.indent = previous_indent;
-    return builder.to_string();
 }
 
-String JSONObject::serialize_json_array(GlobalObject& global_object, StringifyState& state, Object& object)
+void JSONObject::serialize_json_array(GlobalObject& global_object, StringifyState& state, StringBuilder& builder, Object& object)
 {
     auto& vm = global_object.vm();
     if (state.seen_objects.contains(&object)) {
         vm.throw_exception<TypeError>(global_object, ErrorType::JsonCircular);
-        return {};
+        return;
     }
 
     state.seen_objects.set(&object);
     String previous_indent = state.indent;
     state.indent = String::formatted("{}{}", state.indent, state.gap);
-    Vector<String> property_strings;
 
     auto length = length_of_array_like(global_object, object);
     if (vm.exception())
-        return {};
+        return;
+
+    builder.append('[');
     for (size_t i = 0; i < length; ++i) {
-        if (vm.exception())
-            return {};
-        auto serialized_property_string = serialize_json_property(global_object, state, i, &object);
-        if (vm.exception())
-            return {};
-        if (serialized_property_string.is_null()) {
-            property_strings.append("null");
-        } else {
-            property_strings.append(serialized_property_string);
+        if (i > 0)
+            builder.append(',');
+        if (!state.gap.is_empty()) {
+            builder.append('\n');
+            builder.append(state.indent);
         }
-    }
 
-    StringBuilder builder;
-    if (property_strings.is_empty()) {
-        builder.append("[]");
-    } else {
-        if (state.gap.is_empty()) {
-            builder.append('[');
-            bool first = true;
-            for (auto& property_string : property_strings) {
-                if (!first)
-                    builder.append(',');
-                first = false;
-                builder.append(property_string);
-            }
-            builder.append(']');
-        } else {
-            builder.append("[\n");
-            builder.append(state.indent);
-            auto separator = String::formatted(",\n{}", state.indent);
-            bool first = true;
-            for (auto& property_string : property_strings) {
-                if (!first)
-                    builder.append(separator);
-                first = false;
-                builder.append(property_string);
-            }
-            builder.append('\n');
-            builder.append(previous_indent);
-            builder.append(']');
+        // Elements of arrays without holes or accessors don't need a full property lookup.
+        Value value;
+        if (is<Array>(object)) {
+            auto element = object.indexed_properties().get(&object, i, false);
+            if (element.has_value() && !element->value.is_accessor())
+                value = element->value;
         }
+        if (value.is_empty()) {
+            value = object.get(i);
+            if (vm.exception())
+                return;
+        }
+
+        if (!serialize_json_property(global_object, state, builder, i, &object, value)) {
+            if (vm.exception())
+                return;
+            builder.append("null");
+        }
+    }
+    if (length > 0 && !state.gap.is_empty()) {
+        builder.append('\n');
+        builder.append(previous_indent);
     }
+    builder.append(']');
 
     state.seen_objects.remove(&object);
     state.indent = previous_indent;
-    return builder.to_string();
 }
 
-String JSONObject::quote_json_string(String string)
+void JSONObject::serialize_json_string(StringBuilder& builder, const StringView& string)
 {
     // FIXME: Handle UTF16
-    StringBuilder builder;
     builder.append('"');
-    for (auto& ch : string) {
+    // Runs of characters that don't need escaping are appended all at once.
+    size_t run_start = 0;
+    for (size_t i = 0; i < string.length(); ++i) {
+        u8 ch = string[i];
+        if (ch >= 0x20 && ch != '"' && ch != '\\')
+            continue;
+        builder.append(string.substring_view(run_start, i - run_start));
+        run_start = i + 1;
         switch (ch) {
         case '\b':
             builder.append("\\b");
@@ -361,15 +369,16 @@ String JSONObject::quote_json_string(String string)
             builder.append("\\\\");
             break;
         default:
-            if (ch < 0x20) {
-                builder.appendff("\\u{:04x}", ch);
-            } else {
-                builder.append(ch);
-            }
+            builder.appendff("\\u{:04x}", ch);
         }
     }
+    builder.append(string.substring_view(run_start));
     builder.append('"');
-    return builder.to_string();
+}
+
+static void skip_json_whitespace(GenericLexer& lexer)
+{
+    lexer.ignore_while([](char ch) { return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r'; });
 }
 
 JS_DEFINE_NATIVE_FUNCTION(JSONObject::parse)
@@ -381,12 +390,19 @@ JS_DEFINE_NATIVE_FUNCTION(JSONObject::parse)
         return {};
     auto reviver = vm.argument(1);
 
-    auto json = JsonValue::from_string(string);
-    if (!json.has_value()) {
+    GenericLexer lexer(string);
+    Value result;
+    {
+        // Until we're done, parsed values may only be referenced from our own vectors, where the GC can't see them.
+        DeferGC defer_gc(vm.heap());
+        skip_json_whitespace(lexer);
+        result = parse_json_value(global_object, lexer);
+        skip_json_whitespace(lexer);
+    }
+    if (result.is_empty() || !lexer.is_eof()) {
         vm.throw_exception<SyntaxError>(global_object, ErrorType::JsonMalformed);
         return {};
     }
-    Value result = parse_json_value(global_object, json.value());
     if (reviver.is_function()) {
         auto* holder_object = Object::create_empty(global_object);
         holder_object->define_property(String::empty(), result);
@@ -397,44 +413,263 @@ JS_DEFINE_NATIVE_FUNCTION(JSONObject::parse)
     return result;
 }
 
-Value JSONObject::parse_json_value(GlobalObject& global_object, const JsonValue& value)
+// The parse helpers return an empty value (or a null string) on syntax errors.
+Value JSONObject::parse_json_value(GlobalObject& global_object, GenericLexer& lexer)
 {
-    if (value.is_object())
-        return Value(parse_json_object(global_object, value.as_object()));
-    if (value.is_array())
-        return Value(parse_json_array(global_object, value.as_array()));
-    if (value.is_null())
-        return js_null();
-    if (value.is_double())
-        return Value(value.as_double());
-    if (value.is_number())
-        return Value(value.to_i32(0));
-    if (value.is_string())
-        return js_string(global_object.heap(), value.to_string());
-    if (value.is_bool())
-        return Value(static_cast<bool>(value.as_bool()));
-    VERIFY_NOT_REACHED();
+    switch (lexer.peek()) {
+    case '{':
+        return parse_json_object(global_object, lexer);
+    case '[':
+        return parse_json_array(global_object, lexer);
+    case '"': {
+        auto string = parse_json_string(lexer);
+        if (string.is_null())
+            return {};
+        return js_string(global_object.heap(), move(string));
+    }
+    case 't':
+        if (lexer.consume_specific("true"))
+            return Value(true);
+        return {};
+    case 'f':
+        if (lexer.consume_specific("false"))
+            return Value(false);
+        return {};
+    case 'n':
+        if (lexer.consume_specific("null"))
+            return js_null();
+        return {};
+    default:
+        return parse_json_number(lexer);
+    }
 }
 
-Object* JSONObject::parse_json_object(GlobalObject& global_object, const JsonObject& json_object)
+Value JSONObject::parse_json_object(GlobalObject& global_object, GenericLexer& lexer)
 {
-    auto* object = Object::create_empty(global_object);
-    json_object.for_each_member([&](auto& key, auto& value) {
-        object->define_property(key, parse_json_value(global_object, value));
-    });
+    struct Member {
+        FlyString key;
+        Value value;
+    };
+    Vector<Member, 16> members;
+    bool has_index_keys = false;
+
+    lexer.consume();
+    skip_json_whitespace(lexer);
+    if (!lexer.consume_specific('}')) {
+        while (true) {
+            if (!lexer.next_is('"'))
+                return {};
+            auto key = parse_json_string(lexer);
+            if (key.is_null())
+                return {};
+            skip_json_whitespace(lexer);
+            if (!lexer.consume_specific(':'))
+                return {};
+            skip_json_whitespace(lexer);
+            auto value = parse_json_value(global_object, lexer);
+            if (value.is_empty())
+                return {};
+            // Keys like "0" become indexed properties, see Object::define_property().
+            if (!has_index_keys && key.to_int().value_or(-1) >= 0)
+                has_index_keys = true;
+            members.append({ move(key), value });
+
+            skip_json_whitespace(lexer);
+            if (lexer.consume_specific('}'))
+                break;
+            if (!lexer.consume_specific(','))
+                return {};
+            skip_json_whitespace(lexer);
+        }
+    }
+
+    // Objects with the same keys in the same order end up with the same shape, so we can go straight to it through
+    // the transition chain and fill in the storage directly. Objects that Object::put_own_property() wouldn't give
+    // a shared shape take the slow path.
+    if (has_index_keys || members.size() > 100) {
+        auto* object = Object::create_empty(global_object);
+        for (auto& member : members)
+            object->define_property(member.key, member.value);
+        return object;
+    }
+
+    // Later duplicates of a key overwrite the value, but keep the position of the first one. The slow path gets
+    // that from define_property(), and there are few enough members here for a quadratic search to be cheap.
+    for (size_t i = 1; i < members.size(); ++i) {
+        for (size_t j = 0; j < i; ++j) {
+            if (members[j].key == members[i].key) {
+                members[j].value = members[i].value;
+                members.remove(i--);
+                break;
+            }
+        }
+    }
+
+    auto* shape = global_object.new_object_shape();
+    for (auto& member : members)
+        shape = shape->create_put_transition(member.key, default_attributes);
+    auto* object = global_object.heap().allocate<Object>(global_object, *shape);
+    for (size_t i = 0; i < members.size(); ++i)
+        object->put_direct(i, members[i].value);
     return object;
 }
 
-Array* JSONObject::parse_json_array(GlobalObject& global_object, const JsonArray& json_array)
+Value JSONObject::parse_json_array(GlobalObject& global_object, GenericLexer& lexer)
 {
+    Vector<Value> elements;
+
+    lexer.consume();
+    skip_json_whitespace(lexer);
+    if (!lexer.consume_specific(']')) {
+        while (true) {
+            auto value = parse_json_value(global_object, lexer);
+            if (value.is_empty())
+                return {};
+            elements.append(value);
+
+            skip_json_whitespace(lexer);
+            if (lexer.consume_specific(']'))
+                break;
+            if (!lexer.consume_specific(','))
+                return {};
+            skip_json_whitespace(lexer);
+        }
+    }
+
     auto* array = Array::create(global_object);
-    size_t index = 0;
-    json_array.for_each([&](auto& value) {
-        array->define_property(index++, parse_json_value(global_object, value));
-    });
+    array->set_indexed_property_elements(move(elements));
     return array;
 }
 
+Value JSONObject::parse_json_number(GenericLexer& lexer)
+{
+    // -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+    auto remaining = lexer.remaining();
+    auto start = lexer.tell();
+    bool is_negative = lexer.consume_specific('-');
+    if (!lexer.consume_specific('0')) {
+        if (lexer.consume_while(isdigit).is_empty())
+            return {};
+    }
+    bool is_integer = true;
+    if (lexer.consume_specific('.')) {
+        is_integer = false;
+        if (lexer.consume_while(isdigit).is_empty())
+            return {};
+    }
+    if (lexer.consume_specific('e') || lexer.consume_specific('E')) {
+        is_integer = false;
+        if (!lexer.consume_specific('+'))
+            lexer.consume_specific('-');
+        if (lexer.consume_while(isdigit).is_empty())
+            return {};
+    }
+
+    auto number_string = remaining.substring_view(0, lexer.tell() - start);
+    // Most numbers in JSON are small integers, which don't need the general conversion.
+    if (is_integer && number_string.length() <= 10) {
+        auto value = number_string.to_int();
+        if (value.has_value() && !(is_negative && value.value() == 0))
+            return Value(value.value());
+    }
+
+    auto* characters = number_string.characters_without_null_termination();
+    auto value = parse_floating_point_completely(characters, characters + number_string.length());
+    VERIFY(value.has_value());
+    return Value(value.value());
+}
+
+String JSONObject::parse_json_string(GenericLexer& lexer)
+{
+    lexer.consume();
+
+    // Strings without escapes can be copied as a whole.
+    auto plain_characters = lexer.consume_while([](char ch) { return ch != '"' && ch != '\\' && static_cast<u8>(ch) >= 0x20; });
+    if (lexer.consume_specific('"'))
+        return plain_characters.is_empty() ? String::empty() : String(plain_characters);
+
+    auto consume_code_unit = [&]() -> Optional<u32> {
+        u32 code_unit = 0;
+        for (size_t i = 0; i < 4; ++i) {
+            char ch = lexer.peek();
+            if (!isxdigit(ch))
+                return {};
+            lexer.consume();
+            code_unit = (code_unit << 4) | (isdigit(ch) ? ch - '0' : (ch | 0x20) - 'a' + 10);
+        }
+        return code_unit;
+    };
+
+    StringBuilder builder;
+    builder.append(plain_characters);
+    while (true) {
+        if (lexer.is_eof())
+            return {};
+        char ch = lexer.consume();
+        if (ch == '"')
+            break;
+        if (static_cast<u8>(ch) < 0x20)
+            return {};
+        if (ch != '\\') {
+            builder.append(ch);
+            continue;
+        }
+        if (lexer.is_eof())
+            return {};
+        switch (lexer.consume()) {
+        case '"':
+            builder.append('"');
+            break;
+        case '\\':
+            builder.append('\\');
+            break;
+        case '/':
+            builder.append('/');
+            break;
+        case 'b':
+            builder.append('\b');
+            break;
+        case 'f':
+            builder.append('\f');
+            break;
+        case 'n':
+            builder.append('\n');
+            break;
+        case 'r':
+            builder.append('\r');
+            break;
+        case 't':
+            builder.append('\t');
+            break;
+        case 'u': {
+            auto code_unit = consume_code_unit();
+            if (!code_unit.has_value())
+                return {};
+            u32 code_point = code_unit.value();
+            if (code_point >= 0xd800 && code_point <= 0xdbff && lexer.next_is("\\u")) {
+                // Combine surrogate pairs, but leave lone surrogates as they are.
+                auto position = lexer.tell();
+                lexer.ignore(2);
+                auto low_surrogate = consume_code_unit();
+                if (!low_surrogate.has_value())
+                    return {};
+                if (low_surrogate.value() >= 0xdc00 && low_surrogate.value() <= 0xdfff) {
+                    code_point = 0x10000 + ((code_point - 0xd800) << 10) + (low_surrogate.value() - 0xdc00);
+                } else {
+                    while (lexer.tell() > position)
+                        lexer.retreat();
+                }
+            }
+            builder.append_code_point(code_point);
+            break;
+        }
+        default:
+            return {};
+        }
+    }
+    return builder.to_string();
+}
+
 Value JSONObject::internalize_json_property(GlobalObject& global_object, Object* holder, const PropertyName& name, Function& reviver)
 {
     auto& vm = global_object.vm();
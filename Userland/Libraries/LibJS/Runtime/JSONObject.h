@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/GenericLexer.h>
 #include <LibJS/Runtime/Object.h>
 
 namespace JS {
@@ -32,15 +33,17 @@ private:
     };
 
     // Stringify helpers
-    static String serialize_json_property(GlobalObject&, StringifyState&, const PropertyName& key, Object* holder);
-    static String serialize_json_object(GlobalObject&, StringifyState&, Object&);
-    static String serialize_json_array(GlobalObject&, StringifyState&, Object&);
-    static String quote_json_string(String);
+    static bool serialize_json_property(GlobalObject&, StringifyState&, StringBuilder&, const PropertyName& key, Object* holder, Value);
+    static void serialize_json_object(GlobalObject&, StringifyState&, StringBuilder&, Object&);
+    static void serialize_json_array(GlobalObject&, StringifyState&, StringBuilder&, Object&);
+    static void serialize_json_string(StringBuilder&, const StringView&);
 
     // Parse helpers
-    static Object* parse_json_object(GlobalObject&, const JsonObject&);
-    static Array* parse_json_array(GlobalObject&, const JsonArray&);
-    static Value parse_json_value(GlobalObject&, const JsonValue&);
+    static Value parse_json_value(GlobalObject&, GenericLexer&);
+    static Value parse_json_object(GlobalObject&, GenericLexer&);
+    static Value parse_json_array(GlobalObject&, GenericLexer&);
+    static Value parse_json_number(GenericLexer&);
+    static String parse_json_string(GenericLexer&);
     static Value internalize_json_property(GlobalObject&, Object* holder, const PropertyName& name, Function& reviver);
 
     JS_DECLARE_NATIVE_FUNCTION(stringify);
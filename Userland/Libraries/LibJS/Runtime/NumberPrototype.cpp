@@ -75,6 +75,10 @@ JS_DEFINE_NATIVE_FUNCTION(NumberPrototype::to_string)
     if (number_value.is_positive_zero() || number_value.is_negative_zero())
         return js_string(vm, "0");
 
+    // Base 10 uses the shortest representation that round-trips, just like ToString does.
+    if (radix == 10)
+        return js_string(vm, number_value.to_string_without_side_effects());
+
     double number = number_value.as_double();
     bool negative = number < 0;
     if (negative)
@@ -942,9 +942,11 @@ void Object::visit_edges(Cell::Visitor& visitor)
     for (auto& value : m_storage)
         visitor.visit(value);
 
-    m_indexed_properties.for_each_value([&visitor](auto& value) {
-        visitor.visit(value);
-    });
+    if (m_indexed_properties.may_contain_cells()) {
+        m_indexed_properties.for_each_value([&visitor](auto& value) {
+            visitor.visit(value);
+        });
+    }
 }
 
 bool Object::has_property(const PropertyName& property_name) const
@@ -82,6 +82,35 @@ static Flags options_from(const String& flags, VM& vm, GlobalObject& global_obje
     return options;
 }
 
+NonnullRefPtr<CompiledRegExp> CompiledRegExp::create(VM& vm, const String& pattern, const String& flags, regex::RegexOptions<ECMAScriptFlags> options)
+{
+    // The flags have been validated at this point, so they can't contain a slash.
+    auto key = String::formatted("{}/{}", flags, pattern);
+    auto& cache = vm.compiled_regexp_cache();
+    if (auto it = cache.find(key); it != cache.end())
+        return it->value;
+
+    auto compiled_regexp = adopt_ref(*new CompiledRegExp(pattern, options));
+    // Patterns with syntax errors throw, so there's no point in keeping them around.
+    if (compiled_regexp->regex().parser_result.error != regex::Error::NoError)
+        return compiled_regexp;
+
+    if (cache.size() >= VM::compiled_regexp_cache_size) {
+        // Evict everything that isn't used by any RegExp object. If all of them are, the cache simply keeps growing,
+        // as those are alive anyway.
+        Vector<String> unused_keys;
+        for (auto& entry : cache) {
+            if (entry.value->ref_count() == 1)
+                unused_keys.append(entry.key);
+        }
+        for (auto& unused_key : unused_keys)
+            cache.remove(unused_key);
+    }
+
+    cache.set(move(key), compiled_regexp);
+    return compiled_regexp;
+}
+
 RegExpObject* RegExpObject::create(GlobalObject& global_object, String pattern, String flags)
 {
     return global_object.heap().allocate<RegExpObject>(global_object, pattern, flags, *global_object.regexp_prototype());
@@ -92,10 +121,13 @@ RegExpObject::RegExpObject(String pattern, String flags, Object& prototype)
     , m_pattern(pattern)
     , m_flags(flags)
     , m_active_flags(options_from(m_flags, this->vm(), this->global_object()))
-    , m_regex(pattern, m_active_flags.effective_flags)
 {
-    if (m_regex.parser_result.error != regex::Error::NoError) {
-        vm().throw_exception<SyntaxError>(global_object(), ErrorType::RegExpCompileError, m_regex.error_string());
+    if (vm().exception())
+        return;
+
+    m_compiled_regexp = CompiledRegExp::create(vm(), m_pattern, m_flags, m_active_flags.effective_flags);
+    if (regex().parser_result.error != regex::Error::NoError) {
+        vm().throw_exception<SyntaxError>(global_object(), ErrorType::RegExpCompileError, regex().error_string());
     }
 }
 
@@ -104,13 +136,39 @@ void RegExpObject::initialize(GlobalObject& global_object)
     auto& vm = this->vm();
     Object::initialize(global_object);
 
-    define_native_property(vm.names.lastIndex, last_index, set_last_index, Attribute::Writable);
+    define_native_property(vm.names.lastIndex, last_index_getter, last_index_setter, Attribute::Writable);
 }
 
 RegExpObject::~RegExpObject()
 {
 }
 
+RegexResult RegExpObject::match(const StringView& subject)
+{
+    auto& regex = this->regex();
+    // The compiled regex is shared, so its start offset has to be set up for every match.
+    if (!regex.options().has_flag_set((ECMAScriptFlags)regex::AllFlags::Internal_Stateful)) {
+        regex.start_offset = 0;
+        return regex.match(subject);
+    }
+
+    if (m_last_index > subject.length()) {
+        m_last_index = 0;
+        return {};
+    }
+
+    regex.start_offset = m_last_index;
+    auto result = regex.match(subject);
+    if (!result.success) {
+        m_last_index = 0;
+        return result;
+    }
+
+    auto& match = result.matches[0];
+    m_last_index = match.global_offset + match.view.length();
+    return result;
+}
+
 static RegExpObject* regexp_object_from(VM& vm, GlobalObject& global_object)
 {
     auto* this_object = vm.this_value(global_object).to_object(global_object);
@@ -123,16 +181,16 @@ static RegExpObject* regexp_object_from(VM& vm, GlobalObject& global_object)
     return static_cast<RegExpObject*>(this_object);
 }
 
-JS_DEFINE_NATIVE_GETTER(RegExpObject::last_index)
+JS_DEFINE_NATIVE_GETTER(RegExpObject::last_index_getter)
 {
     auto regexp_object = regexp_object_from(vm, global_object);
     if (!regexp_object)
         return {};
 
-    return Value((unsigned)regexp_object->regex().start_offset);
+    return Value((unsigned)regexp_object->last_index());
 }
 
-JS_DEFINE_NATIVE_SETTER(RegExpObject::set_last_index)
+JS_DEFINE_NATIVE_SETTER(RegExpObject::last_index_setter)
 {
     auto regexp_object = regexp_object_from(vm, global_object);
     if (!regexp_object)
@@ -145,7 +203,7 @@ JS_DEFINE_NATIVE_SETTER(RegExpObject::set_last_index)
     if (index < 0)
         index = 0;
 
-    regexp_object->regex().start_offset = index;
+    regexp_object->set_last_index(index);
 }
 
 RegExpObject* regexp_create(GlobalObject& global_object, Value pattern, Value flags)
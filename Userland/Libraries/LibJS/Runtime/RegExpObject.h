@@ -17,6 +17,23 @@ struct Flags {
 
 namespace JS {
 
+// Compiled regexes are never modified after parsing, so all RegExp objects with the same source and flags share one.
+// NOTE: Regex::start_offset is per-match state, which each RegExpObject keeps as its own lastIndex instead.
+class CompiledRegExp : public RefCounted<CompiledRegExp> {
+public:
+    static NonnullRefPtr<CompiledRegExp> create(VM&, const String& pattern, const String& flags, regex::RegexOptions<ECMAScriptFlags>);
+
+    const Regex<ECMA262>& regex() const { return m_regex; }
+
+private:
+    CompiledRegExp(const String& pattern, regex::RegexOptions<ECMAScriptFlags> options)
+        : m_regex(pattern, options)
+    {
+    }
+
+    Regex<ECMA262> m_regex;
+};
+
 RegExpObject* regexp_create(GlobalObject&, Value pattern, Value flags);
 
 class RegExpObject : public Object {
@@ -32,17 +49,23 @@ public:
     const String& pattern() const { return m_pattern; }
     const String& flags() const { return m_flags; }
     const regex::RegexOptions<ECMAScriptFlags>& declared_options() { return m_active_flags.declared_flags; }
-    const Regex<ECMA262>& regex() { return m_regex; }
-    const Regex<ECMA262>& regex() const { return m_regex; }
+    const Regex<ECMA262>& regex() const { return m_compiled_regexp->regex(); }
+
+    size_t last_index() const { return m_last_index; }
+    void set_last_index(size_t last_index) { m_last_index = last_index; }
+
+    // Matches like RegExpBuiltinExec: "global" and "sticky" regexes start at (and update) lastIndex, others start at 0.
+    RegexResult match(const StringView& subject);
 
 private:
-    JS_DECLARE_NATIVE_GETTER(last_index);
-    JS_DECLARE_NATIVE_SETTER(set_last_index);
+    JS_DECLARE_NATIVE_GETTER(last_index_getter);
+    JS_DECLARE_NATIVE_SETTER(last_index_setter);
 
     String m_pattern;
     String m_flags;
     Flags m_active_flags;
-    Regex<ECMA262> m_regex;
+    RefPtr<CompiledRegExp> m_compiled_regexp;
+    size_t m_last_index { 0 };
 };
 
 }
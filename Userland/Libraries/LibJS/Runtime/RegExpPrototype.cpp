@@ -8,6 +8,7 @@
 #include <AK/Function.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/Error.h>
+#include <LibJS/Runtime/Function.h>
 #include <LibJS/Runtime/GlobalObject.h>
 #include <LibJS/Runtime/RegExpObject.h>
 #include <LibJS/Runtime/RegExpPrototype.h>
@@ -28,6 +29,7 @@ void RegExpPrototype::initialize(GlobalObject& global_object)
     define_native_function(vm.names.toString, to_string, 0, attr);
     define_native_function(vm.names.test, test, 1, attr);
     define_native_function(vm.names.exec, exec, 1, attr);
+    m_builtin_exec = &get_without_side_effects(vm.names.exec).as_function();
 
     define_native_function(vm.well_known_symbol_match(), symbol_match, 1, attr);
     define_native_function(vm.well_known_symbol_replace(), symbol_replace, 2, attr);
@@ -46,6 +48,22 @@ RegExpPrototype::~RegExpPrototype()
 {
 }
 
+void RegExpPrototype::visit_edges(Cell::Visitor& visitor)
+{
+    Object::visit_edges(visitor);
+    visitor.visit(m_builtin_exec);
+}
+
+// If the "exec" method of a RegExp object is the builtin one, we can match without creating result arrays.
+static RegExpObject* regexp_object_with_builtin_exec(GlobalObject& global_object, Object& rx, Function& exec)
+{
+    if (!is<RegExpObject>(rx))
+        return nullptr;
+    if (&exec != static_cast<RegExpPrototype*>(global_object.regexp_prototype())->builtin_exec())
+        return nullptr;
+    return static_cast<RegExpObject*>(&rx);
+}
+
 static Object* this_object_from(VM& vm, GlobalObject& global_object)
 {
     auto this_value = vm.this_value(global_object);
@@ -131,16 +149,6 @@ JS_DEFINE_NATIVE_GETTER(RegExpPrototype::source)
     return js_string(vm, escape_regexp_pattern(*regexp_object));
 }
 
-RegexResult RegExpPrototype::do_match(const Regex<ECMA262>& re, const StringView& subject)
-{
-    auto result = re.match(subject);
-    // The 'lastIndex' property is reset on failing tests (if 'global')
-    if (!result.success && re.options().has_flag_set(ECMAScriptFlags::Global))
-        re.start_offset = 0;
-
-    return result;
-}
-
 JS_DEFINE_NATIVE_FUNCTION(RegExpPrototype::exec)
 {
     // FIXME: This should try using dynamic properties for 'lastIndex',
@@ -153,13 +161,7 @@ JS_DEFINE_NATIVE_FUNCTION(RegExpPrototype::exec)
     if (vm.exception())
         return {};
 
-    StringView str_to_match = str;
-
-    // RegExps without "global" and "sticky" always start at offset 0.
-    if (!regexp_object->regex().options().has_flag_set((ECMAScriptFlags)regex::AllFlags::Internal_Stateful))
-        regexp_object->regex().start_offset = 0;
-
-    auto result = do_match(regexp_object->regex(), str_to_match);
+    auto result = regexp_object->match(str);
     if (!result.success)
         return js_null();
 
@@ -205,11 +207,7 @@ JS_DEFINE_NATIVE_FUNCTION(RegExpPrototype::test)
     if (vm.exception())
         return {};
 
-    // RegExps without "global" and "sticky" always start at offset 0.
-    if (!regexp_object->regex().options().has_flag_set((ECMAScriptFlags)regex::AllFlags::Internal_Stateful))
-        regexp_object->regex().start_offset = 0;
-
-    auto result = do_match(regexp_object->regex(), str);
+    auto result = regexp_object->match(str);
     return Value(result.success);
 }
 
@@ -257,8 +255,61 @@ JS_DEFINE_NATIVE_FUNCTION(RegExpPrototype::symbol_match)
     if (!global)
         return vm.call(*exec, rx, js_string(vm, s));
 
-    // FIXME: This should exec the RegExp repeatedly while updating "lastIndex"
-    return vm.call(*exec, rx, js_string(vm, s));
+    rx->put(vm.names.lastIndex, Value(0));
+    if (vm.exception())
+        return {};
+
+    auto* array = Array::create(global_object);
+
+    if (auto* regexp_object = regexp_object_with_builtin_exec(global_object, *rx, *exec)) {
+        // Each match continues where the previous one ended, and only the matched strings are needed.
+        while (true) {
+            auto result = regexp_object->match(s);
+            if (!result.success)
+                break;
+            auto& match = result.matches[0];
+            array->indexed_properties().append(js_string(vm, match.view.to_string()));
+            // FIXME: Implement AdvanceStringIndex to take Unicode code points into account - https://tc39.es/ecma262/#sec-advancestringindex
+            if (match.view.length() == 0)
+                regexp_object->set_last_index(regexp_object->last_index() + 1);
+        }
+    } else {
+        while (true) {
+            auto result = vm.call(*exec, rx, js_string(vm, s));
+            if (vm.exception())
+                return {};
+            if (result.is_null())
+                break;
+
+            auto* result_object = result.to_object(global_object);
+            if (!result_object)
+                return {};
+            auto match_object = result_object->get(0).value_or(js_undefined());
+            if (vm.exception())
+                return {};
+            auto match_str = match_object.to_string(global_object);
+            if (vm.exception())
+                return {};
+            array->indexed_properties().append(js_string(vm, match_str));
+
+            if (match_str.is_empty()) {
+                auto last_index_value = rx->get(vm.names.lastIndex).value_or(js_undefined());
+                if (vm.exception())
+                    return {};
+                auto this_index = last_index_value.to_length(global_object);
+                if (vm.exception())
+                    return {};
+                // FIXME: Implement AdvanceStringIndex to take Unicode code points into account - https://tc39.es/ecma262/#sec-advancestringindex
+                rx->put(vm.names.lastIndex, Value(this_index + 1));
+                if (vm.exception())
+                    return {};
+            }
+        }
+    }
+
+    if (array->indexed_properties().is_empty())
+        return js_null();
+    return array;
 }
 
 JS_DEFINE_NATIVE_FUNCTION(RegExpPrototype::symbol_replace)
@@ -274,142 +325,184 @@ JS_DEFINE_NATIVE_FUNCTION(RegExpPrototype::symbol_replace)
     if (vm.exception())
         return {};
 
+    String replace_string;
+    if (!replace_value.is_function()) {
+        // FIXME: Implement the GetSubstituion algorithm for substituting placeholder '$' characters - https://tc39.es/ecma262/#sec-getsubstitution
+        replace_string = replace_value.to_string(global_object);
+        if (vm.exception())
+            return {};
+    }
+
     auto global_value = rx->get(vm.names.global).value_or(js_undefined());
     if (vm.exception())
         return {};
 
     bool global = global_value.to_boolean();
     if (global)
-        rx->regex().start_offset = 0;
+        rx->set_last_index(0);
 
     // FIXME: Implement and use RegExpExec - https://tc39.es/ecma262/#sec-regexpexec
     auto* exec = get_method(global_object, rx, vm.names.exec);
     if (!exec)
         return {};
 
-    MarkedValueList results(vm.heap());
+    StringBuilder builder;
+    size_t next_source_position = 0;
 
-    while (true) {
-        auto result = vm.call(*exec, rx, string_value);
-        if (vm.exception())
-            return {};
-        if (result.is_null())
-            break;
+    auto append_replacement = [&](double position, const String& matched, MarkedValueList captures, Value named_captures) {
+        position = clamp(position, static_cast<double>(0), static_cast<double>(string.length()));
 
-        auto* result_object = result.to_object(global_object);
-        if (!result_object)
-            return {};
+        String replacement;
+        if (replace_value.is_function()) {
+            MarkedValueList replacer_args(vm.heap());
+            replacer_args.append(js_string(vm, matched));
+            replacer_args.append(move(captures));
+            replacer_args.append(Value(position));
+            replacer_args.append(js_string(vm, string));
+            if (!named_captures.is_undefined()) {
+                replacer_args.append(move(named_captures));
+            }
 
-        results.append(result_object);
-        if (!global)
-            break;
+            auto replace_result = vm.call(replace_value.as_function(), js_undefined(), move(replacer_args));
+            if (vm.exception())
+                return;
 
-        auto match_object = result_object->get(0);
-        if (vm.exception())
-            return {};
+            replacement = replace_result.to_string(global_object);
+            if (vm.exception())
+                return;
+        } else {
+            replacement = replace_string;
+        }
 
-        String match_str = match_object.to_string(global_object);
-        if (vm.exception())
-            return {};
-        if (match_str.is_empty()) {
+        if (position >= next_source_position) {
+            builder.append(string.substring_view(next_source_position, position - next_source_position));
+            builder.append(replacement);
+            next_source_position = position + matched.length();
+        }
+    };
+
+    if (auto* regexp_object = regexp_object_with_builtin_exec(global_object, *rx, *exec)) {
+        // Each match continues where the previous one ended, and we don't need to go through result arrays.
+        Vector<RegexResult> results;
+        while (true) {
+            auto result = regexp_object->match(string);
+            if (!result.success)
+                break;
+            bool is_empty_match = result.matches[0].view.length() == 0;
+            results.append(move(result));
+            if (!global)
+                break;
             // FIXME: Implement AdvanceStringIndex to take Unicode code points into account - https://tc39.es/ecma262/#sec-advancestringindex
-            //        Once implemented, step (8a) of the @@replace algorithm must also be implemented.
-            rx->regex().start_offset += 1;
+            if (is_empty_match)
+                regexp_object->set_last_index(regexp_object->last_index() + 1);
         }
-    }
 
-    String accumulated_result;
-    size_t next_source_position = 0;
+        for (auto& result : results) {
+            auto& match = result.matches[0];
+
+            MarkedValueList captures(vm.heap());
+            Value named_captures = js_undefined();
+            if (replace_value.is_function()) {
+                for (size_t i = 0; i < result.n_capture_groups; ++i) {
+                    auto& capture = result.capture_group_matches[0][i + 1];
+                    captures.append(capture.view.is_null() ? js_undefined() : js_string(vm, capture.view.to_string()));
+                }
+                if (result.n_named_capture_groups > 0) {
+                    auto groups_object = create_empty(global_object);
+                    for (auto& entry : result.named_capture_group_matches[0])
+                        groups_object->define_property(entry.key, js_string(vm, entry.value.view.to_string()));
+                    named_captures = groups_object;
+                }
+            }
 
-    for (auto& result_value : results) {
-        auto& result = result_value.as_object();
-        size_t result_length = length_of_array_like(global_object, result);
-        size_t n_captures = result_length == 0 ? 0 : result_length - 1;
+            append_replacement(match.global_offset, match.view.to_string(), move(captures), named_captures);
+            if (vm.exception())
+                return {};
+        }
+    } else {
+        MarkedValueList results(vm.heap());
 
-        auto matched_value = result.get(0).value_or(js_undefined());
-        if (vm.exception())
-            return {};
+        while (true) {
+            auto result = vm.call(*exec, rx, string_value);
+            if (vm.exception())
+                return {};
+            if (result.is_null())
+                break;
 
-        auto matched = matched_value.to_string(global_object);
-        if (vm.exception())
-            return {};
+            auto* result_object = result.to_object(global_object);
+            if (!result_object)
+                return {};
 
-        auto position_value = result.get(vm.names.index).value_or(js_undefined());
-        if (vm.exception())
-            return {};
+            results.append(result_object);
+            if (!global)
+                break;
 
-        double position = position_value.to_integer_or_infinity(global_object);
-        if (vm.exception())
-            return {};
+            auto match_object = result_object->get(0);
+            if (vm.exception())
+                return {};
 
-        position = clamp(position, static_cast<double>(0), static_cast<double>(string.length()));
+            String match_str = match_object.to_string(global_object);
+            if (vm.exception())
+                return {};
+            if (match_str.is_empty()) {
+                // FIXME: Implement AdvanceStringIndex to take Unicode code points into account - https://tc39.es/ecma262/#sec-advancestringindex
+                //        Once implemented, step (8a) of the @@replace algorithm must also be implemented.
+                rx->set_last_index(rx->last_index() + 1);
+            }
+        }
 
-        MarkedValueList captures(vm.heap());
-        for (size_t n = 1; n <= n_captures; ++n) {
-            auto capture = result.get(n).value_or(js_undefined());
+        for (auto& result_value : results) {
+            auto& result = result_value.as_object();
+            size_t result_length = length_of_array_like(global_object, result);
+            size_t n_captures = result_length == 0 ? 0 : result_length - 1;
+
+            auto matched_value = result.get(0).value_or(js_undefined());
             if (vm.exception())
                 return {};
 
-            if (!capture.is_undefined()) {
-                auto capture_string = capture.to_string(global_object);
-                if (vm.exception())
-                    return {};
+            auto matched = matched_value.to_string(global_object);
+            if (vm.exception())
+                return {};
 
-                capture = Value(js_string(vm, capture_string));
+            auto position_value = result.get(vm.names.index).value_or(js_undefined());
+            if (vm.exception())
+                return {};
+
+            double position = position_value.to_integer_or_infinity(global_object);
+            if (vm.exception())
+                return {};
+
+            MarkedValueList captures(vm.heap());
+            for (size_t n = 1; n <= n_captures; ++n) {
+                auto capture = result.get(n).value_or(js_undefined());
                 if (vm.exception())
                     return {};
-            }
 
-            captures.append(move(capture));
-        }
+                if (!capture.is_undefined()) {
+                    auto capture_string = capture.to_string(global_object);
+                    if (vm.exception())
+                        return {};
 
-        auto named_captures = result.get(vm.names.groups).value_or(js_undefined());
-        if (vm.exception())
-            return {};
-
-        String replacement;
+                    capture = Value(js_string(vm, capture_string));
+                    if (vm.exception())
+                        return {};
+                }
 
-        if (replace_value.is_function()) {
-            MarkedValueList replacer_args(vm.heap());
-            replacer_args.append(js_string(vm, matched));
-            replacer_args.append(move(captures));
-            replacer_args.append(Value(position));
-            replacer_args.append(js_string(vm, string));
-            if (!named_captures.is_undefined()) {
-                replacer_args.append(move(named_captures));
+                captures.append(move(capture));
             }
 
-            auto replace_result = vm.call(replace_value.as_function(), js_undefined(), move(replacer_args));
+            auto named_captures = result.get(vm.names.groups).value_or(js_undefined());
             if (vm.exception())
                 return {};
 
-            replacement = replace_result.to_string(global_object);
-            if (vm.exception())
-                return {};
-        } else {
-            // FIXME: Implement the GetSubstituion algorithm for substituting placeholder '$' characters - https://tc39.es/ecma262/#sec-getsubstitution
-            replacement = replace_value.to_string(global_object);
+            append_replacement(position, matched, move(captures), named_captures);
             if (vm.exception())
                 return {};
         }
-
-        if (position >= next_source_position) {
-            StringBuilder builder;
-            builder.append(accumulated_result);
-            builder.append(string.substring(next_source_position, position - next_source_position));
-            builder.append(replacement);
-
-            accumulated_result = builder.build();
-            next_source_position = position + matched.length();
-        }
     }
 
-    if (next_source_position >= string.length())
-        return js_string(vm, accumulated_result);
-
-    StringBuilder builder;
-    builder.append(accumulated_result);
-    builder.append(string.substring(next_source_position));
+    if (next_source_position < string.length())
+        builder.append(string.substring_view(next_source_position));
 
     return js_string(vm, builder.build());
 }
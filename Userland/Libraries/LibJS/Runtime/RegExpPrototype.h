@@ -18,8 +18,10 @@ public:
     virtual void initialize(GlobalObject&) override;
     virtual ~RegExpPrototype() override;
 
+    Function* builtin_exec() const { return m_builtin_exec; }
+
 private:
-    static RegexResult do_match(const Regex<ECMA262>&, const StringView&);
+    virtual void visit_edges(Visitor&) override;
 
     JS_DECLARE_NATIVE_GETTER(flags);
     JS_DECLARE_NATIVE_GETTER(source);
@@ -34,6 +36,8 @@ private:
     JS_DECLARE_NATIVE_GETTER(flag_name);
     JS_ENUMERATE_REGEXP_FLAGS
 #undef __JS_ENUMERATE
+
+    Function* m_builtin_exec { nullptr };
 };
 
 }
@@ -5,8 +5,10 @@
  */
 
 #include <AK/Function.h>
+#include <AK/ScopeGuard.h>
 #include <LibJS/AST.h>
 #include <LibJS/Interpreter.h>
+#include <LibJS/Profiler.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/Error.h>
 #include <LibJS/Runtime/GlobalObject.h>
@@ -29,13 +31,23 @@ static ScriptFunction* typed_this(VM& vm, GlobalObject& global_object)
 
 ScriptFunction* ScriptFunction::create(GlobalObject& global_object, const FlyString& name, const Statement& body, Vector<FunctionNode::Parameter> parameters, i32 m_function_length, ScopeObject* parent_scope, bool is_strict, bool is_arrow_function)
 {
-    return global_object.heap().allocate<ScriptFunction>(global_object, global_object, name, body, move(parameters), m_function_length, parent_scope, *global_object.function_prototype(), is_strict, is_arrow_function);
+    return global_object.heap().allocate<ScriptFunction>(global_object, global_object, name, body, nullptr, move(parameters), m_function_length, parent_scope, *global_object.function_prototype(), is_strict, is_arrow_function);
 }
 
-ScriptFunction::ScriptFunction(GlobalObject& global_object, const FlyString& name, const Statement& body, Vector<FunctionNode::Parameter> parameters, i32 m_function_length, ScopeObject* parent_scope, Object& prototype, bool is_strict, bool is_arrow_function)
+ScriptFunction* ScriptFunction::create(GlobalObject& global_object, const FunctionNode& function_node, ScopeObject* parent_scope, bool is_strict, bool is_arrow_function)
+{
+    // NOTE: We hold on to a lazy body as-is, so it's only parsed once the function is called.
+    RefPtr<Statement> body;
+    if (!function_node.lazy_body())
+        body = function_node.body();
+    return global_object.heap().allocate<ScriptFunction>(global_object, global_object, function_node.name(), move(body), function_node.lazy_body(), function_node.parameters(), function_node.function_length(), parent_scope, *global_object.function_prototype(), is_strict, is_arrow_function);
+}
+
+ScriptFunction::ScriptFunction(GlobalObject& global_object, const FlyString& name, RefPtr<Statement> body, RefPtr<LazyFunctionBody> lazy_body, Vector<FunctionNode::Parameter> parameters, i32 m_function_length, ScopeObject* parent_scope, Object& prototype, bool is_strict, bool is_arrow_function)
     : Function(prototype, is_arrow_function ? vm().this_value(global_object) : Value(), {})
     , m_name(name)
-    , m_body(body)
+    , m_body(move(body))
+    , m_lazy_body(move(lazy_body))
     , m_parameters(move(parameters))
     , m_parent_scope(parent_scope)
     , m_function_length(m_function_length)
@@ -106,6 +118,13 @@ Value ScriptFunction::execute_function_body()
 
     VM::InterpreterExecutionScope scope(*interpreter);
 
+    if (auto* profiler = vm.profiler())
+        profiler->did_enter_function(*this);
+    ScopeGuard profiler_guard([&] {
+        if (auto* profiler = vm.profiler())
+            profiler->did_exit_function(*this);
+    });
+
     auto& call_frame_args = vm.call_frame().arguments;
     for (size_t i = 0; i < m_parameters.size(); ++i) {
         auto parameter = m_parameters[i];
@@ -127,7 +146,15 @@ Value ScriptFunction::execute_function_body()
         vm.current_scope()->put_to_scope(parameter.name, { argument_value, DeclarationKind::Var });
     }
 
-    return interpreter->execute_statement(global_object(), m_body, ScopeType::Function);
+    return interpreter->execute_statement(global_object(), body(), ScopeType::Function);
+}
+
+bool ScriptFunction::throw_if_body_has_syntax_error()
+{
+    if (!m_lazy_body || m_lazy_body->syntax_error().is_null())
+        return false;
+    vm().throw_exception<SyntaxError>(global_object(), m_lazy_body->syntax_error());
+    return true;
 }
 
 Value ScriptFunction::call()
@@ -136,6 +163,8 @@ Value ScriptFunction::call()
         vm().throw_exception<TypeError>(global_object(), ErrorType::ClassConstructorWithoutNew, m_name);
         return {};
     }
+    if (throw_if_body_has_syntax_error())
+        return {};
     return execute_function_body();
 }
 
@@ -145,6 +174,8 @@ Value ScriptFunction::construct(Function&)
         vm().throw_exception<TypeError>(global_object(), ErrorType::NotAConstructor, m_name);
         return {};
     }
+    if (throw_if_body_has_syntax_error())
+        return {};
     return execute_function_body();
 }
 
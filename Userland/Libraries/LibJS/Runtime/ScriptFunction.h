@@ -16,12 +16,13 @@ class ScriptFunction final : public Function {
 
 public:
     static ScriptFunction* create(GlobalObject&, const FlyString& name, const Statement& body, Vector<FunctionNode::Parameter> parameters, i32 m_function_length, ScopeObject* parent_scope, bool is_strict, bool is_arrow_function = false);
+    static ScriptFunction* create(GlobalObject&, const FunctionNode&, ScopeObject* parent_scope, bool is_strict, bool is_arrow_function = false);
 
-    ScriptFunction(GlobalObject&, const FlyString& name, const Statement& body, Vector<FunctionNode::Parameter> parameters, i32 m_function_length, ScopeObject* parent_scope, Object& prototype, bool is_strict, bool is_arrow_function = false);
+    ScriptFunction(GlobalObject&, const FlyString& name, RefPtr<Statement> body, RefPtr<LazyFunctionBody> lazy_body, Vector<FunctionNode::Parameter> parameters, i32 m_function_length, ScopeObject* parent_scope, Object& prototype, bool is_strict, bool is_arrow_function = false);
     virtual void initialize(GlobalObject&) override;
     virtual ~ScriptFunction();
 
-    const Statement& body() const { return m_body; }
+    const Statement& body() const { return m_lazy_body ? m_lazy_body->statement() : *m_body; }
     const Vector<FunctionNode::Parameter>& parameters() const { return m_parameters; };
 
     virtual Value call() override;
@@ -40,12 +41,14 @@ private:
     virtual void visit_edges(Visitor&) override;
 
     Value execute_function_body();
+    bool throw_if_body_has_syntax_error();
 
     JS_DECLARE_NATIVE_GETTER(length_getter);
     JS_DECLARE_NATIVE_GETTER(name_getter);
 
     FlyString m_name;
-    NonnullRefPtr<Statement> m_body;
+    RefPtr<Statement> m_body;
+    RefPtr<LazyFunctionBody> m_lazy_body;
     const Vector<FunctionNode::Parameter> m_parameters;
     ScopeObject* m_parent_scope { nullptr };
     i32 m_function_length { 0 };
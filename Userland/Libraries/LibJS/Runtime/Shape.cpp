@@ -138,7 +138,9 @@ void Shape::ensure_property_table() const
 
     u32 next_offset = 0;
 
+    // The chain goes from this shape backwards, so it has to start with this shape's own transition.
     Vector<const Shape*, 64> transition_chain;
+    transition_chain.append(this);
     for (auto* shape = m_previous; shape; shape = shape->m_previous) {
         if (shape->m_property_table) {
             *m_property_table = *shape->m_property_table;
@@ -147,7 +149,6 @@ void Shape::ensure_property_table() const
         }
         transition_chain.append(shape);
     }
-    transition_chain.append(this);
 
     for (ssize_t i = transition_chain.size() - 1; i >= 0; --i) {
         auto* shape = transition_chain[i];
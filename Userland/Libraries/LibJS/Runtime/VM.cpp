@@ -9,12 +9,14 @@
 #include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
 #include <LibJS/Interpreter.h>
+#include <LibJS/Profiler.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/Error.h>
 #include <LibJS/Runtime/GlobalObject.h>
 #include <LibJS/Runtime/NativeFunction.h>
 #include <LibJS/Runtime/PromiseReaction.h>
 #include <LibJS/Runtime/Reference.h>
+#include <LibJS/Runtime/RegExpObject.h>
 #include <LibJS/Runtime/ScriptFunction.h>
 #include <LibJS/Runtime/Symbol.h>
 #include <LibJS/Runtime/TemporaryClearException.h>
@@ -47,6 +49,11 @@ VM::~VM()
 {
 }
 
+void VM::set_profiler(OwnPtr<Profiler> profiler)
+{
+    m_profiler = move(profiler);
+}
+
 Interpreter& VM::interpreter()
 {
     VERIFY(!m_interpreters.is_empty());
@@ -83,11 +90,27 @@ VM::InterpreterExecutionScope::~InterpreterExecutionScope()
     m_interpreter.vm().pop_interpreter(m_interpreter);
 }
 
+PrimitiveString& VM::small_integer_string(i32 value)
+{
+    VERIFY(is_small_integer_string_cacheable(value));
+    if (value < 10)
+        return single_ascii_character_string('0' + value);
+    // NOTE: These are created on first use, since most scripts only ever stringify a handful of them.
+    auto*& string = m_small_integer_strings[value];
+    if (!string)
+        string = m_heap.allocate_without_global_object<PrimitiveString>(String::number(value));
+    return *string;
+}
+
 void VM::gather_roots(HashTable<Cell*>& roots)
 {
     roots.set(m_empty_string);
     for (auto* string : m_single_ascii_character_strings)
         roots.set(string);
+    for (auto* string : m_small_integer_strings) {
+        if (string)
+            roots.set(string);
+    }
 
     roots.set(m_scope_object_shape);
     roots.set(m_exception);
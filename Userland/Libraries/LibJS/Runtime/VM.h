@@ -10,6 +10,7 @@
 #include <AK/FlyString.h>
 #include <AK/Function.h>
 #include <AK/HashMap.h>
+#include <AK/OwnPtr.h>
 #include <AK/RefCounted.h>
 #include <AK/StackInfo.h>
 #include <LibJS/Heap/Heap.h>
@@ -92,6 +93,14 @@ public:
         return *m_single_ascii_character_strings[character];
     }
 
+    static constexpr i32 small_integer_string_cache_size = 1024;
+    static bool is_small_integer_string_cacheable(i32 value) { return value >= 0 && value < small_integer_string_cache_size; }
+    PrimitiveString& small_integer_string(i32 value);
+
+    // Keyed by "flags/pattern", see CompiledRegExp::create().
+    static constexpr size_t compiled_regexp_cache_size = 256;
+    HashMap<String, NonnullRefPtr<CompiledRegExp>>& compiled_regexp_cache() { return m_compiled_regexp_cache; }
+
     void push_call_frame(CallFrame& call_frame, GlobalObject& global_object)
     {
         VERIFY(!exception());
@@ -159,6 +168,9 @@ public:
     bool underscore_is_last_value() const { return m_underscore_is_last_value; }
     void set_underscore_is_last_value(bool b) { m_underscore_is_last_value = b; }
 
+    Profiler* profiler() { return m_profiler.ptr(); }
+    void set_profiler(OwnPtr<Profiler>);
+
     void unwind(ScopeType type, FlyString label = {})
     {
         m_unwind_until = type;
@@ -259,6 +271,9 @@ private:
 
     PrimitiveString* m_empty_string { nullptr };
     PrimitiveString* m_single_ascii_character_strings[128] {};
+    PrimitiveString* m_small_integer_strings[small_integer_string_cache_size] {};
+
+    HashMap<String, NonnullRefPtr<CompiledRegExp>> m_compiled_regexp_cache;
 
 #define __JS_ENUMERATE(SymbolName, snake_name) \
     Symbol* m_well_known_symbol_##snake_name { nullptr };
@@ -268,6 +283,8 @@ private:
     Shape* m_scope_object_shape { nullptr };
 
     bool m_underscore_is_last_value { false };
+
+    OwnPtr<Profiler> m_profiler;
 };
 
 template<>
@@ -6,6 +6,7 @@
  */
 
 #include <AK/AllOf.h>
+#include <AK/FloatingPointStringConversions.h>
 #include <AK/FlyString.h>
 #include <AK/String.h>
 #include <AK/StringBuilder.h>
@@ -84,115 +85,39 @@ static String double_to_string(double d)
     if (d == static_cast<double>(INFINITY))
         return "Infinity";
 
-    StringBuilder number_string_builder;
-
-    size_t start_index = 0;
-    size_t end_index = 0;
-    size_t int_part_end = 0;
-
-    // generate integer part (reversed)
-    double int_part;
-    double frac_part;
-    frac_part = modf(d, &int_part);
-    while (int_part > 0) {
-        number_string_builder.append('0' + (int)fmod(int_part, 10));
-        end_index++;
-        int_part = floor(int_part / 10);
-    }
-
-    auto reversed_integer_part = number_string_builder.to_string().reverse();
-    number_string_builder.clear();
-    number_string_builder.append(reversed_integer_part);
-
-    int_part_end = end_index;
-
-    int exponent = 0;
-
-    // generate fractional part
-    while (frac_part > 0) {
-        double old_frac_part = frac_part;
-        frac_part *= 10;
-        frac_part = modf(frac_part, &int_part);
-        if (old_frac_part == frac_part)
-            break;
-        number_string_builder.append('0' + (int)int_part);
-        end_index++;
-        exponent--;
-    }
-
-    auto number_string = number_string_builder.to_string();
-
-    // FIXME: Remove this hack.
-    // FIXME: Instead find the shortest round-trippable representation.
-    // Remove decimals after the 15th position
-    if (end_index > int_part_end + 15) {
-        exponent += end_index - int_part_end - 15;
-        end_index = int_part_end + 15;
-    }
-
-    // remove leading zeroes
-    while (start_index < end_index && number_string[start_index] == '0') {
-        start_index++;
-    }
-
-    // remove trailing zeroes
-    while (end_index > 0 && number_string[end_index - 1] == '0') {
-        end_index--;
-        exponent++;
-    }
-
-    if (end_index <= start_index)
-        return "0";
-
-    auto digits = number_string.substring_view(start_index, end_index - start_index);
-
-    int number_of_digits = end_index - start_index;
-
-    exponent += number_of_digits;
+    // k is the number of digits, and n is where the decimal point goes, so that the value is digits * 10^(n - k).
+    auto decimal = convert_to_shortest_decimal(d);
+    auto digits = String::number(decimal.significand);
+    int k = digits.length();
+    int n = decimal.exponent + k;
 
     StringBuilder builder;
-
-    if (number_of_digits <= exponent && exponent <= 21) {
+    if (k <= n && n <= 21) {
         builder.append(digits);
-        builder.append(String::repeated('0', exponent - number_of_digits));
+        for (int i = 0; i < n - k; ++i)
+            builder.append('0');
         return builder.to_string();
     }
-    if (0 < exponent && exponent <= 21) {
-        builder.append(digits.substring_view(0, exponent));
+    if (0 < n && n <= 21) {
+        builder.append(digits.substring_view(0, n));
         builder.append('.');
-        builder.append(digits.substring_view(exponent));
+        builder.append(digits.substring_view(n));
         return builder.to_string();
     }
-    if (-6 < exponent && exponent <= 0) {
+    if (-6 < n && n <= 0) {
         builder.append("0.");
-        builder.append(String::repeated('0', -exponent));
+        for (int i = 0; i < -n; ++i)
+            builder.append('0');
         builder.append(digits);
         return builder.to_string();
     }
-    if (number_of_digits == 1) {
-        builder.append(digits);
-        builder.append('e');
-
-        if (exponent - 1 > 0)
-            builder.append('+');
-        else
-            builder.append('-');
-
-        builder.append(String::number(fabs(exponent - 1)));
-        return builder.to_string();
-    }
 
     builder.append(digits[0]);
-    builder.append('.');
-    builder.append(digits.substring_view(1));
-    builder.append('e');
-
-    if (exponent - 1 > 0)
-        builder.append('+');
-    else
-        builder.append('-');
-
-    builder.append(String::number(fabs(exponent - 1)));
+    if (k > 1) {
+        builder.append('.');
+        builder.append(digits.substring_view(1));
+    }
+    builder.appendff("e{}{}", n - 1 > 0 ? '+' : '-', abs(n - 1));
     return builder.to_string();
 }
 
@@ -305,6 +230,8 @@ PrimitiveString* Value::to_primitive_string(GlobalObject& global_object)
 {
     if (is_string())
         return &as_string();
+    if (m_type == Type::Int32 && VM::is_small_integer_string_cacheable(m_value.as_i32))
+        return &global_object.vm().small_integer_string(m_value.as_i32);
     auto string = to_string(global_object);
     if (global_object.vm().exception())
         return nullptr;
@@ -461,6 +388,8 @@ Value Value::to_number(GlobalObject& global_object) const
             return js_infinity();
         if (string == "-Infinity")
             return js_negative_infinity();
+        if (auto parsed_double = parse_floating_point_completely(string.characters(), string.characters() + string.length()); parsed_double.has_value())
+            return Value(parsed_double.value());
         char* endptr;
         auto parsed_double = strtod(string.characters(), &endptr);
         if (*endptr)
@@ -864,16 +793,13 @@ Value add(GlobalObject& global_object, Value lhs, Value rhs)
         return {};
 
     if (lhs_primitive.is_string() || rhs_primitive.is_string()) {
-        auto lhs_string = lhs_primitive.to_string(global_object);
+        auto* lhs_string = lhs_primitive.to_primitive_string(global_object);
         if (vm.exception())
             return {};
-        auto rhs_string = rhs_primitive.to_string(global_object);
+        auto* rhs_string = rhs_primitive.to_primitive_string(global_object);
         if (vm.exception())
             return {};
-        StringBuilder builder(lhs_string.length() + rhs_string.length());
-        builder.append(lhs_string);
-        builder.append(rhs_string);
-        return js_string(vm.heap(), builder.to_string());
+        return js_rope_string(vm, *lhs_string, *rhs_string);
     }
 
     auto lhs_numeric = lhs_primitive.to_numeric(global_object);
@@ -0,0 +1,67 @@
+// Micro-benchmarks for Array.prototype builtins on dense arrays.
+// Run with: js Tests/benchmarks/Array.prototype.js
+
+const ITERATIONS = 10;
+const SIZE = 10000;
+
+function bench(name, setup, callback) {
+    const input = setup();
+    let result;
+    const start = Date.now();
+    for (let i = 0; i < ITERATIONS; ++i) result = callback(input);
+    const elapsed = Date.now() - start;
+    console.log(`${name}: ${elapsed} ms (${elapsed / ITERATIONS} ms/iteration)`);
+    return result;
+}
+
+function makeInt32Array() {
+    const array = [];
+    for (let i = 0; i < SIZE; ++i) array.push((i * 7919) % SIZE);
+    return array;
+}
+
+function makeDoubleArray() {
+    const array = [];
+    for (let i = 0; i < SIZE; ++i) array.push(((i * 7919) % SIZE) + 0.5);
+    return array;
+}
+
+function makeStringArray() {
+    const array = [];
+    for (let i = 0; i < SIZE; ++i) array.push("item" + ((i * 7919) % SIZE));
+    return array;
+}
+
+bench("forEach (int32)", makeInt32Array, array => {
+    let sum = 0;
+    array.forEach(value => {
+        sum += value;
+    });
+    return sum;
+});
+bench("map (int32)", makeInt32Array, array => array.map(value => value * 2));
+bench("filter (int32)", makeInt32Array, array => array.filter(value => value & 1));
+bench("indexOf (int32, miss)", makeInt32Array, array => array.indexOf(-1));
+bench("indexOf (double, miss)", makeDoubleArray, array => array.indexOf(-1));
+bench("indexOf (string, miss)", makeStringArray, array => array.indexOf("miss"));
+bench("includes (int32, miss)", makeInt32Array, array => array.includes(-1));
+bench("join (int32)", makeInt32Array, array => array.join(","));
+bench("join (string)", makeStringArray, array => array.join(","));
+bench("slice (int32)", makeInt32Array, array => array.slice(1));
+bench(
+    "push (int32)",
+    () => null,
+    () => {
+        const array = [];
+        for (let i = 0; i < SIZE; ++i) array.push(i);
+        return array;
+    }
+);
+bench("sort (int32, comparator)", makeInt32Array, array => array.slice().sort((a, b) => a - b));
+bench("sort (int32, sorted, comparator)", makeInt32Array, array =>
+    array
+        .slice()
+        .sort((a, b) => a - b)
+        .sort((a, b) => a - b)
+);
+bench("sort (string, default)", makeStringArray, array => array.slice().sort());
@@ -4,6 +4,8 @@ test("'break' syntax errors", () => {
     expect("{ break }").not.toEval();
     expect("{ break label }").not.toEval();
     expect("label: { break label }").toEval();
+    expect("while (true) { function f() { break } }").not.toEval();
+    expect("while (true) { () => { break } }").not.toEval();
 });
 
 test("'continue' syntax errors", () => {
@@ -14,4 +16,6 @@ test("'continue' syntax errors", () => {
     expect("label: { continue label }").not.toEval();
 
     expect("switch (true) { case true: continue; }").not.toEval();
+    expect("while (true) { function f() { continue } }").not.toEval();
+    expect("while (true) { () => { continue } }").not.toEval();
 });
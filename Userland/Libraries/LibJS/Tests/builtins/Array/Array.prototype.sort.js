@@ -138,6 +138,30 @@ describe("Array.prototype.sort", () => {
         ]);
     });
 
+    test("that it is stable and calls the compare function sparingly on large arrays", () => {
+        var arr = [];
+        for (var i = 0; i < 100; ++i) arr.push({ key: i % 3, index: i });
+        arr.sort((a, b) => a.key - b.key);
+        for (var i = 1; i < arr.length; ++i) {
+            expect(arr[i - 1].key <= arr[i].key).toBeTrue();
+            if (arr[i - 1].key === arr[i].key) expect(arr[i - 1].index < arr[i].index).toBeTrue();
+        }
+
+        var sorted = [];
+        for (var i = 0; i < 100; ++i) sorted.push(i);
+        var calls = 0;
+        sorted.sort((a, b) => {
+            ++calls;
+            return a - b;
+        });
+        expect(calls).toBeLessThan(sorted.length * 2);
+        expect(sorted[0]).toBe(0);
+        expect(sorted[99]).toBe(99);
+
+        var strings = ["b", "a10", "a9", "\u00e9", "z", "a", 10, 9, true, null];
+        expect(strings.sort()).toEqual([10, 9, "a", "a10", "a9", "b", null, true, "z", "\u00e9"]);
+    });
+
     test("that it works on non-arrays", () => {
         var obj = { length: 0 };
         expect(Array.prototype.sort.call(obj)).toBe(obj);
@@ -0,0 +1,62 @@
+describe("arrays of numbers", () => {
+    test("int32 elements", () => {
+        var a = [1, 2, 3];
+        a.push(4);
+        expect(a).toEqual([1, 2, 3, 4]);
+        expect(a.indexOf(3)).toBe(2);
+        expect(a.indexOf("3")).toBe(-1);
+        expect(a.includes(4)).toBeTrue();
+        expect(a.includes(4.5)).toBeFalse();
+        expect(a.pop()).toBe(4);
+        expect(a.shift()).toBe(1);
+        a.unshift(0);
+        expect(a).toEqual([0, 2, 3]);
+    });
+
+    test("transition to double elements", () => {
+        var a = [1, 2, 3];
+        a.push(0.5);
+        a[0] = -0;
+        expect(a).toEqual([-0, 2, 3, 0.5]);
+        expect(Object.is(a[0], -0)).toBeTrue();
+        expect(a.indexOf(0)).toBe(0);
+        expect(a.indexOf(0.5)).toBe(3);
+        expect(a.includes(0)).toBeTrue();
+        a.push(NaN);
+        expect(a.indexOf(NaN)).toBe(-1);
+        expect(a.includes(NaN)).toBeTrue();
+    });
+
+    test("transition to generic elements", () => {
+        var a = [1, 2.5];
+        a.push("foo");
+        expect(a).toEqual([1, 2.5, "foo"]);
+        expect(a.indexOf("foo")).toBe(2);
+
+        var b = [1, 2, 3];
+        b.push({});
+        expect(typeof b[3]).toBe("object");
+        gc();
+        expect(typeof b[3]).toBe("object");
+    });
+
+    test("holes", () => {
+        var a = [1, 2, 3];
+        a[5] = 6;
+        expect(a).toHaveLength(6);
+        expect(4 in a).toBeFalse();
+        expect(a.includes(undefined)).toBeTrue();
+
+        var b = [1, 2, 3];
+        delete b[1];
+        expect(1 in b).toBeFalse();
+        expect(b.indexOf(2)).toBe(-1);
+
+        var c = [1, 2, 3];
+        c.length = 5;
+        expect(c).toHaveLength(5);
+        expect(3 in c).toBeFalse();
+        c.length = 1;
+        expect(c).toEqual([1]);
+    });
+});
@@ -9,6 +9,11 @@ test("basic functionality", () => {
         ['"test"', "test"],
         ['[1,2,"foo"]', [1, 2, "foo"]],
         ['{"foo":1,"bar":"baz"}', { foo: 1, bar: "baz" }],
+        ["-0.5", -0.5],
+        ["0.30000000000000004", 0.1 + 0.2],
+        ["1.5e3", 1500],
+        ["-2E-3", -0.002],
+        ["1e400", Infinity],
     ];
 
     properties.forEach(testCase => {
@@ -16,6 +21,50 @@ test("basic functionality", () => {
     });
 });
 
+test("objects", () => {
+    const object = JSON.parse('{ "b": 1, "a": [true, null, {}], "b": 2, "1": "one", "": "empty" }');
+    expect(Object.keys(object)).toEqual(["1", "b", "a", ""]);
+    expect(object.b).toBe(2);
+    expect(object.a).toEqual([true, null, {}]);
+    expect(object[1]).toBe("one");
+    expect(object[""]).toBe("empty");
+
+    const objects = JSON.parse('[{"x":1,"y":2},{"x":3,"y":4},{"y":5,"x":6}]');
+    expect(objects.map(o => o.x + o.y)).toEqual([3, 7, 11]);
+    expect(Object.keys(objects[2])).toEqual(["y", "x"]);
+    objects[0].z = 0;
+    expect(Object.keys(objects[0])).toEqual(["x", "y", "z"]);
+    expect(Object.keys(objects[1])).toEqual(["x", "y"]);
+    expect(Object.getPrototypeOf(objects[0])).toBe(Object.prototype);
+});
+
+test("strings", () => {
+    [
+        ['""', ""],
+        ['"\\"\\\\\\/\\b\\f\\n\\r\\t"', '"\\/\b\f\n\r\t'],
+        ['"\\u0041\\u00e9"', "Aé"],
+        ['"\\ud83d\\ude00"', "😀"],
+        ['"héllo"', "héllo"],
+    ].forEach(testCase => {
+        expect(JSON.parse(testCase[0])).toBe(testCase[1]);
+    });
+});
+
+test("numbers", () => {
+    [
+        ["0", 0],
+        ["-0", -0],
+        ["2147483647", 2147483647],
+        ["-2147483648", -2147483648],
+        ["2147483648", 2147483648],
+        ["9007199254740993", 9007199254740992],
+        ["1E2", 100],
+        ["1e-2", 0.01],
+    ].forEach(testCase => {
+        expect(JSON.parse(testCase[0])).toBe(testCase[1]);
+    });
+});
+
 test("syntax errors", () => {
     [
         undefined,
@@ -29,9 +78,39 @@ test("syntax errors", () => {
         "[1,2,3, ]",
         '{ "foo": "bar",}',
         '{ "foo": "bar", }',
+        "",
+        " ",
+        "[1] 2",
+        "01",
+        "1.",
+        ".5",
+        "-",
+        "1e",
+        "+1",
+        "tru",
+        "nul",
+        '"abc',
+        '"\\x"',
+        '"\\u12"',
+        '"\t"',
+        "{'foo': 1}",
+        '{"foo" 1}',
+        "[1 2]",
     ].forEach(test => {
         expect(() => {
             JSON.parse(test);
         }).toThrow(SyntaxError);
     });
 });
+
+test("objects with many duplicate keys", () => {
+    const parts = [];
+    for (let i = 0; i < 20000; ++i) parts.push(`"key${i % 200}": ${i}`);
+    const object = JSON.parse(`{${parts.join(",")}}`);
+    const keys = Object.keys(object);
+    expect(keys).toHaveLength(200);
+    expect(keys[0]).toBe("key0");
+    expect(keys[199]).toBe("key199");
+    expect(object.key0).toBe(19800);
+    expect(object.key199).toBe(19999);
+});
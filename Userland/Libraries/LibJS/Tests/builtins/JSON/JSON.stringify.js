@@ -38,6 +38,33 @@ describe("correct behavior", () => {
         });
     });
 
+    test("escapes strings", () => {
+        expect(JSON.stringify('a"b\\c\nd\u0001é')).toBe('"a\\"b\\\\c\\nd\\u0001é"');
+        expect(JSON.stringify({ 'key"': 1 })).toBe('{"key\\"":1}');
+    });
+
+    test("arrays with holes and accessors", () => {
+        let array = [1, , 3];
+        Object.defineProperty(array, 2, { get: () => "getter" });
+        expect(JSON.stringify(array)).toBe('[1,null,"getter"]');
+        expect(JSON.stringify([undefined, () => {}, Symbol()])).toBe("[null,null,null]");
+    });
+
+    test("properties changed while serializing", () => {
+        let o = {
+            a: {
+                toJSON() {
+                    delete o.b;
+                    o.c = 3;
+                    return 1;
+                },
+            },
+            b: 2,
+            c: 4,
+        };
+        expect(JSON.stringify(o)).toBe('{"a":1,"c":3}');
+    });
+
     test("ignores non-enumerable properties", () => {
         let o = { foo: "bar" };
         Object.defineProperty(o, "baz", { value: "qux", enumerable: false });
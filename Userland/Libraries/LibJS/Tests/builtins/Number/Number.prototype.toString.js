@@ -18,6 +18,30 @@ describe("correct behavior", () => {
         });
     });
 
+    test("shortest representation that round-trips", () => {
+        [
+            [0.1, "0.1"],
+            [0.1 + 0.2, "0.30000000000000004"],
+            [1 / 3, "0.3333333333333333"],
+            [123.456, "123.456"],
+            [-1.5, "-1.5"],
+            [1e21, "1e+21"],
+            [1.5e21, "1.5e+21"],
+            [123e18, "123000000000000000000"],
+            [123e19, "1.23e+21"],
+            [1e-6, "0.000001"],
+            [1e-7, "1e-7"],
+            [1.25e-7, "1.25e-7"],
+            [2 ** 53 + 2, "9007199254740994"],
+            [1.7976931348623157e308, "1.7976931348623157e+308"],
+            [5e-324, "5e-324"],
+            [Number.EPSILON, "2.220446049250313e-16"],
+        ].forEach(testCase => {
+            expect(testCase[0].toString()).toBe(testCase[1]);
+            expect(Number(testCase[1])).toBe(testCase[0]);
+        });
+    });
+
     test("radix", () => {
         let number = 7857632;
 
@@ -0,0 +1,42 @@
+test("basic functionality", () => {
+    expect(RegExp.prototype[Symbol.match]).toHaveLength(1);
+
+    expect("hello friends".match(/hello/)[0]).toBe("hello");
+    expect("hello friends".match(/enemies/)).toBeNull();
+});
+
+test("global match returns all matches", () => {
+    expect("a1b22c333".match(/\d+/g)).toEqual(["1", "22", "333"]);
+    expect("abc".match(/\d/g)).toBeNull();
+    expect("aaa".match(/a*?/g)).toEqual(["", "", "", ""]);
+    expect("xyx".match(/x/gy)).toEqual(["x"]);
+});
+
+test("global match starts at the beginning and resets lastIndex", () => {
+    let re = /o/g;
+    re.lastIndex = 5;
+    expect("foo boo".match(re)).toEqual(["o", "o", "o", "o"]);
+    expect(re.lastIndex).toBe(0);
+});
+
+test("custom exec is called for every match", () => {
+    let re = /./g;
+    let calls = 0;
+    re.exec = function (string) {
+        ++calls;
+        return RegExp.prototype.exec.call(this, string);
+    };
+    expect("abc".match(re)).toEqual(["a", "b", "c"]);
+    expect(calls).toBe(4);
+});
+
+test("regexes with the same source and flags don't share lastIndex", () => {
+    let first = /a/g;
+    let second = /a/g;
+    expect(first.exec("aa").index).toBe(0);
+    expect(second.exec("aa").index).toBe(0);
+    expect(first.exec("aa").index).toBe(1);
+    expect(first.lastIndex).toBe(2);
+    expect(second.lastIndex).toBe(1);
+    expect(new RegExp("a", "g").lastIndex).toBe(0);
+});
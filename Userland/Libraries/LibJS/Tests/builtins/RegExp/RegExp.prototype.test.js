@@ -56,3 +56,22 @@ test("flag and options", () => {
         /foo/x;
     }).toThrowWithMessage(SyntaxError, "Invalid RegExp flag 'x'");
 });
+
+test("sticky test only matches at lastIndex", () => {
+    let re = /b/y;
+    expect(re.test("abb")).toBeFalse();
+    expect(re.lastIndex).toBe(0);
+    re.lastIndex = 1;
+    expect(re.test("abb")).toBeTrue();
+    expect(re.test("abb")).toBeTrue();
+    expect(re.lastIndex).toBe(3);
+    expect(re.test("abb")).toBeFalse();
+    expect(re.lastIndex).toBe(0);
+});
+
+test("lastIndex past the end of the string", () => {
+    let re = /a/g;
+    re.lastIndex = 10;
+    expect(re.test("aaa")).toBeFalse();
+    expect(re.lastIndex).toBe(0);
+});
@@ -102,3 +102,19 @@ test("functional regex replacement", () => {
         })
     ).toBe("xd");
 });
+
+test("global regex replacement with many matches", () => {
+    const string = "ab".repeat(1000);
+    expect(string.replace(/b/g, "c")).toBe("ac".repeat(1000));
+    expect("aaa".replace(/a*?/g, "-")).toBe("-a-a-a-");
+    expect("a.b.c".replace(/(\w)(\.)?/g, (match, letter, dot) => letter.toUpperCase() + (dot ? "," : ""))).toBe("A,B,C");
+});
+
+test("sticky regex replacement", () => {
+    let re = /a/y;
+    expect("aab".replace(re, "x")).toBe("xab");
+    expect(re.lastIndex).toBe(1);
+    expect("aab".replace(re, "x")).toBe("axb");
+    expect("aab".replace(re, "x")).toBe("aab");
+    expect(re.lastIndex).toBe(0);
+});
@@ -0,0 +1,147 @@
+test("lazily parsed functions can be called", () => {
+    const result = evaluateWithLazyFunctionParsing(`
+        function add(a, b) {
+            return a + b;
+        }
+        add(1, 2);
+    `);
+    expect(result).toBe(3);
+});
+
+test("nested functions", () => {
+    const result = evaluateWithLazyFunctionParsing(`
+        function outer(x) {
+            function inner(y) {
+                function innermost() {
+                    return x + y;
+                }
+                return innermost();
+            }
+            return inner(x * 2);
+        }
+        outer(5);
+    `);
+    expect(result).toBe(15);
+});
+
+test("arrow functions with block bodies", () => {
+    const result = evaluateWithLazyFunctionParsing(`
+        const makeCounter = () => {
+            let count = 0;
+            return () => {
+                if (count < 2) {
+                    return { value: ++count };
+                }
+                return { value: count * 10 };
+            };
+        };
+        const counter = makeCounter();
+        [counter().value, counter().value, counter().value];
+    `);
+    expect(result).toEqual([1, 2, 20]);
+});
+
+test("braces inside strings, template literals and regular expressions", () => {
+    const result = evaluateWithLazyFunctionParsing(`
+        function f() {
+            const s = "}";
+            const t = \`{\${"}"}\`;
+            const r = /[}{]/;
+            return s + t + r.source;
+        }
+        f();
+    `);
+    expect(result).toBe("}{}[}{]");
+});
+
+test("strict mode directive in a lazily parsed body", () => {
+    const result = evaluateWithLazyFunctionParsing(`
+        function f() {
+            "use strict";
+            return isStrictMode();
+        }
+        function g() {
+            return isStrictMode();
+        }
+        [f(), g()];
+    `);
+    expect(result).toEqual([true, false]);
+});
+
+test("strict mode directive after other directives", () => {
+    const result = evaluateWithLazyFunctionParsing(`
+        function f() {
+            "foo";
+            'use strict';
+            return isStrictMode();
+        }
+        function g() {
+            "foo";
+            1;
+            "use strict";
+            return isStrictMode();
+        }
+        [f(), g()];
+    `);
+    expect(result).toEqual([true, false]);
+});
+
+describe("syntax errors in lazily parsed bodies", () => {
+    test("are thrown when the program is parsed", () => {
+        expect(() => {
+            evaluateWithLazyFunctionParsing(`
+                function broken() {
+                    return 1 +;
+                }
+            `);
+        }).toThrowWithMessage(SyntaxError, "Unexpected token Semicolon. Expected primary expression (line: 3, column: 31)");
+
+        expect(() => {
+            evaluateWithLazyFunctionParsing(`
+                var notCalled = () => {
+                    let let = 1;
+                };
+            `);
+        }).toThrow(SyntaxError);
+    });
+
+    test("are found in nested functions", () => {
+        expect(() => {
+            evaluateWithLazyFunctionParsing(`
+                function outer() {
+                    return () => {
+                        function inner() {
+                            if (true) { ) }
+                        }
+                    };
+                }
+            `);
+        }).toThrowWithMessage(SyntaxError, "Unexpected token ParenClose. Expected statement or declaration (line: 5, column: 41)");
+    });
+
+    test("that depend on strict mode", () => {
+        expect(() => {
+            evaluateWithLazyFunctionParsing(`
+                function f() {
+                    "use strict";
+                    eval = 1;
+                }
+            `);
+        }).toThrowWithMessage(SyntaxError, "'eval' cannot be assigned to in strict mode code (line: 4, column: 28)");
+
+        expect(() => {
+            evaluateWithLazyFunctionParsing(`
+                function f() {
+                    "use strict";
+                    return 010;
+                }
+            `);
+        }).toThrow(SyntaxError);
+    });
+
+    test("unbalanced braces", () => {
+        expect(() => {
+            evaluateWithLazyFunctionParsing("function f() { {");
+        }).toThrow(SyntaxError);
+    });
+});
@@ -0,0 +1,38 @@
+test("concatenating long strings", () => {
+    const a = "a".repeat(40);
+    const b = "b".repeat(40);
+    const ab = a + b;
+    expect(ab.length).toBe(80);
+    expect(ab.startsWith(a)).toBeTrue();
+    expect(ab.endsWith(b)).toBeTrue();
+    expect(ab + "" === a + b).toBeTrue();
+});
+
+test("building a string in a loop", () => {
+    let s = "";
+    for (let i = 0; i < 10000; ++i) s += "x";
+    expect(s.length).toBe(10000);
+    expect(s).toBe("x".repeat(10000));
+
+    let t = "";
+    for (let i = 0; i < 1000; ++i) t = i + "," + t;
+    expect(t.startsWith("999,998,997,")).toBeTrue();
+    expect(t.endsWith(",2,1,0,")).toBeTrue();
+});
+
+test("concatenation results survive garbage collection", () => {
+    let s = "";
+    for (let i = 0; i < 100; ++i) s += "0123456789";
+    gc();
+    expect(s.length).toBe(1000);
+    expect(s.substring(990)).toBe("0123456789");
+});
+
+test("numbers are converted to strings", () => {
+    expect("" + 0).toBe("0");
+    expect("" + 42).toBe("42");
+    expect(1023 + "").toBe("1023");
+    expect(1024 + "").toBe("1024");
+    expect("" + -1).toBe("-1");
+    expect(String(512)).toBe("512");
+});
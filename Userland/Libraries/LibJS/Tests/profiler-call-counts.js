@@ -0,0 +1,63 @@
+const callCountsByName = statistics => {
+    const callCounts = {};
+    statistics.forEach(entry => {
+        // Names look like "foo (line:column)".
+        const functionName = entry.name.substring(0, entry.name.lastIndexOf(" ("));
+        callCounts[functionName] = (callCounts[functionName] ?? 0) + entry.callCount;
+    });
+    return callCounts;
+};
+
+test("call counts are recorded", () => {
+    function fibonacci(n) {
+        return n < 2 ? n : fibonacci(n - 1) + fibonacci(n - 2);
+    }
+    function neverCalled() {}
+
+    const callCounts = callCountsByName(
+        profile(function profiledCallback() {
+            fibonacci(10);
+            [1, 2, 3].forEach(function arrayCallback() {});
+        })
+    );
+    expect(callCounts.profiledCallback).toBe(1);
+    expect(callCounts.fibonacci).toBe(177);
+    expect(callCounts.arrayCallback).toBe(3);
+    expect(callCounts.neverCalled).toBeUndefined();
+});
+
+test("closures created from the same code share an entry", () => {
+    const makeAdder = x =>
+        function adder(y) {
+            return x + y;
+        };
+    const statistics = profile(() => {
+        for (let i = 0; i < 5; ++i) makeAdder(i)(i);
+    });
+    const adderStatistics = statistics.filter(entry => entry.name.startsWith("adder ("));
+    expect(adderStatistics).toHaveLength(1);
+    expect(adderStatistics[0].callCount).toBe(5);
+});
+
+test("functions whose code has been freed keep their own entries", () => {
+    const statistics = profile(() => {
+        for (let i = 0; i < 20; ++i) {
+            new Function(`return ${i};`)();
+            gc();
+        }
+    });
+    const anonymousStatistics = statistics.filter(entry => entry.name.startsWith("anonymous ("));
+    expect(anonymousStatistics).toHaveLength(20);
+    anonymousStatistics.forEach(entry => expect(entry.callCount).toBe(1));
+});
+
+test("exceptions are propagated", () => {
+    expect(() => {
+        profile(() => {
+            throw new Error("oops");
+        });
+    }).toThrowWithMessage(Error, "oops");
+    expect(() => {
+        profile(42);
+    }).toThrow(TypeError);
+});
@@ -7,6 +7,7 @@
 
 #include "Token.h"
 #include <AK/Assertions.h>
+#include <AK/FloatingPointStringConversions.h>
 #include <AK/GenericLexer.h>
 #include <AK/StringBuilder.h>
 #include <ctype.h>
@@ -70,7 +71,7 @@ double Token::double_value() const
                 return static_cast<double>(strtoul(value_string.characters() + 1, nullptr, 8));
         }
     }
-    return strtod(value_string.characters(), nullptr);
+    return parse_first_floating_point(m_value.characters_without_null_termination(), m_value.characters_without_null_termination() + m_value.length()).value;
 }
 
 static u32 hex2int(char x)
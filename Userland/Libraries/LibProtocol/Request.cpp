@@ -44,6 +44,8 @@ void Request::stream_into(OutputStream& stream)
             // FIXME: What do we do here?
             TODO();
         }
+        if (nread > 0 && on_data_received)
+            on_data_received({ buf, nread });
 
         if (m_internal_stream_data->read_stream.eof() && m_internal_stream_data->request_done) {
             m_internal_stream_data->read_notifier->close();
@@ -71,9 +73,11 @@ void Request::set_should_buffer_all_input(bool value)
     m_internal_buffered_data = make<InternalBufferedData>(fd());
     m_should_buffer_all_input = true;
 
-    on_headers_received = [this](auto& headers, auto response_code) {
+    on_headers_received = [this, user_on_headers_received = move(on_headers_received)](auto& headers, auto response_code) {
         m_internal_buffered_data->response_headers = headers;
-        m_internal_buffered_data->response_code = move(response_code);
+        m_internal_buffered_data->response_code = response_code;
+        if (user_on_headers_received)
+            user_on_headers_received(headers, response_code);
     };
 
     on_finish = [this](auto success, u32 total_size) {
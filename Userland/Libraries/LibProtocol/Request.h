@@ -40,7 +40,7 @@ public:
     void stream_into(OutputStream&);
 
     bool should_buffer_all_input() const { return m_should_buffer_all_input; }
-    /// Note: Will override `on_finish', and `on_headers_received', and expects `on_buffered_request_finish' to be set!
+    /// Note: Will override `on_finish', and wrap `on_headers_received', and expects `on_buffered_request_finish' to be set!
     void set_should_buffer_all_input(bool);
 
     /// Note: Must be set before `set_should_buffer_all_input(true)`.
@@ -49,6 +49,8 @@ public:
     Function<void(Optional<u32> total_size, u32 downloaded_size)> on_progress;
     Function<void(const HashMap<String, String, CaseInsensitiveStringTraits>& response_headers, Optional<u32> response_code)> on_headers_received;
     Function<CertificateAndKey()> on_certificate_requested;
+    /// Note: Called with each chunk of the payload as it's read from the request fd.
+    Function<void(ReadonlyBytes)> on_data_received;
 
     void did_finish(Badge<RequestClient>, bool success, u32 total_size);
     void did_progress(Badge<RequestClient>, Optional<u32> total_size, u32 downloaded_size);
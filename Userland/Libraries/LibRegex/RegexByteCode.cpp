@@ -131,6 +131,9 @@ ALWAYS_INLINE OpCode* ByteCode::get_opcode_by_id(OpCodeId id) const
             case OpCodeId::CheckBegin:
                 s_opcodes.set(i, make<OpCode_CheckBegin>(*const_cast<ByteCode*>(this)));
                 break;
+            case OpCodeId::PossessiveRepeat:
+                s_opcodes.set(i, make<OpCode_PossessiveRepeat>(*const_cast<ByteCode*>(this)));
+                break;
             case OpCodeId::SaveLeftCaptureGroup:
                 s_opcodes.set(i, make<OpCode_SaveLeftCaptureGroup>(*const_cast<ByteCode*>(this)));
                 break;
@@ -226,6 +229,30 @@ ALWAYS_INLINE ExecutionResult OpCode_ForkStay::execute(const MatchInput&, MatchS
     return ExecutionResult::Fork_PrioLow;
 }
 
+ALWAYS_INLINE ExecutionResult OpCode_PossessiveRepeat::execute(const MatchInput& input, MatchState& state, MatchOutput& output) const
+{
+    MatchState body_state = state;
+    body_state.instruction_position = state.instruction_position + 2;
+    auto& body = *m_bytecode->get_opcode(body_state);
+    VERIFY(is<OpCode_Compare>(body));
+
+    size_t count = 0;
+    for (;;) {
+        auto string_position = body_state.string_position;
+        if (body.execute(input, body_state, output) != ExecutionResult::Continue || body_state.string_position == string_position) {
+            body_state.string_position = string_position;
+            break;
+        }
+        ++count;
+    }
+
+    if (count < minimum())
+        return ExecutionResult::Failed_ExecuteLowPrioForks;
+
+    state.string_position = body_state.string_position;
+    return ExecutionResult::Continue;
+}
+
 ALWAYS_INLINE ExecutionResult OpCode_CheckBegin::execute(const MatchInput& input, MatchState& state, MatchOutput&) const
 {
     if (0 == state.string_position && (input.regex_options & AllFlags::MatchNotBeginOfLine))
@@ -426,16 +453,27 @@ ALWAYS_INLINE ExecutionResult OpCode_Compare::execute(const MatchInput& input, M
             VERIFY(!current_inversion_state());
 
             const auto& length = m_bytecode->at(offset++);
-            StringBuilder str_builder;
-            for (size_t i = 0; i < length; ++i)
-                str_builder.append(m_bytecode->at(offset++));
 
             // We want to compare a string that is definitely longer than the available string
             if (input.view.length() - state.string_position < length)
                 return ExecutionResult::Failed_ExecuteLowPrioForks;
 
-            if (!compare_string(input, state, str_builder.string_view().characters_without_null_termination(), length, had_zero_length_match))
-                return ExecutionResult::Failed_ExecuteLowPrioForks;
+            // NOTE: This compares the code units directly, rather than building a string from the bytecode first.
+            for (size_t i = 0; i < length; ++i) {
+                u32 ch1 = m_bytecode->at(offset + i);
+                u32 ch2 = input.view[state.string_position + i];
+                if (input.regex_options & AllFlags::Insensitive) {
+                    ch1 = tolower(ch1);
+                    ch2 = tolower(ch2);
+                }
+                if (ch1 != ch2)
+                    return ExecutionResult::Failed_ExecuteLowPrioForks;
+            }
+
+            offset += length;
+            state.string_position += length;
+            if (length == 0)
+                had_zero_length_match = true;
 
         } else if (compare_type == CharacterCompareType::CharClass) {
 
@@ -38,6 +38,7 @@ using ByteCodeValueType = u64;
     __ENUMERATE_OPCODE(Save)                       \
     __ENUMERATE_OPCODE(Restore)                    \
     __ENUMERATE_OPCODE(GoBack)                     \
+    __ENUMERATE_OPCODE(PossessiveRepeat)           \
     __ENUMERATE_OPCODE(Exit)
 
 // clang-format off
@@ -446,7 +447,7 @@ private:
     {
         empend((ByteCodeValueType)view.length());
         for (size_t i = 0; i < view.length(); ++i)
-            empend((ByteCodeValueType)view[i]);
+            empend((ByteCodeValueType)(u8)view[i]);
     }
 
     ALWAYS_INLINE OpCode* get_opcode_by_id(OpCodeId id) const;
@@ -639,6 +640,23 @@ public:
     }
 };
 
+// Matches the Compare that follows it as often as possible, without leaving any fork states behind.
+// This is only emitted by the optimizer, for loops that backtracking could never make match differently.
+class OpCode_PossessiveRepeat final : public OpCode {
+public:
+    OpCode_PossessiveRepeat(ByteCode& bytecode)
+        : OpCode(bytecode)
+    {
+    }
+    ExecutionResult execute(const MatchInput& input, MatchState& state, MatchOutput& output) const override;
+    ALWAYS_INLINE OpCodeId opcode_id() const override { return OpCodeId::PossessiveRepeat; }
+    ALWAYS_INLINE size_t size() const override { return 2 + body_size(); }
+    ALWAYS_INLINE size_t minimum() const { return argument(0); }
+    // The body is a Compare: [Compare, arguments count, arguments size, arguments...]
+    ALWAYS_INLINE size_t body_size() const { return argument(3) + 3; }
+    const String arguments_string() const override { return String::formatted("min={}, body_size={}", minimum(), body_size()); }
+};
+
 class OpCode_CheckBegin final : public OpCode {
 public:
     OpCode_CheckBegin(ByteCode& bytecode)
@@ -791,6 +809,12 @@ ALWAYS_INLINE bool is<OpCode_Compare>(const OpCode& opcode)
     return opcode.opcode_id() == OpCodeId::Compare;
 }
 
+template<>
+ALWAYS_INLINE bool is<OpCode_PossessiveRepeat>(const OpCode& opcode)
+{
+    return opcode.opcode_id() == OpCodeId::PossessiveRepeat;
+}
+
 template<typename T>
 ALWAYS_INLINE const T& to(const OpCode& opcode)
 {
@@ -8,6 +8,7 @@
 #include "RegexDebug.h"
 #include "RegexParser.h"
 #include <AK/Debug.h>
+#include <AK/MemMem.h>
 #include <AK/ScopedValueRollback.h>
 #include <AK/String.h>
 #include <AK/StringBuilder.h>
@@ -27,8 +28,10 @@ Regex<Parser>::Regex(StringView pattern, typename ParserTraits<Parser>::OptionsT
     Parser parser(lexer, regex_options);
     parser_result = parser.parse();
 
-    if (parser_result.error == regex::Error::NoError)
+    if (parser_result.error == regex::Error::NoError) {
+        run_optimization_passes(regex_options);
         matcher = make<Matcher<Parser>>(*this, regex_options);
+    }
 }
 
 template<class Parser>
@@ -138,6 +141,16 @@ RegexResult Matcher<Parser>::match(const Vector<RegexStringView> views, Optional
     if (input.regex_options.has_flag_set(AllFlags::Internal_Stateful))
         continue_search = false;
 
+    // Sticky matches have to start right at the start offset.
+    bool is_sticky = input.regex_options.has_flag_set(AllFlags::Sticky);
+
+    // Only skip ahead if we'd otherwise try every position, and if the prefilter was computed with the same case sensitivity.
+    bool can_skip_start_positions = (continue_search || input.regex_options.has_flag_set(AllFlags::Internal_Stateful)) && !is_sticky
+        && (!m_pattern.literal_prefix.is_empty() || m_pattern.first_characters.has_value())
+        && input.regex_options.has_flag_set(AllFlags::Insensitive) == AllOptions { m_regex_options }.has_flag_set(AllFlags::Insensitive);
+
+    bool has_capture_groups = m_pattern.parser_result.capture_groups_count || m_pattern.parser_result.named_capture_groups_count;
+
     for (auto& view : views) {
         if (lines_to_skip != 0) {
             ++input.line;
@@ -164,7 +177,7 @@ RegexResult Matcher<Parser>::match(const Vector<RegexStringView> views, Optional
             state.string_position = view_index;
             state.instruction_position = 0;
 
-            auto success = execute(input, state, temp_output, 0);
+            auto success = execute(input, state, temp_output);
             // This success is acceptable only if it doesn't read anything from the input (input length is 0).
             if (state.string_position <= view_index) {
                 if (success.value()) {
@@ -179,6 +192,13 @@ RegexResult Matcher<Parser>::match(const Vector<RegexStringView> views, Optional
         }
 
         for (; view_index < view_length; ++view_index) {
+            if (can_skip_start_positions) {
+                auto next_possible_start = find_next_possible_start(view, view_index);
+                if (!next_possible_start.has_value())
+                    break;
+                view_index = next_possible_start.value();
+            }
+
             auto& match_length_minimum = m_pattern.parser_result.match_length_minimum;
             // FIXME: More performant would be to know the remaining minimum string
             //        length needed to match from the current position onwards within
@@ -189,13 +209,30 @@ RegexResult Matcher<Parser>::match(const Vector<RegexStringView> views, Optional
             if (match_length_minimum && match_length_minimum > view_length - view_index)
                 break;
 
+            Optional<MatchSpan> span;
+            if (m_pattern.should_match_without_backtracking) {
+                bool anchored = is_sticky || (!continue_search && !input.regex_options.has_flag_set(AllFlags::Internal_Stateful));
+                span = find_match_without_backtracking(input, view_index, anchored, can_skip_start_positions);
+                if (!span.has_value()) {
+                    state.string_position = 0;
+                    break;
+                }
+                view_index = span->start;
+            }
+
             input.column = match_count;
             input.match_index = match_count;
 
             state.string_position = view_index;
             state.instruction_position = 0;
 
-            auto success = execute(input, state, output, 0);
+            Optional<bool> success;
+            if (span.has_value() && !has_capture_groups) {
+                state.string_position = span->end;
+                success = true;
+            } else {
+                success = execute(input, state, output);
+            }
             if (!success.has_value())
                 return { false, 0, {}, {}, {}, output.operations };
 
@@ -237,7 +274,7 @@ RegexResult Matcher<Parser>::match(const Vector<RegexStringView> views, Optional
                 break;
             }
 
-            if (!continue_search && !input.regex_options.has_flag_set(AllFlags::Internal_Stateful))
+            if (is_sticky || (!continue_search && !input.regex_options.has_flag_set(AllFlags::Internal_Stateful)))
                 break;
         }
 
@@ -288,14 +325,94 @@ RegexResult Matcher<Parser>::match(const Vector<RegexStringView> views, Optional
 }
 
 template<class Parser>
-Optional<bool> Matcher<Parser>::execute(const MatchInput& input, MatchState& state, MatchOutput& output, size_t recursion_level) const
+Optional<size_t> Matcher<Parser>::find_next_possible_start(const RegexStringView& view, size_t index) const
 {
-    if (recursion_level > c_max_recursion)
-        return false;
+    auto& prefix = m_pattern.literal_prefix;
+    if (!prefix.is_empty()) {
+        if (view.is_u8_view()) {
+            auto& string = view.u8view();
+            auto offset = AK::memmem_optional(string.characters_without_null_termination() + index, string.length() - index, prefix.characters(), prefix.length());
+            if (!offset.has_value())
+                return {};
+            return index + offset.value();
+        }
+
+        for (; index + prefix.length() <= view.length(); ++index) {
+            size_t i = 0;
+            while (i < prefix.length() && view[index + i] == (u8)prefix[i])
+                ++i;
+            if (i == prefix.length())
+                return index;
+        }
+        return {};
+    }
 
-    Vector<MatchState> fork_low_prio_states;
-    MatchState fork_high_prio_state;
-    Optional<bool> success;
+    auto& characters = m_pattern.first_characters.value();
+    if (view.is_u8_view()) {
+        auto& string = view.u8view();
+        for (; index < string.length(); ++index) {
+            if (characters.contains((u8)string[index]))
+                return index;
+        }
+        return {};
+    }
+
+    for (; index < view.length(); ++index) {
+        if (characters.contains(view[index]))
+            return index;
+    }
+    return {};
+}
+
+template<class Parser>
+Optional<bool> Matcher<Parser>::execute(const MatchInput& input, MatchState& state, MatchOutput& output) const
+{
+    // Rather than recursing for every fork, we keep the states we may have to come back to on an explicit stack.
+    // The order in which states are tried is the same as if we recursed into every high priority fork and
+    // tried the low priority forks of each "frame" (most recent first) once its own path has failed.
+    Vector<BacktrackingState, 64> backtracking_states;
+
+    auto make_state = [&](BacktrackingState::Kind kind, size_t string_position, size_t instruction_position) {
+        BacktrackingState backtracking_state;
+        backtracking_state.kind = kind;
+        backtracking_state.instruction_position = instruction_position;
+        backtracking_state.string_position = string_position;
+        backtracking_state.states_without_progress = 0;
+        if (!backtracking_states.is_empty() && backtracking_states.last().string_position == string_position)
+            backtracking_state.states_without_progress = backtracking_states.last().states_without_progress + 1;
+        return backtracking_state;
+    };
+
+    // Loops that can match the empty string would otherwise keep adding states without ever consuming anything,
+    // so once too many states in a row were added at the same string position, the current path fails instead.
+    auto push = [&](BacktrackingState::Kind kind, size_t string_position, size_t instruction_position) {
+        auto backtracking_state = make_state(kind, string_position, instruction_position);
+        if (backtracking_state.states_without_progress >= c_max_backtracking_states_without_progress)
+            return false;
+        backtracking_states.append(backtracking_state);
+        return true;
+    };
+
+    // Returns false if there is nothing left to try.
+    auto backtrack = [&] {
+        while (!backtracking_states.is_empty()) {
+            auto backtracking_state = backtracking_states.take_last();
+            switch (backtracking_state.kind) {
+            case BacktrackingState::Kind::FrameBoundary:
+                continue;
+            case BacktrackingState::Kind::LowPriorityFork:
+                // This takes the place of the fork we just removed, so it can't grow the stack.
+                backtracking_states.append(make_state(BacktrackingState::Kind::FrameBoundary, backtracking_state.string_position, 0));
+                break;
+            case BacktrackingState::Kind::HighPriorityForkContinuation:
+                break;
+            }
+            state.string_position = backtracking_state.string_position;
+            state.instruction_position = backtracking_state.instruction_position;
+            return true;
+        }
+        return false;
+    };
 
     auto& bytecode = m_pattern.parser_result.bytecode;
 
@@ -309,7 +426,7 @@ Optional<bool> Matcher<Parser>::execute(const MatchInput& input, MatchState& sta
         }
 
 #if REGEX_DEBUG
-        s_regex_dbg.print_opcode("VM", *opcode, state, recursion_level, false);
+        s_regex_dbg.print_opcode("VM", *opcode, state, backtracking_states.size(), false);
 #endif
 
         ExecutionResult result;
@@ -328,58 +445,49 @@ Optional<bool> Matcher<Parser>::execute(const MatchInput& input, MatchState& sta
 
         switch (result) {
         case ExecutionResult::Fork_PrioLow:
-            fork_low_prio_states.prepend(state);
-            continue;
+            if (push(BacktrackingState::Kind::LowPriorityFork, state.string_position, state.fork_at_position))
+                continue;
+            // We're stuck in an empty loop, so this path fails.
+            break;
         case ExecutionResult::Fork_PrioHigh:
-            fork_high_prio_state = state;
-            fork_high_prio_state.instruction_position = fork_high_prio_state.fork_at_position;
-            success = execute(input, fork_high_prio_state, output, ++recursion_level);
-            if (!success.has_value())
-                return {};
-
-            if (success.value()) {
-                state = fork_high_prio_state;
-                return true;
+            if (push(BacktrackingState::Kind::HighPriorityForkContinuation, state.string_position, state.instruction_position)) {
+                state.instruction_position = state.fork_at_position;
+                continue;
             }
-
-            continue;
+            // We're stuck in an empty loop, so this path fails.
+            break;
         case ExecutionResult::Continue:
             continue;
         case ExecutionResult::Succeeded:
             return true;
-        case ExecutionResult::Failed:
-            return false;
+        case ExecutionResult::Failed: {
+            // Give up on the current frame without trying its low priority forks.
+            bool found_frame_boundary = false;
+            while (!backtracking_states.is_empty()) {
+                auto kind = backtracking_states.last().kind;
+                if (kind == BacktrackingState::Kind::LowPriorityFork) {
+                    backtracking_states.take_last();
+                    continue;
+                }
+                found_frame_boundary = true;
+                break;
+            }
+            if (!found_frame_boundary)
+                return false;
+            break;
+        }
         case ExecutionResult::Failed_ExecuteLowPrioForks:
-            return execute_low_prio_forks(input, state, output, fork_low_prio_states, recursion_level + 1);
+            break;
         }
-    }
-
-    VERIFY_NOT_REACHED();
-}
 
-template<class Parser>
-ALWAYS_INLINE Optional<bool> Matcher<Parser>::execute_low_prio_forks(const MatchInput& input, MatchState& original_state, MatchOutput& output, Vector<MatchState> states, size_t recursion_level) const
-{
-    for (auto& state : states) {
-
-        state.instruction_position = state.fork_at_position;
-#if REGEX_DEBUG
-        fprintf(stderr, "Forkstay... ip = %lu, sp = %lu\n", state.instruction_position, state.string_position);
-#endif
-        auto success = execute(input, state, output, recursion_level);
-        if (!success.has_value())
-            return {};
-        if (success.value()) {
-#if REGEX_DEBUG
-            fprintf(stderr, "Forkstay succeeded... ip = %lu, sp = %lu\n", state.instruction_position, state.string_position);
-#endif
-            original_state = state;
-            return true;
-        }
+        // The current path has failed, so continue with the most recent state we can go back to.
+        if (backtrack())
+            continue;
+        state.string_position = 0;
+        return false;
     }
 
-    original_state.string_position = 0;
-    return false;
+    VERIFY_NOT_REACHED();
 }
 
 template class Matcher<PosixExtendedParser>;
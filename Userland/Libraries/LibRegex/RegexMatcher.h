@@ -14,6 +14,7 @@
 #include <AK/Forward.h>
 #include <AK/HashMap.h>
 #include <AK/NonnullOwnPtrVector.h>
+#include <AK/NumericLimits.h>
 #include <AK/Types.h>
 #include <AK/Utf32View.h>
 #include <AK/Vector.h>
@@ -23,7 +24,7 @@
 
 namespace regex {
 
-static const constexpr size_t c_max_recursion = 5000;
+static const constexpr size_t c_max_backtracking_states_without_progress = 5000;
 static const constexpr size_t c_match_preallocation_count = 0;
 
 struct RegexResult final {
@@ -37,6 +38,80 @@ struct RegexResult final {
     size_t n_named_capture_groups { 0 };
 };
 
+// A set of characters, which is exact for Latin-1 and only tracks whether anything else might be in it.
+class CharacterSet {
+public:
+    void add(u32 code_point)
+    {
+        if (code_point < 256)
+            m_latin1[code_point / 64] |= 1ull << (code_point % 64);
+        else
+            m_may_contain_non_latin1 = true;
+    }
+
+    void add_non_latin1() { m_may_contain_non_latin1 = true; }
+
+    void merge(const CharacterSet& other)
+    {
+        for (size_t i = 0; i < 4; ++i)
+            m_latin1[i] |= other.m_latin1[i];
+        m_may_contain_non_latin1 |= other.m_may_contain_non_latin1;
+    }
+
+    bool contains(u32 code_point) const
+    {
+        if (code_point < 256)
+            return m_latin1[code_point / 64] & (1ull << (code_point % 64));
+        return m_may_contain_non_latin1;
+    }
+
+    bool intersects(const CharacterSet& other) const
+    {
+        for (size_t i = 0; i < 4; ++i) {
+            if (m_latin1[i] & other.m_latin1[i])
+                return true;
+        }
+        return m_may_contain_non_latin1 && other.m_may_contain_non_latin1;
+    }
+
+    bool is_everything() const
+    {
+        for (size_t i = 0; i < 4; ++i) {
+            if (m_latin1[i] != NumericLimits<u64>::max())
+                return false;
+        }
+        return m_may_contain_non_latin1;
+    }
+
+private:
+    u64 m_latin1[4] {};
+    bool m_may_contain_non_latin1 { false };
+};
+
+// A state the matcher might have to go back to, see Matcher::execute().
+struct BacktrackingState {
+    enum class Kind : u8 {
+        LowPriorityFork,              // An alternative to try once everything after the fork has failed.
+        HighPriorityForkContinuation, // Where to continue once the preferred side of a fork has failed.
+        FrameBoundary,                // Marks where the states added while trying a low priority fork start.
+    };
+
+    Kind kind : 2;
+    size_t instruction_position : 46;
+    // How many states directly below this one on the stack have the same string position.
+    size_t states_without_progress : 16;
+    size_t string_position;
+};
+static_assert(sizeof(BacktrackingState) == 16);
+static_assert(c_max_backtracking_states_without_progress < (1 << 16));
+
+struct MatchSpan {
+    size_t start { 0 };
+    size_t end { 0 };
+};
+
+bool can_match_without_backtracking(const ByteCode&);
+
 template<class Parser>
 class Regex;
 
@@ -60,8 +135,9 @@ public:
     }
 
 private:
-    Optional<bool> execute(const MatchInput& input, MatchState& state, MatchOutput& output, size_t recursion_level) const;
-    ALWAYS_INLINE Optional<bool> execute_low_prio_forks(const MatchInput& input, MatchState& original_state, MatchOutput& output, Vector<MatchState> states, size_t recursion_level) const;
+    Optional<bool> execute(const MatchInput& input, MatchState& state, MatchOutput& output) const;
+    Optional<size_t> find_next_possible_start(const RegexStringView&, size_t index) const;
+    Optional<MatchSpan> find_match_without_backtracking(const MatchInput&, size_t start, bool anchored, bool can_skip_start_positions) const;
 
     const Regex<Parser>& m_pattern;
     const typename ParserTraits<Parser>::OptionsType m_regex_options;
@@ -75,6 +151,16 @@ public:
     OwnPtr<Matcher<Parser>> matcher { nullptr };
     mutable size_t start_offset { 0 };
 
+    // Filled in by run_optimization_passes(). The matcher uses these to skip over start positions
+    // that can't possibly match: Every match starts with literal_prefix (if it isn't empty), and
+    // with one of first_characters (if it has a value).
+    String literal_prefix;
+    Optional<CharacterSet> first_characters;
+
+    // Also filled in by run_optimization_passes(). If set, the matcher first finds the match in linear time
+    // without backtracking, and only runs the backtracking matcher at the start of it to fill in capture groups.
+    bool should_match_without_backtracking { false };
+
     explicit Regex(StringView pattern, typename ParserTraits<Parser>::OptionsType regex_options = {});
     ~Regex() = default;
 
@@ -206,6 +292,9 @@ public:
         RegexResult result = matcher->match(views, AllOptions { regex_options.value_or({}) } | AllFlags::SkipSubExprResults);
         return result.success;
     }
+
+private:
+    void run_optimization_passes(AllOptions);
 };
 
 // free standing functions for match, search and has_match
@@ -0,0 +1,528 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "RegexByteCode.h"
+#include "RegexMatcher.h"
+#include <AK/BinarySearch.h>
+#include <AK/Bitmap.h>
+#include <AK/Debug.h>
+#include <AK/StringBuilder.h>
+#include <AK/Utf32View.h>
+#include <ctype.h>
+
+namespace regex {
+
+enum class Casing {
+    Sensitive,
+    Insensitive,
+    Either, // The characters that are matched with or without AllFlags::Insensitive.
+};
+
+struct Instruction {
+    size_t position { 0 };
+    size_t size { 0 };
+    OpCodeId id { OpCodeId::Exit };
+};
+
+static Optional<Vector<Instruction>> decode(const ByteCode& bytecode)
+{
+    Vector<Instruction> instructions;
+    MatchState state;
+    while (state.instruction_position < bytecode.size()) {
+        auto* opcode = bytecode.get_opcode(state);
+        if (!opcode)
+            return {};
+        instructions.append({ state.instruction_position, opcode->size(), opcode->opcode_id() });
+        state.instruction_position += opcode->size();
+    }
+    if (state.instruction_position != bytecode.size())
+        return {};
+    return instructions;
+}
+
+static bool is_jump(OpCodeId id)
+{
+    return id == OpCodeId::Jump || id == OpCodeId::ForkJump || id == OpCodeId::ForkStay;
+}
+
+static size_t jump_target(const ByteCode& bytecode, size_t position)
+{
+    return position + 2 + (ssize_t)bytecode[position + 1];
+}
+
+// Mirrors OpCode_Compare::compare_character_class() for compares that aren't inverted.
+static bool character_class_contains(CharClass character_class, u32 ch, bool case_insensitive)
+{
+    switch (character_class) {
+    case CharClass::Alnum:
+        return isalnum(ch);
+    case CharClass::Alpha:
+        return isalpha(ch);
+    case CharClass::Blank:
+        return ch == ' ' || ch == '\t';
+    case CharClass::Cntrl:
+        return iscntrl(ch);
+    case CharClass::Digit:
+        return isdigit(ch);
+    case CharClass::Graph:
+        return isgraph(ch);
+    case CharClass::Lower:
+        return islower(ch) || (case_insensitive && isupper(ch));
+    case CharClass::Print:
+        return isprint(ch);
+    case CharClass::Punct:
+        return ispunct(ch);
+    case CharClass::Space:
+        return isspace(ch);
+    case CharClass::Upper:
+        return isupper(ch) || (case_insensitive && islower(ch));
+    case CharClass::Word:
+        return isalnum(ch) || ch == '_';
+    case CharClass::Xdigit:
+        return isxdigit(ch);
+    }
+    VERIFY_NOT_REACHED();
+}
+
+// Returns the characters a single Compare at `position` can consume, or nothing if it isn't
+// known to always consume exactly one character.
+static Optional<CharacterSet> characters_matched_by_compare(const ByteCode& bytecode, size_t position, Casing casing)
+{
+    bool sensitive = casing != Casing::Insensitive;
+    bool insensitive = casing != Casing::Sensitive;
+
+    size_t arguments_count = bytecode[position + 1];
+    size_t offset = position + 3;
+    bool may_match_non_latin1 = false;
+    bool needs_evaluation = false;
+    CharacterSet characters;
+
+    for (size_t i = 0; i < arguments_count; ++i) {
+        switch ((CharacterCompareType)bytecode[offset++]) {
+        case CharacterCompareType::Inverse:
+            may_match_non_latin1 = true;
+            needs_evaluation = true;
+            break;
+        case CharacterCompareType::AnyChar:
+            for (u32 ch = 0; ch < 256; ++ch)
+                characters.add(ch);
+            may_match_non_latin1 = true;
+            break;
+        case CharacterCompareType::Char: {
+            auto ch = bytecode[offset++];
+            if (ch > 255) {
+                may_match_non_latin1 = true;
+                break;
+            }
+            characters.add(ch);
+            if (insensitive && ch < 128) {
+                characters.add(tolower(ch));
+                characters.add(toupper(ch));
+            }
+            break;
+        }
+        case CharacterCompareType::CharRange: {
+            CharRange range = bytecode[offset++];
+            if (range.to > 255)
+                may_match_non_latin1 = true;
+            if (sensitive) {
+                for (u32 ch = range.from; ch <= min(range.to, 255u); ++ch)
+                    characters.add(ch);
+            }
+            if (insensitive) {
+                u32 from = tolower(range.from);
+                u32 to = tolower(range.to);
+                for (u32 ch = 0; ch < 256; ++ch) {
+                    u32 lowercase_ch = tolower(ch);
+                    if (lowercase_ch >= from && lowercase_ch <= to)
+                        characters.add(ch);
+                }
+            }
+            break;
+        }
+        case CharacterCompareType::CharClass: {
+            // Case insensitivity only ever adds characters to a class, so this covers Casing::Either too.
+            auto character_class = (CharClass)bytecode[offset++];
+            may_match_non_latin1 = true;
+            for (u32 ch = 0; ch < 256; ++ch) {
+                if (character_class_contains(character_class, ch, insensitive))
+                    characters.add(ch);
+            }
+            break;
+        }
+        default:
+            return {};
+        }
+    }
+
+    if (needs_evaluation) {
+        // Rather than duplicating the (somewhat quirky) rules for inverted compares here,
+        // let the Compare itself tell us which Latin-1 characters it accepts.
+        characters = {};
+        MatchOutput output;
+        MatchState state;
+        state.instruction_position = position;
+        auto& compare = *bytecode.get_opcode(state);
+        for (auto case_insensitive : { false, true }) {
+            if ((case_insensitive && !insensitive) || (!case_insensitive && !sensitive))
+                continue;
+            MatchInput input;
+            if (case_insensitive)
+                input.regex_options = AllFlags::Insensitive;
+            for (u32 ch = 0; ch < 256; ++ch) {
+                u32 code_points[] { ch, 0 };
+                input.view = Utf32View { code_points, 2 };
+                state.string_position = 0;
+                if (compare.execute(input, state, output) != ExecutionResult::Continue)
+                    continue;
+                if (state.string_position != 1)
+                    return {};
+                characters.add(ch);
+            }
+        }
+    }
+
+    if (may_match_non_latin1)
+        characters.add_non_latin1();
+    return characters;
+}
+
+static Optional<CharacterSet> first_characters_of_compare(const ByteCode& bytecode, size_t position, Casing casing)
+{
+    if (bytecode[position + 1] == 1 && (CharacterCompareType)bytecode[position + 3] == CharacterCompareType::String) {
+        if (bytecode[position + 4] == 0)
+            return {};
+        u32 ch = bytecode[position + 5];
+        CharacterSet characters;
+        characters.add(ch);
+        if (casing != Casing::Sensitive && ch < 128) {
+            characters.add(tolower(ch));
+            characters.add(toupper(ch));
+        }
+        return characters;
+    }
+    return characters_matched_by_compare(bytecode, position, casing);
+}
+
+// Collects the characters that any path starting at `position` can consume first. If a path can get to
+// the end of the pattern without consuming anything, `can_reach_end` is set.
+// Returns false if we don't know, e.g. because there are assertions or lookarounds in the way.
+static bool collect_first_characters(const ByteCode& bytecode, size_t position, Casing casing, CharacterSet& characters, bool& can_reach_end)
+{
+    Vector<size_t> worklist;
+    Bitmap visited { bytecode.size(), false };
+    worklist.append(position);
+
+    while (!worklist.is_empty()) {
+        auto current = worklist.take_last();
+        if (current >= bytecode.size()) {
+            can_reach_end = true;
+            continue;
+        }
+        if (visited.get(current))
+            continue;
+        visited.set(current, true);
+
+        MatchState state;
+        state.instruction_position = current;
+        auto& opcode = *bytecode.get_opcode(state);
+
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Compare: {
+            auto compare_characters = first_characters_of_compare(bytecode, current, casing);
+            if (!compare_characters.has_value())
+                return false;
+            characters.merge(compare_characters.value());
+            break;
+        }
+        case OpCodeId::PossessiveRepeat: {
+            auto body_characters = characters_matched_by_compare(bytecode, current + 2, casing);
+            if (!body_characters.has_value())
+                return false;
+            characters.merge(body_characters.value());
+            if (to<OpCode_PossessiveRepeat>(opcode).minimum() == 0)
+                worklist.append(current + opcode.size());
+            break;
+        }
+        case OpCodeId::Jump:
+            worklist.append(jump_target(bytecode, current));
+            break;
+        case OpCodeId::ForkJump:
+        case OpCodeId::ForkStay:
+            worklist.append(jump_target(bytecode, current));
+            worklist.append(current + opcode.size());
+            break;
+        case OpCodeId::SaveLeftCaptureGroup:
+        case OpCodeId::SaveRightCaptureGroup:
+        case OpCodeId::SaveLeftNamedCaptureGroup:
+        case OpCodeId::SaveRightNamedCaptureGroup:
+            worklist.append(current + opcode.size());
+            break;
+        case OpCodeId::Exit:
+            can_reach_end = true;
+            break;
+        default:
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool is_literal_character_compare(const ByteCode& bytecode, const Instruction& instruction)
+{
+    return instruction.id == OpCodeId::Compare
+        && bytecode[instruction.position + 1] == 1
+        && (CharacterCompareType)bytecode[instruction.position + 3] == CharacterCompareType::Char
+        && bytecode[instruction.position + 4] < 256;
+}
+
+// Backtracking only gets really expensive with loops that can match the same input in more than one way,
+// which is when there is another fork inside the loop besides the one that makes it loop.
+static bool has_ambiguous_loops(const ByteCode& bytecode)
+{
+    auto maybe_instructions = decode(bytecode);
+    if (!maybe_instructions.has_value())
+        return false;
+    auto& instructions = maybe_instructions.value();
+
+    // forks_before[i] is the number of forks in instructions[0..i).
+    Vector<size_t> forks_before;
+    forks_before.ensure_capacity(instructions.size() + 1);
+    forks_before.append(0);
+    for (auto& instruction : instructions)
+        forks_before.append(forks_before.last() + (instruction.id == OpCodeId::ForkJump || instruction.id == OpCodeId::ForkStay ? 1 : 0));
+
+    auto index_of = [&](size_t position) {
+        size_t index = 0;
+        binary_search(instructions, position, &index, [](size_t position, auto& instruction) {
+            if (position == instruction.position)
+                return 0;
+            return position < instruction.position ? -1 : 1;
+        });
+        return index;
+    };
+
+    for (size_t i = 0; i < instructions.size(); ++i) {
+        if (!is_jump(instructions[i].id))
+            continue;
+        auto target = jump_target(bytecode, instructions[i].position);
+        if (target > instructions[i].position)
+            continue;
+        if (forks_before[i + 1] - forks_before[index_of(target)] > 1)
+            return true;
+    }
+    return false;
+}
+
+// Greedy loops over a single character whose continuation can't start with any character the loop
+// could consume never have to give anything back, so we replace them with a PossessiveRepeat.
+// Runs of single-character compares are fused into one string compare.
+static void rewrite_bytecode(ByteCode& bytecode)
+{
+    auto maybe_instructions = decode(bytecode);
+    if (!maybe_instructions.has_value())
+        return;
+    auto& instructions = maybe_instructions.value();
+
+    // Indexed by bytecode position, with one extra entry for the position just past the end.
+    Bitmap is_instruction_start { bytecode.size() + 1, false };
+    for (auto& instruction : instructions) {
+        // FailForks counts the fork states it discards, so removing forks could change what lookarounds do.
+        if (instruction.id == OpCodeId::FailForks)
+            return;
+        is_instruction_start.set(instruction.position, true);
+    }
+    is_instruction_start.set(bytecode.size(), true);
+
+    Bitmap is_jump_target { bytecode.size() + 1, false };
+    for (auto& instruction : instructions) {
+        if (!is_jump(instruction.id))
+            continue;
+        auto target = jump_target(bytecode, instruction.position);
+        if (target > bytecode.size() || !is_instruction_start.get(target))
+            return;
+        is_jump_target.set(target, true);
+    }
+
+    auto can_be_possessive = [&](size_t compare_position, size_t continuation) {
+        auto loop_characters = characters_matched_by_compare(bytecode, compare_position, Casing::Either);
+        if (!loop_characters.has_value())
+            return false;
+        CharacterSet continuation_characters;
+        bool can_reach_end = false;
+        if (!collect_first_characters(bytecode, continuation, Casing::Either, continuation_characters, can_reach_end))
+            return false;
+        return !loop_characters->intersects(continuation_characters);
+    };
+
+    struct Jump {
+        size_t new_position;
+        size_t old_target;
+    };
+
+    ByteCode new_bytecode;
+    Vector<size_t> new_positions;
+    new_positions.resize(bytecode.size() + 1);
+    Vector<Jump> jumps;
+    bool did_rewrite = false;
+
+    auto append_possessive_repeat = [&](size_t minimum, const Instruction& compare) {
+        new_bytecode.empend((ByteCodeValueType)OpCodeId::PossessiveRepeat);
+        new_bytecode.empend((ByteCodeValueType)minimum);
+        new_bytecode.append(bytecode.data() + compare.position, compare.size);
+    };
+
+    for (size_t i = 0; i < instructions.size(); ++i) {
+        auto& instruction = instructions[i];
+        new_positions[instruction.position] = new_bytecode.size();
+
+        // COMPARE x; FORKJUMP back to the COMPARE (greedy x+)
+        if (i + 1 < instructions.size()
+            && instruction.id == OpCodeId::Compare
+            && instructions[i + 1].id == OpCodeId::ForkJump
+            && jump_target(bytecode, instructions[i + 1].position) == instruction.position
+            && !is_jump_target.get(instructions[i + 1].position)
+            && can_be_possessive(instruction.position, instructions[i + 1].position + instructions[i + 1].size)) {
+            new_positions[instructions[i + 1].position] = new_bytecode.size();
+            append_possessive_repeat(1, instruction);
+            did_rewrite = true;
+            ++i;
+            continue;
+        }
+
+        // FORKSTAY past the loop; COMPARE x; JUMP back to the FORKSTAY (greedy x*)
+        if (i + 2 < instructions.size()
+            && instruction.id == OpCodeId::ForkStay
+            && instructions[i + 1].id == OpCodeId::Compare
+            && instructions[i + 2].id == OpCodeId::Jump
+            && jump_target(bytecode, instruction.position) == instructions[i + 2].position + instructions[i + 2].size
+            && jump_target(bytecode, instructions[i + 2].position) == instruction.position
+            && !is_jump_target.get(instructions[i + 1].position)
+            && !is_jump_target.get(instructions[i + 2].position)
+            && can_be_possessive(instructions[i + 1].position, instructions[i + 2].position + instructions[i + 2].size)) {
+            new_positions[instructions[i + 1].position] = new_bytecode.size();
+            new_positions[instructions[i + 2].position] = new_bytecode.size();
+            append_possessive_repeat(0, instructions[i + 1]);
+            did_rewrite = true;
+            i += 2;
+            continue;
+        }
+
+        if (is_literal_character_compare(bytecode, instruction)) {
+            size_t run_end = i + 1;
+            while (run_end < instructions.size()
+                && is_literal_character_compare(bytecode, instructions[run_end])
+                && !is_jump_target.get(instructions[run_end].position))
+                ++run_end;
+
+            if (run_end - i > 1) {
+                StringBuilder builder;
+                for (size_t j = i; j < run_end; ++j) {
+                    new_positions[instructions[j].position] = new_bytecode.size();
+                    builder.append((char)bytecode[instructions[j].position + 4]);
+                }
+                new_bytecode.insert_bytecode_compare_string(builder.string_view());
+                did_rewrite = true;
+                i = run_end - 1;
+                continue;
+            }
+        }
+
+        if (is_jump(instruction.id))
+            jumps.append({ new_bytecode.size(), jump_target(bytecode, instruction.position) });
+        new_bytecode.append(bytecode.data() + instruction.position, instruction.size);
+    }
+    new_positions[bytecode.size()] = new_bytecode.size();
+
+    if (!did_rewrite)
+        return;
+
+    // Point all jumps at the new locations of their targets.
+    for (auto& jump : jumps) {
+        auto new_target = new_positions[jump.old_target];
+        new_bytecode[jump.new_position + 1] = (ByteCodeValueType)(new_target - (jump.new_position + 2));
+    }
+
+    bytecode = move(new_bytecode);
+}
+
+// Every match has to start with the literal characters the pattern starts with.
+static String literal_prefix(const ByteCode& bytecode)
+{
+    StringBuilder builder;
+    MatchState state;
+    while (state.instruction_position < bytecode.size()) {
+        auto& opcode = *bytecode.get_opcode(state);
+        auto position = state.instruction_position;
+        state.instruction_position += opcode.size();
+
+        switch (opcode.opcode_id()) {
+        case OpCodeId::SaveLeftCaptureGroup:
+        case OpCodeId::SaveRightCaptureGroup:
+        case OpCodeId::SaveLeftNamedCaptureGroup:
+        case OpCodeId::SaveRightNamedCaptureGroup:
+            continue;
+        case OpCodeId::Compare: {
+            if (bytecode[position + 1] != 1)
+                return builder.to_string();
+            auto type = (CharacterCompareType)bytecode[position + 3];
+            if (type == CharacterCompareType::Char) {
+                if (bytecode[position + 4] > 255)
+                    return builder.to_string();
+                builder.append((char)bytecode[position + 4]);
+                continue;
+            }
+            if (type == CharacterCompareType::String) {
+                size_t length = bytecode[position + 4];
+                for (size_t i = 0; i < length; ++i) {
+                    auto ch = bytecode[position + 5 + i];
+                    if (ch > 255)
+                        return builder.to_string();
+                    builder.append((char)ch);
+                }
+                continue;
+            }
+            return builder.to_string();
+        }
+        default:
+            return builder.to_string();
+        }
+    }
+    return builder.to_string();
+}
+
+template<class Parser>
+void Regex<Parser>::run_optimization_passes(AllOptions options)
+{
+    auto& bytecode = parser_result.bytecode;
+    if (bytecode.is_empty())
+        return;
+
+    rewrite_bytecode(bytecode);
+
+    should_match_without_backtracking = has_ambiguous_loops(bytecode) && can_match_without_backtracking(bytecode);
+
+    bool is_insensitive = options.has_flag_set(AllFlags::Insensitive);
+    if (!is_insensitive) {
+        literal_prefix = regex::literal_prefix(bytecode);
+        if (!literal_prefix.is_empty())
+            return;
+    }
+
+    CharacterSet characters;
+    bool can_reach_end = false;
+    if (!collect_first_characters(bytecode, 0, is_insensitive ? Casing::Insensitive : Casing::Sensitive, characters, can_reach_end))
+        return;
+    if (can_reach_end || characters.is_everything())
+        return;
+    first_characters = characters;
+}
+
+template void Regex<PosixExtendedParser>::run_optimization_passes(AllOptions);
+template void Regex<ECMA262Parser>::run_optimization_passes(AllOptions);
+
+}
@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "RegexByteCode.h"
+#include "RegexMatcher.h"
+
+namespace regex {
+
+// This simulates all paths through the bytecode in lockstep, one input character at a time (a "Pike VM").
+// Threads are kept in the order the backtracking matcher would try them, and a thread that reaches an instruction
+// that a preferred thread has already reached at the same position is dropped, as it can't do anything the preferred
+// one can't. That way, we find the same match backtracking would, but in time linear in the length of the input.
+// This only works if the path taken so far can't influence what happens later, so no backreferences or lookarounds.
+
+namespace {
+
+struct Thread {
+    size_t instruction_position { 0 };
+    // How far into a String compare we are, or how many iterations of a PossessiveRepeat we've done (up to its minimum).
+    size_t offset { 0 };
+    size_t start { 0 };
+};
+
+class ThreadList {
+public:
+    explicit ThreadList(size_t bytecode_size)
+    {
+        // Positions past the end of the bytecode are all the same (a match), so they share the last slot.
+        m_generation_for_key.resize(bytecode_size + 1);
+        for (auto& generation : m_generation_for_key)
+            generation = 0;
+    }
+
+    void start_new_generation()
+    {
+        m_threads.clear_with_capacity();
+        ++m_generation;
+    }
+
+    // The offset of a thread is always smaller than the size of its instruction, which makes this key unique.
+    bool mark_visited(const Thread& thread)
+    {
+        auto key = min(thread.instruction_position + thread.offset, m_generation_for_key.size() - 1);
+        if (m_generation_for_key[key] == m_generation)
+            return false;
+        m_generation_for_key[key] = m_generation;
+        return true;
+    }
+
+    Vector<Thread>& threads() { return m_threads; }
+
+private:
+    Vector<Thread> m_threads;
+    Vector<u32> m_generation_for_key;
+    u32 m_generation { 0 };
+};
+
+}
+
+static bool is_string_compare(const ByteCode& bytecode, size_t instruction_position)
+{
+    return bytecode[instruction_position + 1] == 1 && (CharacterCompareType)bytecode[instruction_position + 3] == CharacterCompareType::String;
+}
+
+bool can_match_without_backtracking(const ByteCode& bytecode)
+{
+    MatchState state;
+    while (state.instruction_position < bytecode.size()) {
+        auto* opcode = bytecode.get_opcode(state);
+        if (!opcode)
+            return false;
+
+        switch (opcode->opcode_id()) {
+        case OpCodeId::Compare: {
+            if (is_string_compare(bytecode, state.instruction_position))
+                break;
+            // Everything else has to compare a single character.
+            size_t arguments_count = bytecode[state.instruction_position + 1];
+            size_t offset = state.instruction_position + 3;
+            for (size_t i = 0; i < arguments_count; ++i) {
+                switch ((CharacterCompareType)bytecode[offset++]) {
+                case CharacterCompareType::Inverse:
+                case CharacterCompareType::TemporaryInverse:
+                case CharacterCompareType::AnyChar:
+                    break;
+                case CharacterCompareType::Char:
+                case CharacterCompareType::CharClass:
+                case CharacterCompareType::CharRange:
+                    ++offset;
+                    break;
+                default:
+                    return false;
+                }
+            }
+            break;
+        }
+        case OpCodeId::Jump:
+        case OpCodeId::ForkJump:
+        case OpCodeId::ForkStay:
+        case OpCodeId::SaveLeftCaptureGroup:
+        case OpCodeId::SaveRightCaptureGroup:
+        case OpCodeId::SaveLeftNamedCaptureGroup:
+        case OpCodeId::SaveRightNamedCaptureGroup:
+        case OpCodeId::CheckBegin:
+        case OpCodeId::CheckEnd:
+        case OpCodeId::CheckBoundary:
+        case OpCodeId::PossessiveRepeat:
+            break;
+        default:
+            return false;
+        }
+
+        state.instruction_position += opcode->size();
+    }
+    return state.instruction_position == bytecode.size();
+}
+
+// Adds the thread, and everything that can be reached from it without consuming input, to the list.
+static void add_thread(const ByteCode& bytecode, const MatchInput& input, size_t string_position, ThreadList& list, Vector<Thread>& pending, const Thread& initial_thread)
+{
+    MatchOutput output;
+    pending.append(initial_thread);
+
+    while (!pending.is_empty()) {
+        auto thread = pending.take_last();
+        if (!list.mark_visited(thread))
+            continue;
+
+        if (thread.instruction_position >= bytecode.size()) {
+            list.threads().append(thread);
+            continue;
+        }
+
+        MatchState state;
+        state.instruction_position = thread.instruction_position;
+        state.string_position = string_position;
+        auto& opcode = *bytecode.get_opcode(state);
+        auto next = [&](size_t instruction_position) { return Thread { instruction_position, 0, thread.start }; };
+        auto jump_target = [&] { return thread.instruction_position + opcode.size() + (ssize_t)bytecode[thread.instruction_position + 1]; };
+
+        // NOTE: The pending threads are a stack, so when forking, the preferred thread goes last.
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Compare:
+            if (is_string_compare(bytecode, thread.instruction_position) && bytecode[thread.instruction_position + 4] == 0) {
+                pending.append(next(thread.instruction_position + opcode.size()));
+                break;
+            }
+            list.threads().append(thread);
+            break;
+        case OpCodeId::Jump:
+            pending.append(next(jump_target()));
+            break;
+        case OpCodeId::ForkJump:
+            pending.append(next(thread.instruction_position + opcode.size()));
+            pending.append(next(jump_target()));
+            break;
+        case OpCodeId::ForkStay:
+            pending.append(next(jump_target()));
+            pending.append(next(thread.instruction_position + opcode.size()));
+            break;
+        case OpCodeId::CheckBegin:
+        case OpCodeId::CheckEnd:
+        case OpCodeId::CheckBoundary:
+            if (opcode.execute(input, state, output) == ExecutionResult::Continue)
+                pending.append(next(thread.instruction_position + opcode.size()));
+            break;
+        case OpCodeId::PossessiveRepeat:
+            // Another iteration is preferred, and that's a thread waiting for input.
+            list.threads().append(thread);
+            if (thread.offset >= to<OpCode_PossessiveRepeat>(opcode).minimum())
+                pending.append(next(thread.instruction_position + opcode.size()));
+            break;
+        default:
+            // Capture groups don't matter here.
+            pending.append(next(thread.instruction_position + opcode.size()));
+            break;
+        }
+    }
+}
+
+// Lets a thread that is waiting for input consume the character at `string_position`.
+static void step_thread(const ByteCode& bytecode, const MatchInput& input, size_t string_position, const Thread& thread, ThreadList& list, Vector<Thread>& pending)
+{
+    MatchOutput output;
+    MatchState state;
+    state.instruction_position = thread.instruction_position;
+    state.string_position = string_position;
+    auto& opcode = *bytecode.get_opcode(state);
+
+    if (opcode.opcode_id() == OpCodeId::PossessiveRepeat) {
+        auto minimum = to<OpCode_PossessiveRepeat>(opcode).minimum();
+        MatchState body_state;
+        body_state.instruction_position = thread.instruction_position + 2;
+        body_state.string_position = string_position;
+        auto& body = *bytecode.get_opcode(body_state);
+        if (body.execute(input, body_state, output) == ExecutionResult::Continue)
+            add_thread(bytecode, input, string_position + 1, list, pending, { thread.instruction_position, min(thread.offset + 1, minimum), thread.start });
+        return;
+    }
+
+    VERIFY(opcode.opcode_id() == OpCodeId::Compare);
+    if (is_string_compare(bytecode, thread.instruction_position)) {
+        size_t length = bytecode[thread.instruction_position + 4];
+        u32 expected = bytecode[thread.instruction_position + 5 + thread.offset];
+        u32 ch = input.view[string_position];
+        if (input.regex_options & AllFlags::Insensitive) {
+            expected = tolower(expected);
+            ch = tolower(ch);
+        }
+        if (ch != expected)
+            return;
+        if (thread.offset + 1 < length)
+            add_thread(bytecode, input, string_position + 1, list, pending, { thread.instruction_position, thread.offset + 1, thread.start });
+        else
+            add_thread(bytecode, input, string_position + 1, list, pending, { thread.instruction_position + opcode.size(), 0, thread.start });
+        return;
+    }
+
+    if (opcode.execute(input, state, output) == ExecutionResult::Continue)
+        add_thread(bytecode, input, string_position + 1, list, pending, { thread.instruction_position + opcode.size(), 0, thread.start });
+}
+
+template<class Parser>
+Optional<MatchSpan> Matcher<Parser>::find_match_without_backtracking(const MatchInput& input, size_t start, bool anchored, bool can_skip_start_positions) const
+{
+    auto& bytecode = m_pattern.parser_result.bytecode;
+    auto& view = input.view;
+
+    ThreadList current { bytecode.size() };
+    ThreadList next { bytecode.size() };
+    Vector<Thread> pending;
+    Optional<MatchSpan> match;
+
+    current.start_new_generation();
+    for (size_t string_position = start;; ++string_position) {
+        if (!match.has_value() && (!anchored || string_position == start)) {
+            if (current.threads().is_empty() && can_skip_start_positions && !anchored) {
+                auto next_possible_start = find_next_possible_start(view, string_position);
+                if (!next_possible_start.has_value())
+                    break;
+                if (next_possible_start.value() != string_position) {
+                    string_position = next_possible_start.value();
+                    current.start_new_generation();
+                }
+            }
+            // A thread starting here is less preferred than all the ones that started earlier.
+            add_thread(bytecode, input, string_position, current, pending, { 0, 0, string_position });
+        }
+
+        if (current.threads().is_empty() && (match.has_value() || anchored))
+            break;
+
+        next.start_new_generation();
+        for (auto& thread : current.threads()) {
+            if (thread.instruction_position >= bytecode.size()) {
+                // All the threads after this one are less preferred, so we're done with them.
+                match = MatchSpan { thread.start, string_position };
+                break;
+            }
+            if (string_position < view.length())
+                step_thread(bytecode, input, string_position, thread, next, pending);
+        }
+
+        if (string_position >= view.length())
+            break;
+        swap(current, next);
+    }
+
+    return match;
+}
+
+template Optional<MatchSpan> Matcher<PosixExtendedParser>::find_match_without_backtracking(const MatchInput&, size_t, bool, bool) const;
+template Optional<MatchSpan> Matcher<ECMA262Parser>::find_match_without_backtracking(const MatchInput&, size_t, bool, bool) const;
+
+}
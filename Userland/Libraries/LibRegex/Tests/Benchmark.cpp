@@ -966,4 +966,43 @@ BENCHMARK_CASE(simple_notbol_noteol_benchmark_reference_stdcpp)
 }
 #    endif
 
+#    if defined(REGEX_BENCHMARK_OUR)
+static String make_benchmark_haystack()
+{
+    StringBuilder builder;
+    for (size_t i = 0; i < 1000; ++i)
+        builder.append("The quick brown fox jumps over the lazy dog, 12345 times. ");
+    builder.append("needle in a haystack: 4567.89");
+    return builder.to_string();
+}
+
+BENCHMARK_CASE(literal_prefix_search_benchmark)
+{
+    auto haystack = make_benchmark_haystack();
+    Regex<PosixExtended> re("needle [a-z]+");
+    RegexResult m;
+    for (size_t i = 0; i < BENCHMARK_LOOP_ITERATIONS / 100; ++i)
+        EXPECT_EQ(re.search(haystack, m), true);
+}
+
+BENCHMARK_CASE(first_character_search_benchmark)
+{
+    auto haystack = make_benchmark_haystack();
+    Regex<ECMA262> re("[0-9]+\\.[0-9]+");
+    RegexResult m;
+    for (size_t i = 0; i < BENCHMARK_LOOP_ITERATIONS / 100; ++i)
+        EXPECT_EQ(re.search(haystack, m), true);
+}
+
+BENCHMARK_CASE(possessive_loop_benchmark)
+{
+    Regex<PosixExtended> re("[a-z]+@[a-z]+\\.com");
+    RegexResult m;
+    for (size_t i = 0; i < BENCHMARK_LOOP_ITERATIONS; ++i) {
+        EXPECT_EQ(re.match("someone@example.com", m), true);
+        EXPECT_EQ(re.match("someoneexamplecom", m), false);
+    }
+}
+#    endif
+
 #endif
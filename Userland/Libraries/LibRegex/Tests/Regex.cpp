@@ -595,3 +595,116 @@ TEST_CASE(replace)
         EXPECT_EQ(re.replace(test.subject, test.replacement), test.expected);
     }
 }
+
+TEST_CASE(optimizer_literal_prefix)
+{
+    Regex<PosixExtended> re("hello+ (world|friends)");
+    EXPECT_EQ(re.literal_prefix, "hell");
+
+    RegexResult result;
+    EXPECT_EQ(re.search("oh, hellooo friends and hello world, hell world", result), true);
+    EXPECT_EQ(result.count, 2u);
+    EXPECT_EQ(result.matches.at(0).view, "hellooo friends");
+    EXPECT_EQ(result.matches.at(0).column, 4u);
+    EXPECT_EQ(result.matches.at(1).view, "hello world");
+    EXPECT_EQ(result.matches.at(1).column, 24u);
+
+    Regex<PosixExtended> insensitive_re("hello", PosixFlags::Insensitive);
+    EXPECT(insensitive_re.literal_prefix.is_empty());
+    EXPECT_EQ(insensitive_re.search("Oh, HeLLo", result), true);
+    EXPECT_EQ(result.matches.at(0).column, 4u);
+
+    // Case insensitivity given only at match time must not use the prefix.
+    EXPECT_EQ(re.search("HELLO world", result, PosixFlags::Insensitive), true);
+}
+
+TEST_CASE(optimizer_first_characters)
+{
+    Regex<PosixExtended> re("(foo|[0-9]+)bar");
+    EXPECT(re.literal_prefix.is_empty());
+    EXPECT(re.first_characters.has_value());
+
+    RegexResult result;
+    EXPECT_EQ(re.search("xx foobar 42bar bar 7bar", result), true);
+    EXPECT_EQ(result.count, 3u);
+    EXPECT_EQ(result.matches.at(0).view, "foobar");
+    EXPECT_EQ(result.matches.at(1).view, "42bar");
+    EXPECT_EQ(result.matches.at(2).view, "7bar");
+
+    // Patterns that can match the empty string can start anywhere.
+    Regex<PosixExtended> optional_re("a*");
+    EXPECT(!optional_re.first_characters.has_value());
+}
+
+TEST_CASE(optimizer_possessive_loops)
+{
+    // 'a' can't start the continuation, so the loop never has to backtrack.
+    Regex<PosixExtended> re("a+b");
+    StringBuilder builder;
+    for (size_t i = 0; i < 20000; ++i)
+        builder.append('a');
+    auto long_string = builder.to_string();
+    EXPECT_EQ(re.has_match(long_string), false);
+    EXPECT_EQ(re.has_match(String::formatted("{}b", long_string)), true);
+
+    // These loops do have to give characters back.
+    Regex<PosixExtended> overlapping_re("a*ab");
+    EXPECT_EQ(overlapping_re.match("aaab").success, true);
+    Regex<ECMA262> insensitive_re("[a-z]+A", ECMAScriptFlags::Insensitive);
+    EXPECT_EQ(insensitive_re.match("abcA").success, true);
+    EXPECT_EQ(insensitive_re.match("abca").success, true);
+    Regex<ECMA262> classes_re("\\w*\\d");
+    EXPECT_EQ(classes_re.match("abc1").success, true);
+}
+
+TEST_CASE(match_without_backtracking)
+{
+    StringBuilder builder;
+    for (size_t i = 0; i < 10000; ++i)
+        builder.append("ab");
+    auto long_string = builder.to_string();
+
+    // Searching for this by backtracking takes time quadratic in the length of the input.
+    Regex<PosixExtended> re("(a|b)*c");
+    EXPECT(re.should_match_without_backtracking);
+    EXPECT_EQ(re.search(long_string, PosixFlags::Global).success, false);
+    auto result = re.search(String::formatted("xx{}c", long_string), PosixFlags::Global);
+    EXPECT_EQ(result.success, true);
+    EXPECT_EQ(result.count, 1u);
+    EXPECT_EQ(result.matches.at(0).view.length(), long_string.length() + 1);
+    EXPECT_EQ(result.capture_group_matches.at(0).at(0).view, "b");
+
+    // Long inputs don't run out of stack.
+    Regex<PosixExtended> loop_re("(a|b)*");
+    EXPECT_EQ(loop_re.match(long_string).success, true);
+
+    // Empty loops don't go on forever.
+    Regex<PosixExtended> empty_loop_re("(a*)*b");
+    EXPECT_EQ(empty_loop_re.match("aaab").success, true);
+    EXPECT_EQ(empty_loop_re.match("aaaa").success, false);
+}
+
+TEST_CASE(backtracking_without_progress)
+{
+    // The backreferences keep these on the backtracking matcher.
+    StringBuilder builder;
+    for (size_t i = 0; i < 10000; ++i)
+        builder.append("ab");
+    auto long_string = builder.to_string();
+
+    // Thousands of states are pushed here, but each one after consuming some input.
+    Regex<ECMA262> loop_re("(a|b)*\\1");
+    EXPECT(!loop_re.should_match_without_backtracking);
+    EXPECT_EQ(loop_re.match(String::formatted("{}b", long_string)).success, true);
+    Regex<ECMA262> lazy_loop_re("(a|b)*?c\\1");
+    EXPECT_EQ(lazy_loop_re.match(String::formatted("{}cb", long_string)).success, true);
+
+    // Empty loops make the current path fail rather than go on forever, and the alternatives are still tried.
+    Regex<ECMA262> empty_loop_re("(a*)*b\\1");
+    EXPECT(!empty_loop_re.should_match_without_backtracking);
+    EXPECT_EQ(empty_loop_re.match("aaab").success, true);
+    Regex<ECMA262> nested_empty_loop_re("(?:(a?)*)*?(b)\\2");
+    EXPECT_EQ(nested_empty_loop_re.match("aabb").success, true);
+    Regex<ECMA262> alternating_empty_loop_re("(?:a*|b*)*(c)\\1");
+    EXPECT_EQ(alternating_empty_loop_re.match("ababcc").success, true);
+}
@@ -20,8 +20,9 @@ LibThread::Thread::Thread(Function<intptr_t()> action, StringView thread_name)
 
 LibThread::Thread::~Thread()
 {
+    // NOTE: m_tid is only cleared by join(), so that a thread which has already finished can still be joined.
     if (m_tid) {
-        dbgln("Destroying thread \"{}\"({}) while it is still running!", m_thread_name, m_tid);
+        dbgln("Destroying thread \"{}\"({}) that has not been joined yet, joining it now", m_thread_name, m_tid);
         [[maybe_unused]] auto res = join();
     }
 }
@@ -34,7 +35,6 @@ void LibThread::Thread::start()
         [](void* arg) -> void* {
             Thread* self = static_cast<Thread*>(arg);
             auto exit_code = self->m_action();
-            self->m_tid = 0;
             return reinterpret_cast<void*>(exit_code);
         },
         static_cast<void*>(this));
@@ -6,21 +6,23 @@
 
 #pragma once
 
-#include <AK/HashMap.h>
-#include <LibWeb/CSS/StyleResolver.h>
-#include <LibWeb/DOM/Document.h>
-#include <LibWeb/DOM/Element.h>
+#include <AK/FlyString.h>
+#include <AK/String.h>
+#include <LibWeb/Forward.h>
 
 namespace Web::CSS {
 
+// Marks the elements whose style may change because of an attribute change on an element.
+// Construct it before the attribute changes; the elements are marked when it goes out of scope.
 class StyleInvalidator {
 public:
-    explicit StyleInvalidator(DOM::Document&);
+    StyleInvalidator(DOM::Element&, const FlyString& attribute_name);
     ~StyleInvalidator();
 
 private:
-    DOM::Document& m_document;
-    HashMap<DOM::Element*, Vector<MatchingRule>> m_elements_and_matching_rules_before;
+    DOM::Element& m_element;
+    FlyString m_attribute_name;
+    String m_old_value;
 };
 
 }
@@ -14,6 +14,7 @@
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
 #include <LibWeb/Dump.h>
+#include <LibWeb/HTML/AttributeNames.h>
 #include <ctype.h>
 #include <stdio.h>
 
@@ -61,9 +62,50 @@ void StyleResolver::for_each_stylesheet(Callback callback) const
     }
 }
 
-Vector<MatchingRule> StyleResolver::collect_matching_rules(const DOM::Element& element) const
+void StyleResolver::invalidate_rule_cache()
 {
-    Vector<MatchingRule> matching_rules;
+    m_rule_cache = nullptr;
+}
+
+void StyleResolver::add_selector_to_invalidation_scopes(const Selector& selector, RuleCache& cache)
+{
+    auto& complex_selectors = selector.complex_selectors();
+    for (size_t i = 0; i < complex_selectors.size(); ++i) {
+        // A compound selector left of a combinator is matched against an ancestor or a preceding
+        // sibling of the element the selector applies to.
+        StyleInvalidationScope scope;
+        if (i + 1 < complex_selectors.size()) {
+            auto relation = complex_selectors[i + 1].relation;
+            if (relation == Selector::ComplexSelector::Relation::AdjacentSibling || relation == Selector::ComplexSelector::Relation::GeneralSibling)
+                scope.following_siblings = true;
+            else
+                scope.descendants = true;
+        }
+
+        for (auto& simple_selector : complex_selectors[i].compound_selector) {
+            if (simple_selector.type == Selector::SimpleSelector::Type::Id)
+                cache.invalidation_scopes_by_id.ensure(simple_selector.value).merge(scope);
+            else if (simple_selector.type == Selector::SimpleSelector::Type::Class)
+                cache.invalidation_scopes_by_class.ensure(simple_selector.value).merge(scope);
+            if (simple_selector.attribute_match_type != Selector::SimpleSelector::AttributeMatchType::None)
+                cache.invalidation_scopes_by_attribute.ensure(simple_selector.attribute_name).merge(scope);
+            if (simple_selector.pseudo_class == Selector::SimpleSelector::PseudoClass::Link) {
+                // :link also matches everything inside an <a> element with an href attribute (see Node::is_link()),
+                // so changing the href of an element can change which of its descendants match.
+                auto link_scope = scope;
+                link_scope.descendants = true;
+                cache.invalidation_scopes_by_attribute.ensure(HTML::AttributeNames::href).merge(link_scope);
+            }
+        }
+    }
+}
+
+const StyleResolver::RuleCache& StyleResolver::rule_cache() const
+{
+    if (m_rule_cache)
+        return *m_rule_cache;
+
+    m_rule_cache = make<RuleCache>();
 
     size_t style_sheet_index = 0;
     for_each_stylesheet([&](auto& sheet) {
@@ -73,17 +115,110 @@ Vector<MatchingRule> StyleResolver::collect_matching_rules(const DOM::Element& e
         static_cast<const CSSStyleSheet&>(sheet).for_each_effective_style_rule([&](auto& rule) {
             size_t selector_index = 0;
             for (auto& selector : rule.selectors()) {
-                if (SelectorEngine::matches(selector, element)) {
-                    matching_rules.append({ rule, style_sheet_index, rule_index, selector_index });
-                    break;
-                }
+                MatchingRule matching_rule { rule, style_sheet_index, rule_index, selector_index };
                 ++selector_index;
+
+                add_selector_to_invalidation_scopes(selector, *m_rule_cache);
+
+                if (selector.complex_selectors().is_empty()) {
+                    m_rule_cache->other_rules.append(move(matching_rule));
+                    continue;
+                }
+
+                // Ids are the most selective, followed by classes and tag names.
+                const Selector::SimpleSelector* class_selector = nullptr;
+                const Selector::SimpleSelector* tag_name_selector = nullptr;
+                bool added_to_bucket = false;
+                for (auto& simple_selector : selector.complex_selectors().last().compound_selector) {
+                    if (simple_selector.type == Selector::SimpleSelector::Type::Id) {
+                        m_rule_cache->rules_by_id.ensure(simple_selector.value).append(move(matching_rule));
+                        added_to_bucket = true;
+                        break;
+                    }
+                    if (simple_selector.type == Selector::SimpleSelector::Type::Class && !class_selector)
+                        class_selector = &simple_selector;
+                    else if (simple_selector.type == Selector::SimpleSelector::Type::TagName && !tag_name_selector)
+                        tag_name_selector = &simple_selector;
+                }
+                if (added_to_bucket)
+                    continue;
+
+                if (class_selector)
+                    m_rule_cache->rules_by_class.ensure(class_selector->value).append(move(matching_rule));
+                else if (tag_name_selector)
+                    m_rule_cache->rules_by_tag_name.ensure(tag_name_selector->value).append(move(matching_rule));
+                else
+                    m_rule_cache->other_rules.append(move(matching_rule));
             }
             ++rule_index;
         });
         ++style_sheet_index;
     });
 
+    return *m_rule_cache;
+}
+
+StyleInvalidationScope StyleResolver::invalidation_scope_for_id(const FlyString& id) const
+{
+    return rule_cache().invalidation_scopes_by_id.get(id).value_or({});
+}
+
+StyleInvalidationScope StyleResolver::invalidation_scope_for_class(const FlyString& class_name) const
+{
+    return rule_cache().invalidation_scopes_by_class.get(class_name).value_or({});
+}
+
+StyleInvalidationScope StyleResolver::invalidation_scope_for_attribute(const FlyString& attribute_name) const
+{
+    return rule_cache().invalidation_scopes_by_attribute.get(attribute_name).value_or({});
+}
+
+Vector<MatchingRule> StyleResolver::collect_matching_rules(const DOM::Element& element) const
+{
+    auto& cache = rule_cache();
+    Vector<MatchingRule> matching_rules;
+
+    auto add_rules_that_match = [&](auto& candidates) {
+        for (auto& candidate : candidates) {
+            if (SelectorEngine::matches(candidate.rule->selectors()[candidate.selector_index], element))
+                matching_rules.append(candidate);
+        }
+    };
+
+    if (auto id = element.attribute(HTML::AttributeNames::id); !id.is_null()) {
+        if (auto it = cache.rules_by_id.find(id); it != cache.rules_by_id.end())
+            add_rules_that_match(it->value);
+    }
+    for (auto& class_name : element.class_names()) {
+        if (auto it = cache.rules_by_class.find(class_name); it != cache.rules_by_class.end())
+            add_rules_that_match(it->value);
+    }
+    if (auto it = cache.rules_by_tag_name.find(element.local_name()); it != cache.rules_by_tag_name.end())
+        add_rules_that_match(it->value);
+    add_rules_that_match(cache.other_rules);
+
+    // Bring the matches back into document order. A rule that matches through more than
+    // one of its selectors is only applied once, through the first of them.
+    quick_sort(matching_rules, [](auto& a, auto& b) {
+        if (a.style_sheet_index != b.style_sheet_index)
+            return a.style_sheet_index < b.style_sheet_index;
+        if (a.rule_index != b.rule_index)
+            return a.rule_index < b.rule_index;
+        return a.selector_index < b.selector_index;
+    });
+    size_t unique_count = 0;
+    for (size_t i = 0; i < matching_rules.size(); ++i) {
+        if (unique_count > 0) {
+            auto& previous = matching_rules[unique_count - 1];
+            if (previous.style_sheet_index == matching_rules[i].style_sheet_index && previous.rule_index == matching_rules[i].rule_index)
+                continue;
+        }
+        if (unique_count != i)
+            matching_rules[unique_count] = matching_rules[i];
+        ++unique_count;
+    }
+    matching_rules.shrink(unique_count);
+
     return matching_rules;
 }
 
@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <AK/FlyString.h>
+#include <AK/HashMap.h>
 #include <AK/NonnullRefPtrVector.h>
 #include <AK/OwnPtr.h>
 #include <LibWeb/CSS/StyleProperties.h>
@@ -20,6 +22,19 @@ struct MatchingRule {
     size_t selector_index { 0 };
 };
 
+// The elements other than the changed element itself whose style may be affected
+// when an id, class or attribute on an element changes.
+struct StyleInvalidationScope {
+    bool descendants { false };
+    bool following_siblings { false };
+
+    void merge(const StyleInvalidationScope& other)
+    {
+        descendants |= other.descendants;
+        following_siblings |= other.following_siblings;
+    }
+};
+
 class StyleResolver {
 public:
     explicit StyleResolver(DOM::Document&);
@@ -35,11 +50,35 @@ public:
 
     static bool is_inherited_property(CSS::PropertyID);
 
+    // Must be called whenever the set of style rules that apply to the document changes.
+    void invalidate_rule_cache();
+
+    StyleInvalidationScope invalidation_scope_for_id(const FlyString&) const;
+    StyleInvalidationScope invalidation_scope_for_class(const FlyString&) const;
+    StyleInvalidationScope invalidation_scope_for_attribute(const FlyString&) const;
+
 private:
     template<typename Callback>
     void for_each_stylesheet(Callback) const;
 
+    // Every selector is filed under one of the ids, classes or tag names that its rightmost
+    // compound selector requires, so that only a few rules have to be tested per element.
+    struct RuleCache {
+        HashMap<FlyString, Vector<MatchingRule>> rules_by_id;
+        HashMap<FlyString, Vector<MatchingRule>> rules_by_class;
+        HashMap<FlyString, Vector<MatchingRule>> rules_by_tag_name;
+        Vector<MatchingRule> other_rules;
+
+        HashMap<FlyString, StyleInvalidationScope> invalidation_scopes_by_id;
+        HashMap<FlyString, StyleInvalidationScope> invalidation_scopes_by_class;
+        HashMap<FlyString, StyleInvalidationScope> invalidation_scopes_by_attribute;
+    };
+
+    const RuleCache& rule_cache() const;
+    static void add_selector_to_invalidation_scopes(const Selector&, RuleCache&);
+
     DOM::Document& m_document;
+    mutable OwnPtr<RuleCache> m_rule_cache;
 };
 
 }
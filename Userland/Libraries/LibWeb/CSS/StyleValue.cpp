@@ -10,7 +10,6 @@
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/InProcessWebView.h>
 #include <LibWeb/Loader/LoadRequest.h>
-#include <LibWeb/Loader/ResourceLoader.h>
 #include <LibWeb/Page/Frame.h>
 
 namespace Web::CSS {
@@ -156,14 +155,18 @@ ImageStyleValue::ImageStyleValue(const URL& url, DOM::Document& document)
     , m_document(document)
 {
     auto request = LoadRequest::create_for_url_on_page(url, document.page());
-    set_resource(ResourceLoader::the().load_resource(Resource::Type::Image, request));
+    set_resource(document.load_resource(Resource::Type::Image, request));
 }
 
 void ImageStyleValue::resource_did_load()
+{
+    resource()->decode_if_needed();
+}
+
+void ImageStyleValue::resource_did_decode()
 {
     if (!m_document)
         return;
-    m_bitmap = resource()->bitmap();
     // FIXME: Do less than a full repaint if possible?
     if (m_document->frame())
         m_document->frame()->set_needs_display({});
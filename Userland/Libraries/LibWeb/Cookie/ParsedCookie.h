@@ -26,6 +26,9 @@ struct ParsedCookie {
 
 Optional<ParsedCookie> parse_cookie(const String& cookie_string);
 
+// Also used for HTTP dates, since this is more lenient than (but compatible with) their grammar.
+Optional<Core::DateTime> parse_date_time(StringView date_string);
+
 }
 
 namespace IPC {
@@ -6,6 +6,7 @@
 
 #include <LibWeb/DOM/CharacterData.h>
 #include <LibWeb/DOM/Document.h>
+#include <LibWeb/Layout/Node.h>
 
 namespace Web::DOM {
 
@@ -24,6 +25,12 @@ void CharacterData::set_data(String data)
     if (m_data == data)
         return;
     m_data = move(data);
+    // Text nodes read their text again when laid out, so the existing layout node can be reused.
+    if (layout_node()) {
+        layout_node()->set_needs_layout();
+        document().schedule_layout_update();
+        return;
+    }
     // FIXME: This is definitely too aggressive.
     document().schedule_forced_layout();
 }
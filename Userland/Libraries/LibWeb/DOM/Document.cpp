@@ -43,6 +43,7 @@
 #include <LibWeb/Layout/BlockFormattingContext.h>
 #include <LibWeb/Layout/InitialContainingBlockBox.h>
 #include <LibWeb/Layout/TreeBuilder.h>
+#include <LibWeb/Loader/ResourceLoader.h>
 #include <LibWeb/Namespace.h>
 #include <LibWeb/Origin.h>
 #include <LibWeb/Page/Frame.h>
@@ -64,6 +65,10 @@ Document::Document(const URL& url)
         update_style();
     });
 
+    m_layout_update_timer = Core::Timer::create_single_shot(0, [this] {
+        update_layout();
+    });
+
     m_forced_layout_timer = Core::Timer::create_single_shot(0, [this] {
         force_layout();
     });
@@ -145,6 +150,13 @@ void Document::schedule_style_update()
     m_style_update_timer->start();
 }
 
+void Document::schedule_layout_update()
+{
+    if (m_layout_update_timer->is_active())
+        return;
+    m_layout_update_timer->start();
+}
+
 void Document::schedule_forced_layout()
 {
     if (m_forced_layout_timer->is_active())
@@ -388,6 +400,26 @@ void Document::force_layout()
     update_layout();
 }
 
+// Returns false if something outside of a layout boundary needs layout.
+static bool collect_dirty_layout_boundaries(Layout::Node& node, Vector<Layout::Box*>& boundaries)
+{
+    if (node.needs_layout())
+        return false;
+    if (!node.child_needs_layout())
+        return true;
+    for (auto* child = node.first_child(); child; child = child->next_sibling()) {
+        if (!child->needs_layout() && !child->child_needs_layout())
+            continue;
+        if (!child->needs_layout() && is<Layout::Box>(*child) && downcast<Layout::Box>(*child).is_layout_boundary()) {
+            boundaries.append(downcast<Layout::Box>(child));
+            continue;
+        }
+        if (!collect_dirty_layout_boundaries(*child, boundaries))
+            return false;
+    }
+    return true;
+}
+
 void Document::update_layout()
 {
     if (!frame())
@@ -398,8 +430,33 @@ void Document::update_layout()
         m_layout_root = static_ptr_cast<Layout::InitialContainingBlockBox>(tree_builder.build(*this));
     }
 
+    auto viewport_size = frame()->viewport_rect().size();
+    if (viewport_size != m_last_layout_viewport_size) {
+        m_last_layout_viewport_size = viewport_size;
+        m_layout_root->set_needs_layout();
+    }
+
+    if (!m_layout_root->needs_layout() && !m_layout_root->child_needs_layout())
+        return;
+
+    // When everything that changed is inside layout boundaries, only those boundaries are laid out again.
+    // Nothing outside of them can move, so there's no need to tell the page client about it either.
+    Vector<Layout::Box*> dirty_layout_boundaries;
+    if (collect_dirty_layout_boundaries(*m_layout_root, dirty_layout_boundaries)) {
+        for (auto* boundary : dirty_layout_boundaries) {
+            Layout::BlockFormattingContext context(*boundary, nullptr);
+            context.run(*boundary, Layout::LayoutMode::Default);
+            boundary->set_needs_display();
+        }
+        m_layout_root->did_layout_subtree();
+        m_layout_root->stacking_context()->invalidate_display_list();
+        return;
+    }
+
     Layout::BlockFormattingContext root_formatting_context(*m_layout_root, nullptr);
     root_formatting_context.run(*m_layout_root, Layout::LayoutMode::Default);
+    m_layout_root->did_layout_subtree();
+    m_layout_root->stacking_context()->invalidate_display_list();
 
     m_layout_root->set_needs_display();
 
@@ -486,6 +543,55 @@ void Document::set_hovered_node(Node* node)
     invalidate_style();
 }
 
+RefPtr<Element> Document::get_element_by_id(const FlyString& id) const
+{
+    auto it = m_elements_by_id.find(id);
+    if (it == m_elements_by_id.end())
+        return nullptr;
+
+    // If several elements share the id, the first one in tree order wins.
+    auto& elements = it->value;
+    Element* first_element = elements.first();
+    for (size_t i = 1; i < elements.size(); ++i) {
+        if (elements[i]->is_before(*first_element))
+            first_element = elements[i];
+    }
+    return first_element;
+}
+
+void Document::add_element_with_id(Badge<Element>, const FlyString& id, Element& element)
+{
+    auto& elements = m_elements_by_id.ensure(id);
+    VERIFY(!elements.contains_slow(&element));
+    elements.append(&element);
+}
+
+void Document::remove_element_with_id(Badge<Element>, const FlyString& id, Element& element)
+{
+    auto it = m_elements_by_id.find(id);
+    if (it == m_elements_by_id.end())
+        return;
+    it->value.remove_first_matching([&](auto* entry) { return entry == &element; });
+    if (it->value.is_empty())
+        m_elements_by_id.remove(it);
+}
+
+RefPtr<Resource> Document::load_resource(Resource::Type type, const LoadRequest& request)
+{
+    // Like the "list of available images" in the HTML spec, but for all subresources: a page that uses an image
+    // many times only loads it once, even if the HTTP cache would have to revalidate it for every use.
+    if (auto it = m_resources.find(request); it != m_resources.end()) {
+        auto& resource = it->value;
+        if (resource->type() == type && !resource->is_failed())
+            return resource;
+    }
+
+    auto resource = ResourceLoader::the().load_resource(type, request);
+    if (resource)
+        m_resources.set(request, *resource);
+    return resource;
+}
+
 NonnullRefPtr<HTMLCollection> Document::get_elements_by_name(String const& name)
 {
     return HTMLCollection::create(*this, [name](Element const& element) {
@@ -597,14 +703,21 @@ JS::Interpreter& Document::interpreter()
 JS::Value Document::run_javascript(const StringView& source, const StringView& filename)
 {
     auto parser = JS::Parser(JS::Lexer(source, filename));
+    // Most functions in a page's scripts are never called, so don't spend time building their AST up front.
+    parser.set_lazy_function_parsing_enabled(true);
     auto program = parser.parse_program();
     if (parser.has_errors()) {
         parser.print_errors();
         return JS::js_undefined();
     }
+    return run_javascript(*program);
+}
+
+JS::Value Document::run_javascript(JS::Program& program)
+{
     auto& interpreter = document().interpreter();
     auto& vm = interpreter.vm();
-    interpreter.run(interpreter.global_object(), *program);
+    interpreter.run(interpreter.global_object(), program);
     if (vm.exception())
         vm.clear_exception();
     return vm.last_value();
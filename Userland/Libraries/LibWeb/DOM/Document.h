@@ -14,6 +14,7 @@
 #include <AK/URL.h>
 #include <AK/WeakPtr.h>
 #include <LibCore/Forward.h>
+#include <LibGfx/Size.h>
 #include <LibJS/Forward.h>
 #include <LibWeb/Bindings/ScriptExecutionContext.h>
 #include <LibWeb/Bindings/WindowObject.h>
@@ -26,6 +27,8 @@
 #include <LibWeb/DOM/NonElementParentNode.h>
 #include <LibWeb/DOM/ParentNode.h>
 #include <LibWeb/HTML/HTMLScriptElement.h>
+#include <LibWeb/Loader/LoadRequest.h>
+#include <LibWeb/Loader/Resource.h>
 
 namespace Web::DOM {
 
@@ -134,8 +137,23 @@ public:
     Layout::InitialContainingBlockBox* layout_node();
 
     void schedule_style_update();
+    void schedule_layout_update();
     void schedule_forced_layout();
 
+    // Finds the element through a map kept up to date as elements with an id enter or leave the document tree.
+    RefPtr<Element> get_element_by_id(const FlyString& id) const;
+    void add_element_with_id(Badge<Element>, const FlyString& id, Element&);
+    void remove_element_with_id(Badge<Element>, const FlyString& id, Element&);
+
+    // Incremented on every change to the DOM tree or to an element's attributes,
+    // so that things computed from the tree (like HTMLCollection contents) know when they're stale.
+    u64 dom_tree_version() const { return m_dom_tree_version; }
+    void bump_dom_tree_version() { ++m_dom_tree_version; }
+
+    // Loads a subresource through the ResourceLoader. Every use of the same request in this document
+    // gets the same resource, whether or not the cached response is still fresh.
+    RefPtr<Resource> load_resource(Resource::Type, const LoadRequest&);
+
     NonnullRefPtr<HTMLCollection> get_elements_by_name(String const&);
     NonnullRefPtr<HTMLCollection> get_elements_by_tag_name(FlyString const&);
     NonnullRefPtr<HTMLCollection> get_elements_by_class_name(FlyString const&);
@@ -149,6 +167,7 @@ public:
     virtual JS::Interpreter& interpreter() override;
 
     JS::Value run_javascript(const StringView& source, const StringView& filename = "(unknown)");
+    JS::Value run_javascript(JS::Program&);
 
     NonnullRefPtr<Element> create_element(const String& tag_name);
     NonnullRefPtr<Element> create_element_ns(const String& namespace_, const String& qualifed_name);
@@ -170,7 +189,11 @@ public:
 
     QuirksMode mode() const { return m_quirks_mode; }
     bool in_quirks_mode() const { return m_quirks_mode == QuirksMode::Yes; }
-    void set_quirks_mode(QuirksMode mode) { m_quirks_mode = mode; }
+    void set_quirks_mode(QuirksMode mode)
+    {
+        m_quirks_mode = mode;
+        m_style_resolver->invalidate_rule_cache();
+    }
 
     void adopt_node(Node&);
     ExceptionOr<NonnullRefPtr<Node>> adopt_node_binding(NonnullRefPtr<Node>);
@@ -285,8 +308,11 @@ private:
     Optional<Color> m_visited_link_color;
 
     RefPtr<Core::Timer> m_style_update_timer;
+    RefPtr<Core::Timer> m_layout_update_timer;
     RefPtr<Core::Timer> m_forced_layout_timer;
 
+    Gfx::IntSize m_last_layout_viewport_size;
+
     String m_source;
 
     OwnPtr<JS::Interpreter> m_interpreter;
@@ -315,6 +341,12 @@ private:
     bool m_should_invalidate_styles_on_attribute_changes { true };
 
     u32 m_ignore_destructive_writes_counter { 0 };
+
+    // Usually there's only one element per id, but documents aren't required to be valid.
+    HashMap<FlyString, Vector<Element*, 1>> m_elements_by_id;
+    u64 m_dom_tree_version { 0 };
+
+    HashMap<LoadRequest, NonnullRefPtr<Resource>> m_resources;
 };
 
 }
@@ -71,22 +71,60 @@ ExceptionOr<void> Element::set_attribute(const FlyString& name, const String& va
     if (name.is_empty())
         return InvalidCharacterError::create("Attribute name must not be empty");
 
-    CSS::StyleInvalidator style_invalidator(document());
+    CSS::StyleInvalidator style_invalidator(*this, name);
+
+    bool is_id_in_document_tree = name == HTML::AttributeNames::id && is_in_document_tree();
+    if (is_id_in_document_tree) {
+        if (auto old_id = attribute(HTML::AttributeNames::id); !old_id.is_empty())
+            document().remove_element_with_id({}, old_id, *this);
+    }
 
     if (auto* attribute = find_attribute(name))
         attribute->set_value(value);
     else
         m_attributes.empend(name, value);
 
+    if (is_id_in_document_tree && !value.is_empty())
+        document().add_element_with_id({}, value, *this);
+
+    document().bump_dom_tree_version();
     parse_attribute(name, value);
     return {};
 }
 
 void Element::remove_attribute(const FlyString& name)
 {
-    CSS::StyleInvalidator style_invalidator(document());
+    CSS::StyleInvalidator style_invalidator(*this, name);
+
+    if (name == HTML::AttributeNames::id && is_in_document_tree()) {
+        if (auto id = attribute(HTML::AttributeNames::id); !id.is_empty())
+            document().remove_element_with_id({}, id, *this);
+    }
 
     m_attributes.remove_first_matching([&](auto& attribute) { return attribute.name() == name; });
+    if (name == HTML::AttributeNames::class_)
+        m_classes.clear();
+    document().bump_dom_tree_version();
+}
+
+void Element::inserted()
+{
+    Node::inserted();
+
+    if (is_in_document_tree()) {
+        if (auto id = attribute(HTML::AttributeNames::id); !id.is_empty())
+            document().add_element_with_id({}, id, *this);
+    }
+}
+
+void Element::removed_from(Node* old_parent)
+{
+    Node::removed_from(old_parent);
+
+    // NOTE: By now we're no longer in the tree, so we can't tell whether we used to be in the document tree.
+    //       Removing an element that isn't in the map is harmless though.
+    if (auto id = attribute(HTML::AttributeNames::id); !id.is_empty())
+        document().remove_element_with_id({}, id, *this);
 }
 
 bool Element::has_class(const FlyString& class_name, CaseSensitivity case_sensitivity) const
@@ -167,24 +205,51 @@ enum class StyleDifference {
     None,
     NeedsRepaint,
     NeedsRelayout,
+    NeedsLayoutTreeRebuild,
 };
 
+static bool differs_in_properties_other_than_colors(const CSS::StyleProperties& old_style, const CSS::StyleProperties& new_style)
+{
+    bool differs = false;
+    auto compare = [&](const CSS::StyleProperties& style, const CSS::StyleProperties& other_style) {
+        style.for_each_property([&](auto property_id, auto& value) {
+            if (differs || property_id == CSS::PropertyID::Color || property_id == CSS::PropertyID::BackgroundColor)
+                return;
+            auto other_value = other_style.property(property_id);
+            if (!other_value.has_value() || other_value.value()->type() != value.type() || *other_value.value() != value)
+                differs = true;
+        });
+    };
+    compare(old_style, new_style);
+    compare(new_style, old_style);
+    return differs;
+}
+
 static StyleDifference compute_style_difference(const CSS::StyleProperties& old_style, const CSS::StyleProperties& new_style, const Document& document)
 {
     if (old_style == new_style)
         return StyleDifference::None;
 
+    // These decide which kind of layout node is created and how the stacking contexts are built,
+    // which only happens when building the layout tree.
+    if (new_style.display() != old_style.display()
+        || new_style.position() != old_style.position()
+        || new_style.float_() != old_style.float_()
+        || new_style.z_index() != old_style.z_index())
+        return StyleDifference::NeedsLayoutTreeRebuild;
+
     bool needs_repaint = false;
     bool needs_relayout = false;
 
-    if (new_style.display() != old_style.display())
-        needs_relayout = true;
-
     if (new_style.color_or_fallback(CSS::PropertyID::Color, document, Color::Black) != old_style.color_or_fallback(CSS::PropertyID::Color, document, Color::Black))
         needs_repaint = true;
     else if (new_style.color_or_fallback(CSS::PropertyID::BackgroundColor, document, Color::Black) != old_style.color_or_fallback(CSS::PropertyID::BackgroundColor, document, Color::Black))
         needs_repaint = true;
 
+    // Anything else that changed may affect the geometry of the box.
+    if (differs_in_properties_other_than_colors(old_style, new_style))
+        needs_relayout = true;
+
     if (needs_relayout)
         return StyleDifference::NeedsRelayout;
     if (needs_repaint)
@@ -205,19 +270,26 @@ void Element::recompute_style()
         // We need a new layout tree here!
         Layout::TreeBuilder tree_builder;
         tree_builder.build(*this);
+        if (layout_node())
+            layout_node()->set_needs_layout();
         return;
     }
 
-    auto diff = StyleDifference::NeedsRelayout;
+    auto diff = StyleDifference::NeedsLayoutTreeRebuild;
     if (old_specified_css_values)
         diff = compute_style_difference(*old_specified_css_values, *new_specified_css_values, document());
     if (diff == StyleDifference::None)
         return;
     layout_node()->apply_style(*new_specified_css_values);
-    if (diff == StyleDifference::NeedsRelayout) {
+    if (diff == StyleDifference::NeedsLayoutTreeRebuild) {
         document().schedule_forced_layout();
         return;
     }
+    if (diff == StyleDifference::NeedsRelayout) {
+        layout_node()->set_needs_layout();
+        document().schedule_layout_update();
+        return;
+    }
     if (diff == StyleDifference::NeedsRepaint) {
         layout_node()->set_needs_display();
     }
@@ -92,10 +92,15 @@ public:
 protected:
     RefPtr<Layout::Node> create_layout_node() override;
 
+    virtual void inserted() override;
+    virtual void removed_from(Node*) override;
+
 private:
     Attribute* find_attribute(const FlyString& name);
     const Attribute* find_attribute(const FlyString& name) const;
 
+    bool is_in_document_tree() const { return root()->is_document(); }
+
     QualifiedName m_qualified_name;
     Vector<Attribute> m_attributes;
 
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
 #include <LibWeb/DOM/HTMLCollection.h>
 #include <LibWeb/DOM/ParentNode.h>
@@ -31,14 +32,24 @@ Vector<NonnullRefPtr<Element>> HTMLCollection::collect_matching_elements()
     return elements;
 }
 
+Vector<NonnullRefPtr<Element>>& HTMLCollection::matching_elements()
+{
+    auto dom_tree_version = m_root->document().dom_tree_version();
+    if (!m_cached_dom_tree_version.has_value() || *m_cached_dom_tree_version != dom_tree_version) {
+        m_cached_elements = collect_matching_elements();
+        m_cached_dom_tree_version = dom_tree_version;
+    }
+    return m_cached_elements;
+}
+
 size_t HTMLCollection::length()
 {
-    return collect_matching_elements().size();
+    return matching_elements().size();
 }
 
 Element* HTMLCollection::item(size_t index)
 {
-    auto elements = collect_matching_elements();
+    auto& elements = matching_elements();
     if (index >= elements.size())
         return nullptr;
     return elements[index];
@@ -48,7 +59,7 @@ Element* HTMLCollection::named_item(FlyString const& name)
 {
     if (name.is_null())
         return nullptr;
-    auto elements = collect_matching_elements();
+    auto& elements = matching_elements();
     // First look for an "id" attribute match
     if (auto it = elements.find_if([&](auto& entry) { return entry->attribute(HTML::AttributeNames::id) == name; }); it != elements.end())
         return *it;
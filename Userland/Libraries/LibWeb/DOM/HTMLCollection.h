@@ -9,6 +9,7 @@
 #include <AK/FlyString.h>
 #include <AK/Function.h>
 #include <AK/Noncopyable.h>
+#include <AK/Optional.h>
 #include <LibWeb/Bindings/Wrappable.h>
 #include <LibWeb/Forward.h>
 
@@ -21,9 +22,8 @@ namespace Web::DOM {
 // The filter is a simple Function object that answers the question
 // "is this Element part of the collection?"
 
-// FIXME: HTMLCollection currently does no caching. It will re-filter on every access!
-//        We should teach it how to cache results. The main challenge is invalidating
-//        these caches, since this needs to happen on various kinds of DOM mutation.
+// The matching elements are cached, and collected again whenever the root's document
+// has been mutated since (see Document::dom_tree_version()).
 
 class HTMLCollection
     : public RefCounted<HTMLCollection>
@@ -51,8 +51,13 @@ protected:
     HTMLCollection(ParentNode& root, Function<bool(Element const&)> filter);
 
 private:
+    Vector<NonnullRefPtr<Element>>& matching_elements();
+
     NonnullRefPtr<ParentNode> m_root;
     Function<bool(Element const&)> m_filter;
+
+    Vector<NonnullRefPtr<Element>> m_cached_elements;
+    Optional<u64> m_cached_dom_tree_version;
 };
 
 }
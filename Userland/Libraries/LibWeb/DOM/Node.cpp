@@ -258,6 +258,7 @@ void Node::insert_before(NonnullRefPtr<Node> node, RefPtr<Node> child, bool supp
         // FIXME: queue a tree mutation record for parent with nodes, « », previousSibling, and child.
     }
 
+    document().bump_dom_tree_version();
     children_changed();
 }
 
@@ -342,6 +343,7 @@ void Node::remove(bool suppress_observers)
         // FIXME: queue a tree mutation record for parent with « », « node », oldPreviousSibling, and oldNextSibling.
     }
 
+    document().bump_dom_tree_version();
     parent->children_changed();
 }
 
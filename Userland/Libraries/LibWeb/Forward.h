@@ -135,6 +135,7 @@ class HTMLUnknownElement;
 class HTMLVideoElement;
 class ImageData;
 class MessageEvent;
+class PreloadScanner;
 class WebSocket;
 }
 
@@ -27,6 +27,7 @@ public:
     String src() const { return attribute(HTML::AttributeNames::src); }
 
     const Gfx::Bitmap* bitmap() const;
+    Gfx::IntSize natural_size() const { return m_image_loader.natural_size(); }
 
 private:
     virtual void apply_presentational_hints(CSS::StyleProperties&) const override;
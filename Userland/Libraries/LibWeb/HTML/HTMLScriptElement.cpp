@@ -70,7 +70,13 @@ void HTMLScriptElement::execute_script()
         else
             dbgln_if(HTML_SCRIPT_DEBUG, "HTMLScriptElement: Running inline script");
 
-        document().run_javascript(m_script_source, m_script_filename);
+        if (m_script_parsing_job) {
+            if (auto program = m_script_parsing_job->wait_for_program())
+                document().run_javascript(*program);
+            m_script_parsing_job = nullptr;
+        } else {
+            document().run_javascript(m_script_source, m_script_filename);
+        }
 
         document().set_current_script({}, old_current_script);
     } else {
@@ -207,20 +213,19 @@ void HTMLScriptElement::prepare_script()
             auto request = LoadRequest::create_for_url_on_page(url, document().page());
 
             // FIXME: This load should be made asynchronous and the parser should spin an event loop etc.
+            // Loading through the resource cache picks up scripts that the PreloadScanner has already started loading.
             m_script_filename = url.to_string();
-            ResourceLoader::the().load_sync(
-                request,
-                [this, url](auto data, auto&, auto) {
-                    if (data.is_null()) {
-                        dbgln("HTMLScriptElement: Failed to load {}", url);
-                        return;
-                    }
-                    m_script_source = String::copy(data);
-                    script_became_ready();
-                },
-                [this](auto&, auto) {
-                    m_failed_to_load = true;
-                });
+            auto resource = ResourceLoader::the().load_resource_sync(Resource::Type::Generic, request);
+            if (!resource || resource->is_failed()) {
+                m_failed_to_load = true;
+            } else if (!resource->has_encoded_data()) {
+                dbgln("HTMLScriptElement: Failed to load {}", url);
+            } else {
+                m_script_source = String::copy(resource->encoded_data());
+                if (should_parse_off_thread())
+                    m_script_parsing_job = ScriptParsingJob::create(m_script_source, m_script_filename);
+                script_became_ready();
+            }
         } else {
             TODO();
         }
@@ -290,6 +295,20 @@ void HTMLScriptElement::prepare_script()
     }
 }
 
+// Parsing on another thread only pays off when the script doesn't run right away, so the HTML
+// parser can keep going in the meantime. Parser-blocking scripts are executed (and thus waited
+// for) as soon as they have been loaded, so parsing them off-thread would gain nothing.
+// FIXME: Once script loads are asynchronous, start parsing parser-blocking scripts as soon as
+//        their data arrives, so parsing overlaps with the load.
+bool HTMLScriptElement::should_parse_off_thread() const
+{
+    static constexpr size_t minimum_size = 4 * KiB;
+
+    if (m_script_source.length() < minimum_size)
+        return false;
+    return has_attribute(HTML::AttributeNames::async) || has_attribute(HTML::AttributeNames::defer) || !is_parser_inserted();
+}
+
 void HTMLScriptElement::script_became_ready()
 {
     m_script_ready = true;
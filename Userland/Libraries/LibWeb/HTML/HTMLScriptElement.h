@@ -8,6 +8,7 @@
 
 #include <AK/Function.h>
 #include <LibWeb/HTML/HTMLElement.h>
+#include <LibWeb/HTML/ScriptParsingJob.h>
 
 namespace Web::HTML {
 
@@ -34,6 +35,7 @@ public:
 
 private:
     void prepare_script();
+    bool should_parse_off_thread() const;
     void script_became_ready();
     void when_the_script_is_ready(Function<void()>);
 
@@ -57,6 +59,7 @@ private:
 
     String m_script_source;
     String m_script_filename;
+    RefPtr<ScriptParsingJob> m_script_parsing_job;
 };
 
 }
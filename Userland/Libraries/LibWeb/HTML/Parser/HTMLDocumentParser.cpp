@@ -5,7 +5,9 @@
  */
 
 #include <AK/Debug.h>
+#include <AK/ScopeGuard.h>
 #include <AK/SourceLocation.h>
+#include <AK/TemporaryChange.h>
 #include <AK/Utf32View.h>
 #include <LibTextCodec/Decoder.h>
 #include <LibWeb/DOM/Comment.h>
@@ -23,6 +25,7 @@
 #include <LibWeb/HTML/HTMLTemplateElement.h>
 #include <LibWeb/HTML/Parser/HTMLDocumentParser.h>
 #include <LibWeb/HTML/Parser/HTMLToken.h>
+#include <LibWeb/HTML/Parser/PreloadScanner.h>
 #include <LibWeb/Namespace.h>
 #include <LibWeb/SVG/TagNames.h>
 
@@ -103,19 +106,120 @@ HTMLDocumentParser::HTMLDocumentParser(DOM::Document& document, const StringView
     : m_tokenizer(input, encoding)
     , m_document(document)
 {
-    m_document->set_should_invalidate_styles_on_attribute_changes(false);
     m_document->set_encoding(TextCodec::get_standardized_encoding(encoding));
+
+    // Documents that aren't being loaded into a page (e.g. the ones used for fragment parsing) don't load subresources.
+    if (m_document->page()) {
+        m_preload_scanner = make<PreloadScanner>(document);
+        m_preload_scanner->append_to_input(m_tokenizer.source());
+        m_preload_scanner->insert_eof();
+    }
+}
+
+HTMLDocumentParser::HTMLDocumentParser(DOM::Document& document, const String& encoding)
+    : m_document(document)
+    , m_decoder(TextCodec::decoder_for(encoding))
+{
+    VERIFY(m_decoder);
+    m_document->set_encoding(TextCodec::get_standardized_encoding(encoding));
+
+    if (m_document->page())
+        m_preload_scanner = make<PreloadScanner>(document);
 }
 
 HTMLDocumentParser::~HTMLDocumentParser()
 {
-    m_document->set_should_invalidate_styles_on_attribute_changes(true);
+}
+
+// Returns how many of the bytes can be decoded without splitting a character that continues in the next chunk.
+static size_t decodable_length(ReadonlyBytes bytes, const String& encoding)
+{
+    if (encoding.equals_ignoring_case("utf-16be"))
+        return bytes.size() - (bytes.size() % 2);
+
+    if (!encoding.equals_ignoring_case("utf-8"))
+        return bytes.size();
+
+    // Find the first byte of the last sequence, and check whether all of its continuation bytes are there.
+    for (size_t i = 1; i <= min(bytes.size(), (size_t)4); ++i) {
+        u8 byte = bytes[bytes.size() - i];
+        if ((byte & 0xc0) == 0x80)
+            continue;
+        size_t sequence_length = 1;
+        if ((byte & 0xe0) == 0xc0)
+            sequence_length = 2;
+        else if ((byte & 0xf0) == 0xe0)
+            sequence_length = 3;
+        else if ((byte & 0xf8) == 0xf0)
+            sequence_length = 4;
+        return sequence_length > i ? bytes.size() - i : bytes.size();
+    }
+    return bytes.size();
+}
+
+void HTMLDocumentParser::append_to_input(ReadonlyBytes bytes)
+{
+    VERIFY(m_decoder);
+
+    ReadonlyBytes input = bytes;
+    if (!m_undecoded_input.is_empty()) {
+        m_undecoded_input.append(bytes.data(), bytes.size());
+        input = m_undecoded_input.bytes();
+    }
+
+    auto length = decodable_length(input, m_document->encoding());
+    auto decoded_input = m_decoder->to_utf8(StringView { input.data(), length });
+    m_undecoded_input = ByteBuffer::copy(input.slice(length));
+
+    m_tokenizer.append_to_input(decoded_input);
+
+    // The preload scanner gets to see the input right away, even while the tree builder is blocked on a script.
+    if (m_preload_scanner) {
+        m_preload_scanner->append_to_input(decoded_input);
+        m_preload_scanner->run();
+    }
+}
+
+void HTMLDocumentParser::insert_eof()
+{
+    // Whatever is left of an incomplete character at the end can't be decoded anymore.
+    if (!m_undecoded_input.is_empty()) {
+        m_tokenizer.append_to_input(m_decoder->to_utf8(m_undecoded_input));
+        m_undecoded_input.clear();
+    }
+
+    m_tokenizer.insert_eof();
+    if (m_preload_scanner) {
+        m_preload_scanner->insert_eof();
+        m_preload_scanner->run();
+    }
+}
+
+void HTMLDocumentParser::abort()
+{
+    m_aborted = true;
+    m_stop_parsing = true;
 }
 
 void HTMLDocumentParser::run(const URL& url)
 {
-    m_document->set_url(url);
-    m_document->set_source(m_tokenizer.source());
+    // A script that blocks the parser may spin a nested event loop in which more input arrives.
+    // That input is picked up by the run() that's already in progress.
+    if (m_running || m_finished || m_aborted)
+        return;
+    TemporaryChange running_change(m_running, true);
+
+    m_document->set_should_invalidate_styles_on_attribute_changes(false);
+    ScopeGuard invalidate_styles_guard = [&] {
+        m_document->set_should_invalidate_styles_on_attribute_changes(true);
+    };
+
+    if (!m_started) {
+        m_started = true;
+        m_document->set_url(url);
+        if (m_preload_scanner)
+            m_preload_scanner->run();
+    }
 
     for (;;) {
         auto optional_token = m_tokenizer.next_token();
@@ -123,19 +227,24 @@ void HTMLDocumentParser::run(const URL& url)
             break;
         auto& token = optional_token.value();
 
-        dbgln_if(PARSER_DEBUG, "[{}] {}", insertion_mode_name(), token.to_string());
-
-        // FIXME: If the adjusted current node is a MathML text integration point and the token is a start tag whose tag name is neither "mglyph" nor "malignmark"
-        // FIXME: If the adjusted current node is a MathML text integration point and the token is a character token
-        // FIXME: If the adjusted current node is a MathML annotation-xml element and the token is a start tag whose tag name is "svg"
-        // FIXME: If the adjusted current node is an HTML integration point and the token is a start tag
-        // FIXME: If the adjusted current node is an HTML integration point and the token is a character token
-        if (m_stack_of_open_elements.is_empty()
-            || adjusted_current_node().namespace_() == Namespace::HTML
-            || token.is_end_of_file()) {
-            process_using_the_rules_for(m_insertion_mode, token);
+        if (token.is_character()) {
+            // The tokenizer emits runs of text as one token, but the tree construction rules deal with one character at a time.
+            // A single token is reused for all of them, since tokens are expensive to create.
+            auto& data = token.m_comment_or_character.data;
+            if (Utf8View(data.string_view()).length() > 1) {
+                auto text = data.to_string();
+                for (auto code_point : Utf8View(text)) {
+                    data.clear();
+                    data.append_code_point(code_point);
+                    process_token(token);
+                    if (m_stop_parsing)
+                        break;
+                }
+            } else {
+                process_token(token);
+            }
         } else {
-            process_using_the_rules_for_foreign_content(token);
+            process_token(token);
         }
 
         if (m_stop_parsing) {
@@ -146,6 +255,16 @@ void HTMLDocumentParser::run(const URL& url)
 
     flush_character_insertions();
 
+    if (m_aborted)
+        return;
+
+    // Wait for the rest of the input.
+    if (!m_stop_parsing && !m_tokenizer.is_eof_inserted())
+        return;
+
+    m_finished = true;
+    m_document->set_source(m_tokenizer.source());
+
     // "The end"
 
     m_document->set_ready_state("interactive");
@@ -176,6 +295,30 @@ void HTMLDocumentParser::run(const URL& url)
     m_document->completely_finish_loading();
 }
 
+void HTMLDocumentParser::process_token(HTMLToken& token)
+{
+    dbgln_if(PARSER_DEBUG, "[{}] {}", insertion_mode_name(), token.to_string());
+
+    if (m_next_line_feed_should_be_ignored) {
+        m_next_line_feed_should_be_ignored = false;
+        if (token.is_character() && token.code_point() == '\n')
+            return;
+    }
+
+    // FIXME: If the adjusted current node is a MathML text integration point and the token is a start tag whose tag name is neither "mglyph" nor "malignmark"
+    // FIXME: If the adjusted current node is a MathML text integration point and the token is a character token
+    // FIXME: If the adjusted current node is a MathML annotation-xml element and the token is a start tag whose tag name is "svg"
+    // FIXME: If the adjusted current node is an HTML integration point and the token is a start tag
+    // FIXME: If the adjusted current node is an HTML integration point and the token is a character token
+    if (m_stack_of_open_elements.is_empty()
+        || adjusted_current_node().namespace_() == Namespace::HTML
+        || token.is_end_of_file()) {
+        process_using_the_rules_for(m_insertion_mode, token);
+    } else {
+        process_using_the_rules_for_foreign_content(token);
+    }
+}
+
 void HTMLDocumentParser::process_using_the_rules_for(InsertionMode mode, HTMLToken& token)
 {
     switch (mode) {
@@ -1247,12 +1390,8 @@ void HTMLDocumentParser::handle_in_body(HTMLToken& token)
         // If the next token is a U+000A LINE FEED (LF) character token,
         // then ignore that token and move on to the next one.
         // (Newlines at the start of pre blocks are ignored as an authoring convenience.)
-        auto next_token = m_tokenizer.next_token();
-        if (next_token.has_value() && next_token.value().is_character() && next_token.value().code_point() == '\n') {
-            // Ignore it.
-        } else {
-            process_using_the_rules_for(m_insertion_mode, next_token.value());
-        }
+        // NOTE: The next token may not have arrived yet, so this is handled when it does.
+        m_next_line_feed_should_be_ignored = true;
         return;
     }
 
@@ -1583,17 +1722,12 @@ void HTMLDocumentParser::handle_in_body(HTMLToken& token)
         // If the next token is a U+000A LINE FEED (LF) character token,
         // then ignore that token and move on to the next one.
         // (Newlines at the start of pre blocks are ignored as an authoring convenience.)
-        auto next_token = m_tokenizer.next_token();
+        // NOTE: The next token may not have arrived yet, so this is handled when it does.
+        m_next_line_feed_should_be_ignored = true;
 
         m_original_insertion_mode = m_insertion_mode;
         m_frameset_ok = false;
         m_insertion_mode = InsertionMode::Text;
-
-        if (next_token.has_value() && next_token.value().is_character() && next_token.value().code_point() == '\n') {
-            // Ignore it.
-        } else {
-            process_using_the_rules_for(m_insertion_mode, next_token.value());
-        }
         return;
     }
 
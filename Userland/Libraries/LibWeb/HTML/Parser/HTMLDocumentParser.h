@@ -7,6 +7,8 @@
 #pragma once
 
 #include <AK/NonnullRefPtrVector.h>
+#include <AK/OwnPtr.h>
+#include <LibTextCodec/Decoder.h>
 #include <LibWeb/DOM/Node.h>
 #include <LibWeb/HTML/Parser/HTMLTokenizer.h>
 #include <LibWeb/HTML/Parser/ListOfActiveFormattingElements.h>
@@ -44,10 +46,23 @@ RefPtr<DOM::Document> parse_html_document(const StringView&, const URL&, const S
 class HTMLDocumentParser {
 public:
     HTMLDocumentParser(DOM::Document&, const StringView& input, const String& encoding);
+    // Creates a parser for a document whose data arrives in chunks, see append_to_input() and insert_eof().
+    HTMLDocumentParser(DOM::Document&, const String& encoding);
     ~HTMLDocumentParser();
 
+    // Parses as much of the input as has arrived. Once the end of the input is reached, the document is finished.
     void run(const URL&);
 
+    void append_to_input(ReadonlyBytes);
+    void insert_eof();
+
+    bool is_running() const { return m_running; }
+    bool has_finished() const { return m_finished; }
+
+    // Stops parsing without finishing the document, e.g. because the frame is navigating somewhere else.
+    void abort();
+    bool is_aborted() const { return m_aborted; }
+
     DOM::Document& document();
 
     static NonnullRefPtrVector<DOM::Node> parse_html_fragment(DOM::Element& context_element, const StringView&);
@@ -116,6 +131,7 @@ private:
     void insert_comment(HTMLToken&);
     void reconstruct_the_active_formatting_elements();
     void close_a_p_element();
+    void process_token(HTMLToken&);
     void process_using_the_rules_for(InsertionMode, HTMLToken&);
     void process_using_the_rules_for_foreign_content(HTMLToken&);
     void parse_generic_raw_text_element(HTMLToken&);
@@ -157,6 +173,10 @@ private:
     bool m_aborted { false };
     bool m_parser_pause_flag { false };
     bool m_stop_parsing { false };
+    bool m_next_line_feed_should_be_ignored { false };
+    bool m_started { false };
+    bool m_running { false };
+    bool m_finished { false };
     size_t m_script_nesting_level { 0 };
 
     NonnullRefPtr<DOM::Document> m_document;
@@ -168,6 +188,11 @@ private:
 
     RefPtr<DOM::Text> m_character_insertion_node;
     StringBuilder m_character_insertion_builder;
+
+    TextCodec::Decoder* m_decoder { nullptr };
+    ByteBuffer m_undecoded_input;
+
+    OwnPtr<PreloadScanner> m_preload_scanner;
 };
 
 }
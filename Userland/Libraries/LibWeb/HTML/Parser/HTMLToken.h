@@ -34,7 +34,7 @@ public:
     {
         HTMLToken token;
         token.m_type = Type::Character;
-        token.m_comment_or_character.data.append(code_point);
+        token.m_comment_or_character.data.append_code_point(code_point);
         return token;
     }
 
@@ -144,6 +144,17 @@ namespace Web::HTML {
 #define EMIT_CURRENT_CHARACTER \
     EMIT_CHARACTER(current_input_character.value());
 
+// Emits the current input character together with the rest of the run of text that doesn't contain any of the given
+// characters as a single character token. The tree builder splits it up into one token per code point again.
+#define EMIT_CURRENT_CHARACTER_AND_RUN_UNTIL(...)                                                       \
+    do {                                                                                                \
+        create_new_token(HTMLToken::Type::Character);                                                   \
+        m_current_token.m_comment_or_character.data.append_code_point(current_input_character.value()); \
+        m_current_token.m_comment_or_character.data.append(consume_run_until<__VA_ARGS__>());           \
+        m_queued_tokens.enqueue(m_current_token);                                                       \
+        return m_queued_tokens.dequeue();                                                               \
+    } while (0)
+
 #define SWITCH_TO_AND_EMIT_CHARACTER(code_point, new_state) \
     do {                                                    \
         will_switch_to(State::new_state);                   \
@@ -192,27 +203,110 @@ static inline bool is_control(u32 code_point)
     return is_c0_control(code_point) || (code_point >= 0x7f && code_point <= 0x9f);
 }
 
+// Returns the offset of the first byte in the given range that is one of the needles, or the end of the range.
+// The input is checked a word at a time: a word contains a needle if XORing it with the needle repeated
+// in every byte leaves a zero byte.
+template<u8... needles>
+static size_t find_first_of(const u8* bytes, size_t start, size_t end)
+{
+    constexpr u64 ones = 0x0101010101010101ull;
+    constexpr u64 highs = 0x8080808080808080ull;
+    auto has_zero_byte = [&](u64 word) { return ((word - ones) & ~word & highs) != 0; };
+
+    size_t i = start;
+    for (; i + sizeof(u64) <= end; i += sizeof(u64)) {
+        u64 word;
+        __builtin_memcpy(&word, bytes + i, sizeof(word));
+        if ((has_zero_byte(word ^ (needles * ones)) || ...))
+            break;
+    }
+    for (; i < end; ++i) {
+        if (((bytes[i] == needles) || ...))
+            return i;
+    }
+    return end;
+}
+
+// Consumes the input up to (but not including) the next one of the given ASCII characters, or to the end of the
+// input that has arrived so far. Bytes of multi-byte UTF-8 sequences are never ASCII, so this can look at bytes.
+template<u8... stop_characters>
+StringView HTMLTokenizer::consume_run_until()
+{
+    auto input = m_utf8_view.as_string();
+    auto start = m_utf8_view.byte_offset_of(m_utf8_iterator);
+    auto end = find_first_of<stop_characters...>(reinterpret_cast<const u8*>(input.characters_without_null_termination()), start, input.length());
+    if (end == start)
+        return {};
+    m_utf8_iterator = iterator_at_byte_offset(end);
+    return input.substring_view(start, end - start);
+}
+
 Optional<u32> HTMLTokenizer::next_code_point()
 {
-    if (m_utf8_iterator == m_utf8_view.end())
+    if (m_utf8_iterator == m_utf8_view.end()) {
+        if (!m_eof_inserted)
+            m_ran_out_of_input = true;
         return {};
+    }
     m_prev_utf8_iterator = m_utf8_iterator;
     ++m_utf8_iterator;
     dbgln_if(TOKENIZER_TRACE_DEBUG, "(Tokenizer) Next code_point: {}", (char)*m_prev_utf8_iterator);
     return *m_prev_utf8_iterator;
 }
 
-Optional<u32> HTMLTokenizer::peek_code_point(size_t offset) const
+Optional<u32> HTMLTokenizer::peek_code_point(size_t offset)
 {
     auto it = m_utf8_iterator;
     for (size_t i = 0; i < offset && it != m_utf8_view.end(); ++i)
         ++it;
-    if (it == m_utf8_view.end())
+    if (it == m_utf8_view.end()) {
+        if (!m_eof_inserted)
+            m_ran_out_of_input = true;
         return {};
+    }
     return *it;
 }
 
 Optional<HTMLToken> HTMLTokenizer::next_token()
+{
+    if (!m_queued_tokens.is_empty())
+        return m_queued_tokens.dequeue();
+
+    if (m_eof_inserted)
+        return tokenize();
+
+    // Running out of input is treated like the end of the file, and the state machine goes on as if it was.
+    // If that happens, everything is rolled back to here and we try again once more input has arrived.
+    // This happens for every token, so only what's needed to start over is saved: tokens are never carried over
+    // from one call to tokenize() to the next, and every state that can be current here builds its token from
+    // scratch. The only exception are the states that match "script" against the temporary buffer, while
+    // emitting the characters they consume one by one.
+    auto state = m_state;
+    auto return_state = m_return_state;
+    auto utf8_iterator = m_utf8_iterator;
+    auto prev_utf8_iterator = m_prev_utf8_iterator;
+    auto has_emitted_eof = m_has_emitted_eof;
+    Optional<Vector<u32>> temporary_buffer;
+    if (state == State::ScriptDataDoubleEscapeStart || state == State::ScriptDataDoubleEscapeEnd)
+        temporary_buffer = m_temporary_buffer;
+
+    auto token = tokenize();
+    if (!m_ran_out_of_input)
+        return token;
+
+    m_ran_out_of_input = false;
+    m_state = state;
+    m_return_state = return_state;
+    m_utf8_iterator = utf8_iterator;
+    m_prev_utf8_iterator = prev_utf8_iterator;
+    m_has_emitted_eof = has_emitted_eof;
+    if (temporary_buffer.has_value())
+        m_temporary_buffer = temporary_buffer.release_value();
+    m_queued_tokens.clear();
+    return {};
+}
+
+Optional<HTMLToken> HTMLTokenizer::tokenize()
 {
 _StartOfFunction:
     if (!m_queued_tokens.is_empty())
@@ -243,7 +337,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    EMIT_CURRENT_CHARACTER;
+                    EMIT_CURRENT_CHARACTER_AND_RUN_UNTIL('&', '<', 0);
                 }
             }
             END_STATE
@@ -1150,7 +1244,9 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    m_current_token.m_tag.attributes.last().value_builder.append_code_point(current_input_character.value());
+                    auto& value_builder = m_current_token.m_tag.attributes.last().value_builder;
+                    value_builder.append_code_point(current_input_character.value());
+                    value_builder.append(consume_run_until<'"', '&', 0>());
                     continue;
                 }
             }
@@ -1180,7 +1276,9 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    m_current_token.m_tag.attributes.last().value_builder.append_code_point(current_input_character.value());
+                    auto& value_builder = m_current_token.m_tag.attributes.last().value_builder;
+                    value_builder.append_code_point(current_input_character.value());
+                    value_builder.append(consume_run_until<'\'', '&', 0>());
                     continue;
                 }
             }
@@ -1341,7 +1439,9 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    m_current_token.m_comment_or_character.data.append_code_point(current_input_character.value());
+                    auto& data = m_current_token.m_comment_or_character.data;
+                    data.append_code_point(current_input_character.value());
+                    data.append(consume_run_until<'<', '-', 0>());
                     continue;
                 }
             }
@@ -1510,8 +1610,13 @@ _StartOfFunction:
             BEGIN_STATE(NamedCharacterReference)
             {
                 size_t byte_offset = m_utf8_view.byte_offset_of(m_prev_utf8_iterator);
+                auto remaining_input = m_utf8_view.as_string().substring_view(byte_offset);
+
+                // The rest of the entity name may not have arrived yet.
+                if (!m_eof_inserted && remaining_input.length() <= longest_entity_name_length + 1)
+                    m_ran_out_of_input = true;
 
-                auto match = HTML::code_points_from_entity(m_decoded_input.substring_view(byte_offset, m_decoded_input.length() - byte_offset - 1));
+                auto match = HTML::code_points_from_entity(remaining_input.substring_view(0, remaining_input.length() - 1));
 
                 if (match.has_value()) {
                     for (size_t i = 0; i < match.value().entity.length() - 1; ++i) {
@@ -1763,7 +1868,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    EMIT_CURRENT_CHARACTER;
+                    EMIT_CURRENT_CHARACTER_AND_RUN_UNTIL('&', '<', 0);
                 }
             }
             END_STATE
@@ -1873,7 +1978,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    EMIT_CURRENT_CHARACTER;
+                    EMIT_CURRENT_CHARACTER_AND_RUN_UNTIL('<', 0);
                 }
             }
             END_STATE
@@ -1983,7 +2088,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    EMIT_CURRENT_CHARACTER;
+                    EMIT_CURRENT_CHARACTER_AND_RUN_UNTIL('<', 0);
                 }
             }
             END_STATE
@@ -2001,7 +2106,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    EMIT_CURRENT_CHARACTER;
+                    EMIT_CURRENT_CHARACTER_AND_RUN_UNTIL(0);
                 }
             }
             END_STATE
@@ -2584,13 +2689,39 @@ void HTMLTokenizer::create_new_token(HTMLToken::Type type)
     m_current_token.m_type = type;
 }
 
+HTMLTokenizer::HTMLTokenizer()
+{
+}
+
 HTMLTokenizer::HTMLTokenizer(const StringView& input, const String& encoding)
 {
     auto* decoder = TextCodec::decoder_for(encoding);
     VERIFY(decoder);
-    m_decoded_input = decoder->to_utf8(input);
-    m_utf8_view = Utf8View(m_decoded_input);
-    m_utf8_iterator = m_utf8_view.begin();
+    append_to_input(decoder->to_utf8(input));
+    insert_eof();
+}
+
+Utf8CodepointIterator HTMLTokenizer::iterator_at_byte_offset(size_t offset) const
+{
+    return m_utf8_view.substring_view(offset, m_utf8_view.byte_length() - offset).begin();
+}
+
+void HTMLTokenizer::append_to_input(const StringView& input)
+{
+    VERIFY(!m_eof_inserted);
+
+    // The input buffer may move when it grows, so the iterators are recreated at the same offsets.
+    auto offset = m_utf8_view.byte_offset_of(m_utf8_iterator);
+    auto prev_offset = m_utf8_view.byte_offset_of(m_prev_utf8_iterator);
+    m_decoded_input.append(input);
+    m_utf8_view = Utf8View(m_decoded_input.string_view());
+    m_utf8_iterator = iterator_at_byte_offset(offset);
+    m_prev_utf8_iterator = iterator_at_byte_offset(prev_offset);
+}
+
+void HTMLTokenizer::insert_eof()
+{
+    m_eof_inserted = true;
 }
 
 void HTMLTokenizer::will_switch_to([[maybe_unused]] State new_state)
@@ -2609,18 +2740,24 @@ void HTMLTokenizer::switch_to(Badge<HTMLDocumentParser>, State new_state)
     m_state = new_state;
 }
 
+void HTMLTokenizer::preload_scanner_switch_to(Badge<PreloadScanner>, State new_state)
+{
+    dbgln_if(TOKENIZER_TRACE_DEBUG, "[{}] Preload scanner switches tokenizer state to {}", state_name(m_state), state_name(new_state));
+    m_state = new_state;
+}
+
 void HTMLTokenizer::will_emit(HTMLToken& token)
 {
     if (token.is_start_tag())
-        m_last_emitted_start_tag = token;
+        m_last_emitted_start_tag_name = token.tag_name();
 }
 
 bool HTMLTokenizer::current_end_tag_token_is_appropriate() const
 {
     VERIFY(m_current_token.is_end_tag());
-    if (!m_last_emitted_start_tag.is_start_tag())
+    if (m_last_emitted_start_tag_name.is_null())
         return false;
-    return m_current_token.tag_name() == m_last_emitted_start_tag.tag_name();
+    return m_current_token.tag_name() == m_last_emitted_start_tag_name;
 }
 
 bool HTMLTokenizer::consumed_as_part_of_an_attribute() const
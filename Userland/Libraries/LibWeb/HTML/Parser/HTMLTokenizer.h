@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/Queue.h>
+#include <AK/StringBuilder.h>
 #include <AK/StringView.h>
 #include <AK/Types.h>
 #include <AK/Utf8View.h>
@@ -99,6 +100,8 @@ namespace Web::HTML {
 
 class HTMLTokenizer {
 public:
+    // Creates a tokenizer for input that arrives in chunks, see append_to_input() and insert_eof().
+    HTMLTokenizer();
     explicit HTMLTokenizer(const StringView& input, const String& encoding);
 
     enum class State {
@@ -110,15 +113,27 @@ public:
     Optional<HTMLToken> next_token();
 
     void switch_to(Badge<HTMLDocumentParser>, State new_state);
+    void preload_scanner_switch_to(Badge<PreloadScanner>, State new_state);
 
     void set_blocked(bool b) { m_blocked = b; }
     bool is_blocked() const { return m_blocked; }
 
-    String source() const { return m_decoded_input; }
+    String source() const { return m_decoded_input.to_string(); }
+
+    // Until the end of the input has been inserted, next_token() returns nothing if it runs out of
+    // input before it has a complete token, and picks up from the same place after more input is appended.
+    void append_to_input(const StringView&);
+    void insert_eof();
+    bool is_eof_inserted() const { return m_eof_inserted; }
 
 private:
+    Optional<HTMLToken> tokenize();
+
     Optional<u32> next_code_point();
-    Optional<u32> peek_code_point(size_t offset) const;
+    Optional<u32> peek_code_point(size_t offset);
+    template<u8... stop_characters>
+    StringView consume_run_until();
+    Utf8CodepointIterator iterator_at_byte_offset(size_t) const;
     bool consume_next_if_match(const StringView&, CaseSensitivity = CaseSensitivity::CaseSensitive);
     void create_new_token(HTMLToken::Type);
     bool current_end_tag_token_is_appropriate() const;
@@ -146,9 +161,9 @@ private:
 
     Vector<u32> m_temporary_buffer;
 
-    String m_decoded_input;
-
-    StringView m_input;
+    StringBuilder m_decoded_input;
+    bool m_eof_inserted { false };
+    bool m_ran_out_of_input { false };
 
     Utf8View m_utf8_view;
     Utf8CodepointIterator m_utf8_iterator;
@@ -156,7 +171,7 @@ private:
 
     HTMLToken m_current_token;
 
-    HTMLToken m_last_emitted_start_tag;
+    String m_last_emitted_start_tag_name;
 
     bool m_has_emitted_eof { false };
 
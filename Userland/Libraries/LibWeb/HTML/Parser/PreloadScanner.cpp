@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/HTML/AttributeNames.h>
+#include <LibWeb/HTML/Parser/PreloadScanner.h>
+#include <LibWeb/HTML/TagNames.h>
+#include <LibWeb/Loader/LoadRequest.h>
+#include <LibWeb/Loader/ResourceLoader.h>
+
+namespace Web::HTML {
+
+PreloadScanner::PreloadScanner(DOM::Document& document)
+    : m_document(document)
+    , m_base_url(document.url())
+{
+}
+
+PreloadScanner::~PreloadScanner()
+{
+}
+
+void PreloadScanner::run()
+{
+    auto preload_count_before = m_preload_count;
+
+    for (;;) {
+        auto optional_token = m_tokenizer.next_token();
+        if (!optional_token.has_value())
+            break;
+        auto& token = optional_token.value();
+        if (token.is_end_of_file())
+            break;
+        if (token.is_start_tag())
+            process_start_tag(token);
+    }
+
+    dbgln_if(PRELOAD_SCANNER_DEBUG, "PreloadScanner: Started {} preloads for {}", m_preload_count - preload_count_before, m_document.url());
+}
+
+void PreloadScanner::process_start_tag(HTMLToken& token)
+{
+    auto tag_name = token.tag_name();
+
+    // Keep the tokenizer in the same state the tree builder would put it in,
+    // so that e.g. the contents of scripts and comments in <style> aren't mistaken for markup.
+    if (tag_name == TagNames::script) {
+        m_tokenizer.preload_scanner_switch_to({}, HTMLTokenizer::State::ScriptData);
+        auto type = token.attribute(AttributeNames::type);
+        if (!type.is_null() && type.equals_ignoring_case("module"))
+            return;
+        if (token.has_attribute(AttributeNames::src))
+            preload(Resource::Type::Generic, token.attribute(AttributeNames::src));
+        return;
+    }
+
+    if (tag_name.is_one_of(TagNames::style, TagNames::xmp, TagNames::iframe, TagNames::noembed, TagNames::noframes, TagNames::noscript)) {
+        m_tokenizer.preload_scanner_switch_to({}, HTMLTokenizer::State::RAWTEXT);
+        return;
+    }
+
+    if (tag_name.is_one_of(TagNames::textarea, TagNames::title)) {
+        m_tokenizer.preload_scanner_switch_to({}, HTMLTokenizer::State::RCDATA);
+        return;
+    }
+
+    if (tag_name == TagNames::plaintext) {
+        m_tokenizer.preload_scanner_switch_to({}, HTMLTokenizer::State::PLAINTEXT);
+        return;
+    }
+
+    if (tag_name == TagNames::base) {
+        // Only the first <base> element with an href attribute counts.
+        if (m_seen_base_element || !token.has_attribute(AttributeNames::href))
+            return;
+        m_seen_base_element = true;
+        auto base_url = m_base_url.complete_url(token.attribute(AttributeNames::href));
+        if (base_url.is_valid())
+            m_base_url = base_url;
+        return;
+    }
+
+    if (tag_name == TagNames::link) {
+        bool is_stylesheet = false;
+        for (auto& part : token.attribute(AttributeNames::rel).split_view(' ')) {
+            if (part.equals_ignoring_case("stylesheet"))
+                is_stylesheet = true;
+            else if (part.equals_ignoring_case("alternate"))
+                return;
+        }
+        if (is_stylesheet && token.has_attribute(AttributeNames::href))
+            preload(Resource::Type::Generic, token.attribute(AttributeNames::href));
+        return;
+    }
+
+    if (tag_name == TagNames::img) {
+        if (token.has_attribute(AttributeNames::src))
+            preload(Resource::Type::Image, token.attribute(AttributeNames::src));
+        return;
+    }
+}
+
+void PreloadScanner::preload(Resource::Type type, const StringView& url_string)
+{
+    if (url_string.is_empty())
+        return;
+
+    auto url = m_base_url.complete_url(url_string);
+    // Local files aren't cached by the ResourceLoader, so loading them here would only load them twice.
+    if (!url.is_valid() || url.protocol() == "file")
+        return;
+
+    // This must be the same request that the element will make later, otherwise the ResourceLoader won't reuse it.
+    auto request = LoadRequest::create_for_url_on_page(url, m_document.page());
+    if (!m_document.load_resource(type, request))
+        return;
+
+    dbgln_if(PRELOAD_SCANNER_DEBUG, "PreloadScanner: Preloading {}", url);
+    ++m_preload_count;
+}
+
+}
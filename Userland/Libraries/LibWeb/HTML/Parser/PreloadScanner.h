@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/URL.h>
+#include <LibWeb/Forward.h>
+#include <LibWeb/HTML/Parser/HTMLTokenizer.h>
+#include <LibWeb/Loader/Resource.h>
+
+namespace Web::HTML {
+
+// The preload scanner runs ahead of the tree builder with its own tokenizer and starts fetching
+// the scripts, stylesheets and images referenced by the markup. The tree builder gets blocked on
+// every external script, so without this the resources after a script would only start loading
+// once the script has been loaded and run.
+// The fetched resources are remembered by the document, which hands them out again when the
+// corresponding elements are inserted.
+class PreloadScanner {
+public:
+    explicit PreloadScanner(DOM::Document&);
+    ~PreloadScanner();
+
+    void append_to_input(const StringView& input) { m_tokenizer.append_to_input(input); }
+    void insert_eof() { m_tokenizer.insert_eof(); }
+
+    // Scans all of the input that has arrived so far.
+    void run();
+
+private:
+    void process_start_tag(HTMLToken&);
+    void preload(Resource::Type, const StringView& url);
+
+    DOM::Document& m_document;
+    HTMLTokenizer m_tokenizer;
+    URL m_base_url;
+    bool m_seen_base_element { false };
+    size_t m_preload_count { 0 };
+};
+
+}
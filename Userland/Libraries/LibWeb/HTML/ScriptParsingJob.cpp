@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Parser.h>
+#include <LibWeb/HTML/ScriptParsingJob.h>
+
+namespace Web::HTML {
+
+NonnullRefPtr<ScriptParsingJob> ScriptParsingJob::create(String source, String filename)
+{
+    return adopt_ref(*new ScriptParsingJob(move(source), move(filename)));
+}
+
+ScriptParsingJob::ScriptParsingJob(String source, String filename)
+    : m_source(move(source))
+    , m_filename(move(filename))
+{
+    m_thread = LibThread::Thread::construct([this] {
+        // NOTE: The parser and the AST keep pointing into m_source and m_filename, which we own.
+        m_parser = make<JS::Parser>(JS::Lexer(m_source, m_filename));
+        m_parser->set_lazy_function_parsing_enabled(true);
+        m_program = m_parser->parse_program();
+        return 0;
+    },
+        "ScriptParser");
+    m_thread->start();
+}
+
+ScriptParsingJob::~ScriptParsingJob()
+{
+    wait_until_finished();
+}
+
+void ScriptParsingJob::wait_until_finished()
+{
+    if (!m_thread)
+        return;
+    auto result = m_thread->join();
+    VERIFY(!result.is_error());
+    m_thread = nullptr;
+}
+
+RefPtr<JS::Program> ScriptParsingJob::wait_for_program()
+{
+    wait_until_finished();
+    if (m_parser->has_errors()) {
+        m_parser->print_errors();
+        return nullptr;
+    }
+    return m_program;
+}
+
+}
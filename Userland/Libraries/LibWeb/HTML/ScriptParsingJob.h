@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/OwnPtr.h>
+#include <AK/RefCounted.h>
+#include <AK/String.h>
+#include <LibJS/Forward.h>
+#include <LibThread/Thread.h>
+
+namespace Web::HTML {
+
+// Parses a script on its own thread, so the main thread can keep going in the meantime.
+// Parsing only builds an AST and doesn't touch the JS heap, so no cells are created until
+// the main thread hands the resulting program to the interpreter.
+class ScriptParsingJob : public RefCounted<ScriptParsingJob> {
+public:
+    static NonnullRefPtr<ScriptParsingJob> create(String source, String filename);
+    ~ScriptParsingJob();
+
+    // Blocks until parsing has finished. Returns null (after logging the errors) if the script had syntax errors.
+    RefPtr<JS::Program> wait_for_program();
+
+private:
+    ScriptParsingJob(String source, String filename);
+
+    void wait_until_finished();
+
+    String m_source;
+    String m_filename;
+    OwnPtr<JS::Parser> m_parser;
+    RefPtr<JS::Program> m_program;
+    RefPtr<LibThread::Thread> m_thread;
+};
+
+}
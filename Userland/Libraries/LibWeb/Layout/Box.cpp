@@ -209,6 +209,30 @@ LineBox& Box::add_line_box()
     return m_line_boxes.last();
 }
 
+bool Box::is_layout_boundary() const
+{
+    if (!has_style() || !parent() || is_root_element())
+        return false;
+
+    // Only in-flow blocks are placed by their parent without looking at their contents.
+    if (!is_block_box() || is_inline() || is_floating() || is_absolutely_positioned())
+        return false;
+    if (computed_values().display() != CSS::Display::Block || parent()->computed_values().display() == CSS::Display::Flex)
+        return false;
+
+    // Contents that don't fit must not be able to affect anything outside of the box.
+    auto clips = [](CSS::Overflow overflow) {
+        return overflow != CSS::Overflow::Visible && overflow != CSS::Overflow::Clip;
+    };
+    if (!clips(computed_values().overflow_x()) || !clips(computed_values().overflow_y()))
+        return false;
+
+    auto is_fixed_size = [](const CSS::Length& length) {
+        return length.is_absolute() || length.is_relative();
+    };
+    return is_fixed_size(computed_values().width()) && is_fixed_size(computed_values().height());
+}
+
 float Box::width_of_logical_containing_block() const
 {
     auto* containing_block = this->containing_block();
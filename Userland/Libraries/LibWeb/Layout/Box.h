@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Optional.h>
 #include <AK/OwnPtr.h>
 #include <LibGfx/Rect.h>
 #include <LibWeb/Layout/LineBox.h>
@@ -120,6 +121,23 @@ public:
 
     virtual float width_of_logical_containing_block() const;
 
+    // A box that is laid out the same way regardless of its contents, so changes inside it
+    // can be laid out again without touching anything outside of it.
+    bool is_layout_boundary() const;
+
+    struct ShrinkToFitWidths {
+        float containing_block_width { 0 };
+        float width { 0 };
+        float preferred_width { 0 };
+        float preferred_minimum_width { 0 };
+    };
+
+    // The shrink-to-fit widths are expensive to compute (the contents are laid out twice),
+    // so they are kept around until something inside the box changes.
+    const Optional<ShrinkToFitWidths>& cached_shrink_to_fit_widths() const { return m_cached_shrink_to_fit_widths; }
+    void set_cached_shrink_to_fit_widths(const ShrinkToFitWidths& widths) { m_cached_shrink_to_fit_widths = widths; }
+    void invalidate_cached_shrink_to_fit_widths() { m_cached_shrink_to_fit_widths.clear(); }
+
 protected:
     Box(DOM::Document& document, DOM::Node* node, NonnullRefPtr<CSS::StyleProperties> style)
         : NodeWithStyleAndBoxModelMetrics(document, node, move(style))
@@ -147,6 +165,8 @@ private:
     WeakPtr<LineBoxFragment> m_containing_line_box_fragment;
 
     OwnPtr<StackingContext> m_stacking_context;
+
+    Optional<ShrinkToFitWidths> m_cached_shrink_to_fit_widths;
 };
 
 template<>
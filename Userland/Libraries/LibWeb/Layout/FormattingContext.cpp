@@ -108,6 +108,13 @@ static float greatest_child_width(const Box& box)
 
 FormattingContext::ShrinkToFitResult FormattingContext::calculate_shrink_to_fit_widths(Box& box)
 {
+    auto containing_block_width = box.width_of_logical_containing_block();
+    if (auto& cached = box.cached_shrink_to_fit_widths(); cached.has_value()) {
+        if (cached->containing_block_width == containing_block_width && cached->width == box.width())
+            return { cached->preferred_width, cached->preferred_minimum_width };
+    }
+    auto width = box.width();
+
     // Calculate the preferred width by formatting the content without breaking lines
     // other than where explicit line breaks occur.
     layout_inside(box, LayoutMode::OnlyRequiredLineBreaks);
@@ -119,6 +126,7 @@ FormattingContext::ShrinkToFitResult FormattingContext::calculate_shrink_to_fit_
     layout_inside(box, LayoutMode::AllPossibleLineBreaks);
     float preferred_minimum_width = greatest_child_width(box);
 
+    box.set_cached_shrink_to_fit_widths({ containing_block_width, width, preferred_width, preferred_minimum_width });
     return { preferred_width, preferred_minimum_width };
 }
 
@@ -74,9 +74,11 @@ void Node::paint(PaintContext& context, PaintPhase phase)
 
     before_children_paint(context, phase);
 
-    for_each_child_in_paint_order([&](auto& child) {
-        child.paint(context, phase);
-    });
+    if (context.should_paint_descendants()) {
+        for_each_child_in_paint_order([&](auto& child) {
+            child.paint(context, phase);
+        });
+    }
 
     after_children_paint(context, phase);
 }
@@ -135,6 +137,33 @@ void Node::set_needs_display()
     }
 }
 
+void Node::set_needs_layout()
+{
+    m_needs_layout = true;
+    if (is<Box>(*this))
+        downcast<Box>(*this).invalidate_cached_shrink_to_fit_widths();
+
+    // The intrinsic widths of the ancestors depend on this node as well.
+    for (Node* ancestor = parent(); ancestor; ancestor = ancestor->parent()) {
+        if (is<Box>(*ancestor))
+            downcast<Box>(*ancestor).invalidate_cached_shrink_to_fit_widths();
+        if (ancestor->m_child_needs_layout)
+            break;
+        ancestor->m_child_needs_layout = true;
+    }
+}
+
+void Node::did_layout_subtree()
+{
+    if (!m_needs_layout && !m_child_needs_layout)
+        return;
+    m_needs_layout = false;
+    m_child_needs_layout = false;
+    for_each_child([](auto& child) {
+        child.did_layout_subtree();
+    });
+}
+
 Gfx::FloatPoint Node::box_type_agnostic_position() const
 {
     if (is<Box>(*this))
@@ -131,6 +131,14 @@ public:
 
     virtual void set_needs_display();
 
+    // Nodes start out needing layout, and need it again when their style or contents change.
+    // Their ancestors are marked as having a descendant that needs layout, so that layout
+    // can find the parts of the tree that have to be laid out again.
+    bool needs_layout() const { return m_needs_layout; }
+    bool child_needs_layout() const { return m_child_needs_layout; }
+    void set_needs_layout();
+    void did_layout_subtree();
+
     bool children_are_inline() const { return m_children_are_inline; }
     void set_children_are_inline(bool value) { m_children_are_inline = value; }
 
@@ -179,6 +187,8 @@ private:
     bool m_has_style { false };
     bool m_visible { true };
     bool m_children_are_inline { false };
+    bool m_needs_layout { true };
+    bool m_child_needs_layout { false };
     SelectionState m_selection_state { SelectionState::None };
 };
 
@@ -102,16 +102,11 @@ void TextNode::paint_cursor_if_needed(PaintContext& context, const LineBoxFragme
     context.painter().draw_rect(cursor_rect, computed_values().color());
 }
 
-void TextNode::compute_text_for_rendering(bool collapse, bool previous_is_empty_or_ends_in_whitespace)
+static String collapse_whitespace(const String& text, bool previous_is_empty_or_ends_in_whitespace)
 {
-    if (!collapse) {
-        m_text_for_rendering = dom_node().data();
-        return;
-    }
-
     // Collapse whitespace into single spaces
-    auto utf8_view = Utf8View(dom_node().data());
-    StringBuilder builder(dom_node().data().length());
+    auto utf8_view = Utf8View(text);
+    StringBuilder builder(text.length());
     auto it = utf8_view.begin();
     auto skip_over_whitespace = [&] {
         auto prev = it;
@@ -131,7 +126,43 @@ void TextNode::compute_text_for_rendering(bool collapse, bool previous_is_empty_
             skip_over_whitespace();
         }
     }
-    m_text_for_rendering = builder.to_string();
+    return builder.to_string();
+}
+
+TextNode::TextLayoutCache& TextNode::ensure_text_layout_cache(bool collapse, bool previous_is_empty_or_ends_in_whitespace)
+{
+    auto& cache = m_text_layout_caches[collapse && previous_is_empty_or_ends_in_whitespace ? 1 : 0];
+    auto& data = dom_node().data();
+    if (cache.source.is_null() || cache.source.impl() != data.impl() || cache.collapse != collapse) {
+        cache = {};
+        cache.source = data;
+        cache.collapse = collapse;
+        cache.text_for_rendering = collapse ? collapse_whitespace(data, previous_is_empty_or_ends_in_whitespace) : data;
+    }
+    m_text_for_rendering = cache.text_for_rendering;
+    return cache;
+}
+
+void TextNode::compute_text_for_rendering(bool collapse, bool previous_is_empty_or_ends_in_whitespace)
+{
+    ensure_text_layout_cache(collapse, previous_is_empty_or_ends_in_whitespace);
+}
+
+Vector<TextNode::MeasuredChunk>& TextNode::ensure_measured_chunks(TextLayoutCache& cache, const Gfx::Font& font, LayoutMode layout_mode, bool wrap_lines, bool wrap_breaks)
+{
+    auto& measured_chunks = cache.measured_chunks[static_cast<size_t>(layout_mode)];
+    if (measured_chunks.has_value() && measured_chunks->font == &font && measured_chunks->wrap_lines == wrap_lines && measured_chunks->wrap_breaks == wrap_breaks)
+        return measured_chunks->chunks;
+
+    measured_chunks = MeasuredChunks { const_cast<Gfx::Font*>(&font), wrap_lines, wrap_breaks, {} };
+    ChunkIterator iterator(cache.text_for_rendering, layout_mode, wrap_lines, wrap_breaks);
+    for (;;) {
+        auto chunk = iterator.next();
+        if (!chunk.has_value())
+            break;
+        measured_chunks->chunks.append({ chunk->start, chunk->length, chunk->has_breaking_newline, chunk->is_all_whitespace, font.width(chunk->view), {} });
+    }
+    return measured_chunks->chunks;
 }
 
 void TextNode::split_into_lines_by_rules(InlineFormattingContext& context, LayoutMode layout_mode, bool do_collapse, bool do_wrap_lines, bool do_wrap_breaks)
@@ -144,32 +175,31 @@ void TextNode::split_into_lines_by_rules(InlineFormattingContext& context, Layou
     containing_block.ensure_last_line_box();
     float available_width = context.available_width_at_line(line_boxes.size() - 1) - line_boxes.last().width();
 
-    compute_text_for_rendering(do_collapse, line_boxes.last().is_empty_or_ends_in_whitespace());
-    ChunkIterator iterator(m_text_for_rendering, layout_mode, do_wrap_lines, do_wrap_breaks);
-
-    for (;;) {
-        auto chunk_opt = iterator.next();
-        if (!chunk_opt.has_value())
-            break;
-        auto& chunk = chunk_opt.value();
+    auto& cache = ensure_text_layout_cache(do_collapse, line_boxes.last().is_empty_or_ends_in_whitespace());
+    auto& text = cache.text_for_rendering;
 
+    for (auto& chunk : ensure_measured_chunks(cache, font, layout_mode, do_wrap_lines, do_wrap_breaks)) {
         // Collapse entire fragment into non-existence if previous fragment on line ended in whitespace.
         if (do_collapse && line_boxes.last().is_empty_or_ends_in_whitespace() && chunk.is_all_whitespace)
             continue;
 
+        size_t start = chunk.start;
+        size_t length = chunk.length;
         float chunk_width;
         if (do_wrap_lines) {
-            if (do_collapse && isspace(*chunk.view.begin()) && line_boxes.last().is_empty_or_ends_in_whitespace()) {
+            if (do_collapse && length > 0 && isspace(static_cast<u8>(text[start])) && line_boxes.last().is_empty_or_ends_in_whitespace()) {
                 // This is a non-empty chunk that starts with collapsible whitespace.
                 // We are at either at the start of a new line, or after something that ended in whitespace,
                 // so we don't need to contribute our own whitespace to the line. Skip over it instead!
-                ++chunk.start;
-                --chunk.length;
-                chunk.view = chunk.view.substring_view(1, chunk.view.byte_length() - 1);
+                ++start;
+                --length;
+                if (!chunk.width_without_leading_whitespace.has_value())
+                    chunk.width_without_leading_whitespace = font.width(Utf8View(text.substring_view(start, length)));
+                chunk_width = chunk.width_without_leading_whitespace.value() + font.glyph_spacing();
+            } else {
+                chunk_width = chunk.width + font.glyph_spacing();
             }
 
-            chunk_width = font.width(chunk.view) + font.glyph_spacing();
-
             if (line_boxes.last().width() > 0 && chunk_width > available_width) {
                 containing_block.add_line_box();
                 available_width = context.available_width_at_line(line_boxes.size() - 1);
@@ -178,10 +208,10 @@ void TextNode::split_into_lines_by_rules(InlineFormattingContext& context, Layou
                     continue;
             }
         } else {
-            chunk_width = font.width(chunk.view);
+            chunk_width = chunk.width;
         }
 
-        line_boxes.last().add_fragment(*this, chunk.start, chunk.length, chunk_width, font.glyph_height());
+        line_boxes.last().add_fragment(*this, start, length, chunk_width, font.glyph_height());
         available_width -= chunk_width;
 
         if (do_wrap_lines && available_width < 0) {
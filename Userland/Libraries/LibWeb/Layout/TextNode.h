@@ -64,7 +64,41 @@ private:
     void split_into_lines_by_rules(InlineFormattingContext&, LayoutMode, bool do_collapse, bool do_wrap_lines, bool do_wrap_breaks);
     void paint_cursor_if_needed(PaintContext&, const LineBoxFragment&) const;
 
+    // A chunk along with its width, so that laying out the same text again (e.g after a resize)
+    // only has to break it into lines, instead of finding the chunks and measuring them again.
+    struct MeasuredChunk {
+        size_t start { 0 };
+        size_t length { 0 };
+        bool has_breaking_newline { false };
+        bool is_all_whitespace { false };
+        float width { 0 };
+        Optional<float> width_without_leading_whitespace;
+    };
+
+    struct MeasuredChunks {
+        RefPtr<Gfx::Font> font;
+        bool wrap_lines { false };
+        bool wrap_breaks { false };
+        Vector<MeasuredChunk> chunks;
+    };
+
+    struct TextLayoutCache {
+        // The DOM text this was computed from. Holding on to it means that its identity tells us whether the text has changed.
+        String source;
+        bool collapse { false };
+        String text_for_rendering;
+        // Indexed by LayoutMode.
+        Optional<MeasuredChunks> measured_chunks[3];
+    };
+
+    TextLayoutCache& ensure_text_layout_cache(bool collapse, bool previous_is_empty_or_ends_in_whitespace);
+    Vector<MeasuredChunk>& ensure_measured_chunks(TextLayoutCache&, const Gfx::Font&, LayoutMode, bool wrap_lines, bool wrap_breaks);
+
     String m_text_for_rendering;
+
+    // Collapsible whitespace at the start of the text goes away when it follows other whitespace, making that a different text
+    // to lay out. Which one we get can change back and forth as the lines break differently, so both are kept.
+    TextLayoutCache m_text_layout_caches[2];
 };
 
 template<>
@@ -12,7 +12,7 @@
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
 #include <LibWeb/Loader/CSSLoader.h>
-#include <LibWeb/Loader/ResourceLoader.h>
+#include <LibWeb/Loader/LoadRequest.h>
 
 namespace Web {
 
@@ -38,7 +38,7 @@ void CSSLoader::load_from_url(const URL& url)
     m_style_sheet->set_owner_node(&m_owner_element);
 
     auto request = LoadRequest::create_for_url_on_page(url, m_owner_element.document().page());
-    set_resource(ResourceLoader::the().load_resource(Resource::Type::Generic, request));
+    set_resource(m_owner_element.document().load_resource(Resource::Type::Generic, request));
 }
 
 void CSSLoader::resource_did_load()
@@ -66,6 +66,8 @@ void CSSLoader::resource_did_load()
         m_style_sheet->rules() = sheet->rules();
     }
 
+    m_owner_element.document().style_resolver().invalidate_rule_cache();
+
     if (on_load)
         on_load();
 
@@ -88,7 +90,7 @@ void CSSLoader::load_next_import_if_needed()
 
         LoadRequest request;
         request.set_url(rule.url());
-        set_resource(ResourceLoader::the().load_resource(Resource::Type::Generic, request));
+        set_resource(m_owner_element.document().load_resource(Resource::Type::Generic, request));
     });
 }
 
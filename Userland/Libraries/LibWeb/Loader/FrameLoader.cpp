@@ -7,9 +7,11 @@
 #include <AK/Debug.h>
 #include <AK/LexicalPath.h>
 #include <AK/SourceGenerator.h>
+#include <LibCore/Timer.h>
 #include <LibGemini/Document.h>
 #include <LibGfx/ImageDecoder.h>
 #include <LibMarkdown/Document.h>
+#include <LibTextCodec/Decoder.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/ElementFactory.h>
 #include <LibWeb/DOM/Text.h>
@@ -23,9 +25,14 @@
 
 namespace Web {
 
+static constexpr size_t max_bytes_to_parse_at_once = 16 * KiB;
+
 FrameLoader::FrameLoader(Frame& frame)
     : m_frame(frame)
 {
+    m_parse_timer = Core::Timer::create_single_shot(0, [this] {
+        parse_streamed_data();
+    });
 }
 
 FrameLoader::~FrameLoader()
@@ -140,6 +147,7 @@ bool FrameLoader::load(const LoadRequest& request, Type type)
 
     auto& url = request.url();
 
+    stop_streaming();
     set_resource(ResourceLoader::the().load_resource(Resource::Type::Generic, request));
 
     if (type == Type::Navigation) {
@@ -191,6 +199,7 @@ bool FrameLoader::load(const URL& url, Type type)
 
 void FrameLoader::load_html(const StringView& html, const URL& url)
 {
+    stop_streaming();
     auto document = DOM::Document::create(url);
     HTML::HTMLDocumentParser parser(document, html, "utf-8");
     parser.run(url);
@@ -222,10 +231,124 @@ void FrameLoader::load_error_page(const URL& failed_url, const String& error)
         });
 }
 
+void FrameLoader::stop_streaming()
+{
+    m_parse_timer->stop();
+    m_unparsed_data.clear();
+    m_has_received_data = false;
+    m_has_received_all_data = false;
+
+    if (!m_parser)
+        return;
+
+    // If we're being called from a script that the parser is running, the parser has to stay alive until it returns.
+    if (m_parser->is_running()) {
+        m_parser->abort();
+        m_aborted_parser = move(m_parser);
+        return;
+    }
+    m_parser = nullptr;
+}
+
+NonnullRefPtr<DOM::Document> FrameLoader::create_document_for_resource()
+{
+    auto url = resource()->url();
+    dbgln("I believe this content has MIME type '{}', , encoding '{}'", resource()->mime_type(), resource()->encoding());
+
+    auto document = DOM::Document::create();
+    document->set_url(url);
+    document->set_encoding(resource()->encoding());
+    document->set_content_type(resource()->mime_type());
+
+    frame().set_document(document);
+    return document;
+}
+
+void FrameLoader::resource_did_receive_response()
+{
+    // A resource that's already in flight only gets here if we were there from the start.
+    if (m_has_received_data || m_parser || m_aborted_parser)
+        return;
+
+    if (resource()->mime_type() != "text/html" || resource()->response_headers().contains("Location"))
+        return;
+
+    if (!TextCodec::decoder_for(resource()->encoding()))
+        return;
+
+    auto document = create_document_for_resource();
+
+    // FIXME: Support multiple instances of the Set-Cookie response header.
+    auto set_cookie = resource()->response_headers().get("Set-Cookie");
+    if (set_cookie.has_value())
+        document->set_cookie(set_cookie.value(), Cookie::Source::Http);
+
+    m_parser = make<HTML::HTMLDocumentParser>(document, document->encoding());
+}
+
+void FrameLoader::resource_did_receive_data(ReadonlyBytes data)
+{
+    m_has_received_data = true;
+    if (!m_parser)
+        return;
+
+    m_unparsed_data.enqueue(ByteBuffer::copy(data));
+    if (!m_parse_timer->is_active())
+        m_parse_timer->start();
+}
+
+void FrameLoader::parse_streamed_data()
+{
+    // A script that blocks the parser may spin a nested event loop, but the parser can't be re-entered.
+    // Once it returns, we continue with whatever has arrived in the meantime.
+    if (!m_parser || m_parser->is_running())
+        return;
+
+    auto* parser = m_parser.ptr();
+
+    size_t parsed_byte_count = 0;
+    while (!m_unparsed_data.is_empty() && parsed_byte_count < max_bytes_to_parse_at_once) {
+        auto data = m_unparsed_data.dequeue();
+        parser->append_to_input(data);
+        parsed_byte_count += data.size();
+    }
+
+    bool is_end_of_input = m_has_received_all_data && m_unparsed_data.is_empty();
+    if (is_end_of_input)
+        parser->insert_eof();
+
+    NonnullRefPtr<DOM::Document> document = parser->document();
+    parser->run(document->url());
+
+    // The frame may have started loading something else while a script was running.
+    if (parser->is_aborted()) {
+        if (m_aborted_parser.ptr() == parser)
+            m_aborted_parser = nullptr;
+        return;
+    }
+
+    if (!is_end_of_input) {
+        if (!m_unparsed_data.is_empty())
+            m_parse_timer->start();
+        return;
+    }
+
+    VERIFY(parser->has_finished());
+    m_parser = nullptr;
+    did_finish_loading_document(document);
+}
+
 void FrameLoader::resource_did_load()
 {
     auto url = resource()->url();
 
+    if (m_parser) {
+        m_has_received_all_data = true;
+        if (!m_parse_timer->is_active())
+            m_parse_timer->start();
+        return;
+    }
+
     if (!resource()->has_encoded_data()) {
         load_error_page(url, "No data");
         return;
@@ -238,14 +361,7 @@ void FrameLoader::resource_did_load()
         return;
     }
 
-    dbgln("I believe this content has MIME type '{}', , encoding '{}'", resource()->mime_type(), resource()->encoding());
-
-    auto document = DOM::Document::create();
-    document->set_url(url);
-    document->set_encoding(resource()->encoding());
-    document->set_content_type(resource()->mime_type());
-
-    frame().set_document(document);
+    auto document = create_document_for_resource();
 
     if (!parse_document(*document, resource()->encoded_data())) {
         load_error_page(url, "Failed to parse content.");
@@ -257,6 +373,13 @@ void FrameLoader::resource_did_load()
     if (set_cookie.has_value())
         document->set_cookie(set_cookie.value(), Cookie::Source::Http);
 
+    did_finish_loading_document(document);
+}
+
+void FrameLoader::did_finish_loading_document(DOM::Document& document)
+{
+    auto url = document.url();
+
     if (!url.fragment().is_empty())
         frame().scroll_to_anchor(url.fragment());
 
@@ -272,6 +395,7 @@ void FrameLoader::resource_did_load()
 
 void FrameLoader::resource_did_fail()
 {
+    stop_streaming();
     load_error_page(resource()->url(), resource()->error());
 }
 
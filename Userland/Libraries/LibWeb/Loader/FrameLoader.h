@@ -6,7 +6,11 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
 #include <AK/Forward.h>
+#include <AK/OwnPtr.h>
+#include <AK/Queue.h>
+#include <LibCore/Forward.h>
 #include <LibWeb/Forward.h>
 #include <LibWeb/Loader/Resource.h>
 
@@ -34,13 +38,30 @@ public:
 
 private:
     // ^ResourceClient
+    virtual void resource_did_receive_response() override;
+    virtual void resource_did_receive_data(ReadonlyBytes) override;
     virtual void resource_did_load() override;
     virtual void resource_did_fail() override;
 
     void load_error_page(const URL& failed_url, const String& error_message);
     bool parse_document(DOM::Document&, const ByteBuffer& data);
 
+    NonnullRefPtr<DOM::Document> create_document_for_resource();
+    void did_finish_loading_document(DOM::Document&);
+
+    void parse_streamed_data();
+    void stop_streaming();
+
     Frame& m_frame;
+
+    // HTML documents are parsed while their data is still arriving. The data is handed to the parser
+    // a slice at a time, so that the page can be laid out and painted in between.
+    OwnPtr<HTML::HTMLDocumentParser> m_parser;
+    OwnPtr<HTML::HTMLDocumentParser> m_aborted_parser;
+    RefPtr<Core::Timer> m_parse_timer;
+    Queue<ByteBuffer> m_unparsed_data;
+    bool m_has_received_data { false };
+    bool m_has_received_all_data { false };
 };
 
 }
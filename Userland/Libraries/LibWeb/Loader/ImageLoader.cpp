@@ -9,8 +9,9 @@
 #include <LibGfx/Bitmap.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
+#include <LibWeb/Layout/Box.h>
 #include <LibWeb/Loader/ImageLoader.h>
-#include <LibWeb/Loader/ResourceLoader.h>
+#include <LibWeb/Loader/LoadRequest.h>
 
 namespace Web {
 
@@ -25,7 +26,7 @@ void ImageLoader::load(const URL& url)
     m_loading_state = LoadingState::Loading;
 
     auto request = LoadRequest::create_for_url_on_page(url, m_owner_element.document().page());
-    set_resource(ResourceLoader::the().load_resource(Resource::Type::Image, request));
+    set_resource(m_owner_element.document().load_resource(Resource::Type::Image, request));
 }
 
 void ImageLoader::set_visible_in_viewport(bool visible_in_viewport) const
@@ -52,8 +53,6 @@ void ImageLoader::resource_did_load()
         return;
     }
 
-    m_loading_state = LoadingState::Loaded;
-
     if constexpr (IMAGE_LOADER_DEBUG) {
         if (!resource()->has_encoded_data()) {
             dbgln("ImageLoader: Resource did load, no encoded data. URL: {}", resource()->url());
@@ -62,6 +61,28 @@ void ImageLoader::resource_did_load()
         }
     }
 
+    // The image is decoded in the background, we're done loading once that has finished.
+    // Resources shared with other clients may already have been decoded.
+    if (resource()->has_attempted_decode()) {
+        resource_did_decode();
+        return;
+    }
+    resource()->decode_if_needed();
+}
+
+void ImageLoader::resource_did_decode()
+{
+    VERIFY(resource());
+
+    if (m_loading_state != LoadingState::Loading) {
+        // The image was decoded again, e.g at a larger size or after its frames were discarded.
+        if (auto* layout_node = m_owner_element.layout_node())
+            layout_node->set_needs_display();
+        return;
+    }
+
+    m_loading_state = LoadingState::Loaded;
+
     if (resource()->is_animated() && resource()->frame_count() > 1) {
         m_timer->set_interval(resource()->frame_duration(0));
         m_timer->on_timeout = [this] { animate(); };
@@ -107,21 +128,42 @@ bool ImageLoader::has_image() const
 {
     if (!resource())
         return false;
-    return bitmap(0);
+    return resource()->frame_count() > 0;
 }
 
-unsigned ImageLoader::width() const
+Gfx::IntSize ImageLoader::natural_size() const
 {
     if (!resource())
-        return 0;
-    return bitmap(0) ? bitmap(0)->width() : 0;
+        return {};
+    return resource()->natural_size();
+}
+
+unsigned ImageLoader::width() const
+{
+    return natural_size().width();
 }
 
 unsigned ImageLoader::height() const
 {
-    if (!resource())
-        return 0;
-    return bitmap(0) ? bitmap(0)->height() : 0;
+    return natural_size().height();
+}
+
+Gfx::IntSize ImageLoader::display_size() const
+{
+    // Until the image has loaded, the layout box doesn't know how big the image is going to be.
+    if (m_loading_state == LoadingState::Loaded) {
+        if (auto* layout_node = m_owner_element.layout_node(); layout_node && is<Layout::Box>(*layout_node)) {
+            auto size = enclosing_int_rect(downcast<Layout::Box>(*layout_node).absolute_rect()).size();
+            if (!size.is_empty())
+                return size;
+        }
+    }
+
+    auto width = m_owner_element.attribute(HTML::AttributeNames::width).to_int();
+    auto height = m_owner_element.attribute(HTML::AttributeNames::height).to_int();
+    if (width.value_or(0) > 0 && height.value_or(0) > 0)
+        return { width.value(), height.value() };
+    return {};
 }
 
 const Gfx::Bitmap* ImageLoader::bitmap(size_t frame_index) const
@@ -27,6 +27,7 @@ public:
 
     void set_visible_in_viewport(bool) const;
 
+    Gfx::IntSize natural_size() const;
     unsigned width() const;
     unsigned height() const;
 
@@ -39,6 +40,8 @@ private:
     virtual void resource_did_load() override;
     virtual void resource_did_fail() override;
     virtual bool is_visible_in_viewport() const override { return m_visible_in_viewport; }
+    virtual Gfx::IntSize display_size() const override;
+    virtual void resource_did_decode() override;
 
     void animate();
 
@@ -4,13 +4,20 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Debug.h>
 #include <AK/Function.h>
+#include <AK/HashTable.h>
 #include <LibGfx/Bitmap.h>
 #include <LibImageDecoderClient/Client.h>
 #include <LibWeb/Loader/ImageResource.h>
 
 namespace Web {
 
+// All image resources that currently hold decoded frames, and how much memory those take up in total.
+static HashTable<ImageResource*> s_resources_with_decoded_frames;
+static size_t s_decoded_frames_size_in_bytes { 0 };
+static u64 s_use_counter { 0 };
+
 ImageResource::ImageResource(const LoadRequest& request)
     : Resource(Type::Image, request)
 {
@@ -18,11 +25,11 @@ ImageResource::ImageResource(const LoadRequest& request)
 
 ImageResource::~ImageResource()
 {
+    discard_decoded_frames();
 }
 
 int ImageResource::frame_duration(size_t frame_index) const
 {
-    decode_if_needed();
     if (frame_index >= m_decoded_frames.size())
         return 0;
     return m_decoded_frames[frame_index].duration;
@@ -40,21 +47,83 @@ static ImageDecoderClient::Client& image_decoder_client()
     return *image_decoder_client;
 }
 
+Gfx::IntSize ImageResource::ideal_decoded_size() const
+{
+    // The image is decoded big enough for its largest client. If any client doesn't know
+    // how big it displays the image, it gets decoded at its natural size.
+    Gfx::IntSize ideal_size;
+    bool has_client_without_display_size = false;
+    const_cast<ImageResource&>(*this).for_each_client([&](auto& client) {
+        auto display_size = static_cast<const ImageResourceClient&>(client).display_size();
+        if (display_size.is_empty()) {
+            has_client_without_display_size = true;
+            return;
+        }
+        ideal_size.set_width(max(ideal_size.width(), display_size.width()));
+        ideal_size.set_height(max(ideal_size.height(), display_size.height()));
+    });
+    if (has_client_without_display_size)
+        return {};
+    return ideal_size;
+}
+
+bool ImageResource::is_visible_in_viewport() const
+{
+    bool visible_in_viewport = false;
+    const_cast<ImageResource&>(*this).for_each_client([&](auto& client) {
+        if (static_cast<const ImageResourceClient&>(client).is_visible_in_viewport())
+            visible_in_viewport = true;
+    });
+    return visible_in_viewport;
+}
+
 void ImageResource::decode_if_needed() const
 {
     if (!has_encoded_data())
         return;
 
-    if (m_has_attempted_decode)
+    if (m_is_decoding)
         return;
 
-    if (!m_decoded_frames.is_empty())
+    auto ideal_size = ideal_decoded_size();
+
+    if (m_has_attempted_decode) {
+        // The image couldn't be decoded, no point in trying again.
+        if (m_decoded_frames.is_empty())
+            return;
+
+        if (has_decoded_frames()) {
+            auto wanted_size = ideal_size.is_empty() ? m_natural_size : ideal_size;
+            bool is_big_enough = m_decoded_size.width() >= min(wanted_size.width(), m_natural_size.width())
+                && m_decoded_size.height() >= min(wanted_size.height(), m_natural_size.height());
+            if (is_big_enough)
+                return;
+        }
+    }
+
+    dbgln_if(IMAGE_LOADER_DEBUG, "ImageResource: Decoding {} for display at {}", url(), ideal_size);
+
+    m_is_decoding = true;
+    NonnullRefPtr<ImageResource> protector = const_cast<ImageResource&>(*this);
+    image_decoder_client().start_decoding_image(encoded_data(), ideal_size, [protector](auto image) mutable {
+        protector->did_decode(move(image));
+    });
+}
+
+void ImageResource::did_decode(Optional<ImageDecoderClient::DecodedImage> image)
+{
+    m_is_decoding = false;
+    m_has_attempted_decode = true;
+
+    // If re-decoding an image we've decoded before fails (e.g because the decoder crashed),
+    // keep whatever we had. Otherwise, clients are notified that the image is broken.
+    if (!image.has_value() && !m_decoded_frames.is_empty())
         return;
 
-    NonnullRefPtr decoder = image_decoder_client();
-    auto image = decoder->decode_image(encoded_data());
+    discard_decoded_frames();
 
     if (image.has_value()) {
+        m_natural_size = image.value().size;
         m_loop_count = image.value().loop_count;
         m_animated = image.value().is_animated;
         m_decoded_frames.resize(image.value().frames.size());
@@ -62,15 +131,60 @@ void ImageResource::decode_if_needed() const
             auto& frame = m_decoded_frames[i];
             frame.bitmap = image.value().frames[i].bitmap;
             frame.duration = image.value().frames[i].duration;
+            if (frame.bitmap)
+                m_decoded_size_in_bytes += frame.bitmap->size_in_bytes();
         }
+        if (!m_decoded_frames.is_empty() && m_decoded_frames[0].bitmap)
+            m_decoded_size = m_decoded_frames[0].bitmap->size();
     }
 
-    m_has_attempted_decode = true;
+    if (has_decoded_frames()) {
+        m_last_use = ++s_use_counter;
+        s_resources_with_decoded_frames.set(this);
+        s_decoded_frames_size_in_bytes += m_decoded_size_in_bytes;
+        discard_decoded_frames_if_needed(*this);
+    }
+
+    for_each_client([](auto& client) {
+        static_cast<ImageResourceClient&>(client).resource_did_decode();
+    });
+}
+
+void ImageResource::discard_decoded_frames()
+{
+    // The frames themselves are kept around (without bitmaps), so that the metadata is still available.
+    for (auto& frame : m_decoded_frames)
+        frame.bitmap = nullptr;
+    m_decoded_size = {};
+
+    if (!has_decoded_frames())
+        return;
+    s_resources_with_decoded_frames.remove(this);
+    s_decoded_frames_size_in_bytes -= m_decoded_size_in_bytes;
+    m_decoded_size_in_bytes = 0;
+}
+
+void ImageResource::discard_decoded_frames_if_needed(const ImageResource& keep)
+{
+    while (s_decoded_frames_size_in_bytes > decoded_frames_size_limit_in_bytes) {
+        ImageResource* least_recently_used = nullptr;
+        for (auto* resource : s_resources_with_decoded_frames) {
+            if (resource == &keep || resource->is_visible_in_viewport())
+                continue;
+            if (!least_recently_used || resource->m_last_use < least_recently_used->m_last_use)
+                least_recently_used = resource;
+        }
+        if (!least_recently_used)
+            break;
+        dbgln_if(IMAGE_LOADER_DEBUG, "ImageResource: Discarding decoded frames of {} ({} bytes)", least_recently_used->url(), least_recently_used->m_decoded_size_in_bytes);
+        least_recently_used->discard_decoded_frames();
+    }
 }
 
 const Gfx::Bitmap* ImageResource::bitmap(size_t frame_index) const
 {
     decode_if_needed();
+    m_last_use = ++s_use_counter;
     if (frame_index >= m_decoded_frames.size())
         return nullptr;
     return m_decoded_frames[frame_index].bitmap;
@@ -78,13 +192,7 @@ const Gfx::Bitmap* ImageResource::bitmap(size_t frame_index) const
 
 void ImageResource::update_volatility()
 {
-    bool visible_in_viewport = false;
-    for_each_client([&](auto& client) {
-        if (static_cast<const ImageResourceClient&>(client).is_visible_in_viewport())
-            visible_in_viewport = true;
-    });
-
-    if (!visible_in_viewport) {
+    if (!is_visible_in_viewport()) {
         for (auto& frame : m_decoded_frames) {
             if (frame.bitmap)
                 frame.bitmap->set_volatile();
@@ -105,8 +213,8 @@ void ImageResource::update_volatility()
     if (still_has_decoded_image)
         return;
 
-    m_decoded_frames.clear();
-    m_has_attempted_decode = false;
+    discard_decoded_frames();
+    decode_if_needed();
 }
 
 ImageResourceClient::~ImageResourceClient()
@@ -6,8 +6,14 @@
 
 #pragma once
 
+#include <AK/Optional.h>
+#include <LibGfx/Size.h>
 #include <LibWeb/Loader/Resource.h>
 
+namespace ImageDecoderClient {
+struct DecodedImage;
+}
+
 namespace Web {
 
 class ImageResource final : public Resource {
@@ -21,35 +27,43 @@ public:
         size_t duration { 0 };
     };
 
+    // Returns null while the image is being decoded. Asking for a bitmap (re)starts decoding if needed,
+    // e.g. when the frames have been discarded to save memory or the image is displayed larger than it was decoded.
     const Gfx::Bitmap* bitmap(size_t frame_index = 0) const;
     int frame_duration(size_t frame_index) const;
-    size_t frame_count() const
-    {
-        decode_if_needed();
-        return m_decoded_frames.size();
-    }
-    bool is_animated() const
-    {
-        decode_if_needed();
-        return m_animated;
-    }
-    size_t loop_count() const
-    {
-        decode_if_needed();
-        return m_loop_count;
-    }
+
+    // These are only valid once the first decode has finished, see ImageResourceClient::resource_did_decode().
+    size_t frame_count() const { return m_decoded_frames.size(); }
+    bool is_animated() const { return m_animated; }
+    size_t loop_count() const { return m_loop_count; }
+    Gfx::IntSize natural_size() const { return m_natural_size; }
+
+    bool has_attempted_decode() const { return m_has_attempted_decode; }
+    void decode_if_needed() const;
 
     void update_volatility();
 
+    static constexpr size_t decoded_frames_size_limit_in_bytes = 64 * MiB;
+
 private:
     explicit ImageResource(const LoadRequest&);
 
-    void decode_if_needed() const;
+    Gfx::IntSize ideal_decoded_size() const;
+    bool is_visible_in_viewport() const;
+    bool has_decoded_frames() const { return m_decoded_size_in_bytes > 0; }
+    void did_decode(Optional<ImageDecoderClient::DecodedImage>);
+    void discard_decoded_frames();
+    static void discard_decoded_frames_if_needed(const ImageResource& keep);
 
     mutable bool m_animated { false };
     mutable int m_loop_count { 0 };
     mutable Vector<Frame> m_decoded_frames;
     mutable bool m_has_attempted_decode { false };
+    mutable bool m_is_decoding { false };
+    mutable Gfx::IntSize m_natural_size;
+    mutable Gfx::IntSize m_decoded_size;
+    mutable size_t m_decoded_size_in_bytes { 0 };
+    mutable u64 m_last_use { 0 };
 };
 
 class ImageResourceClient : public ResourceClient {
@@ -58,6 +72,12 @@ public:
 
     virtual bool is_visible_in_viewport() const { return false; }
 
+    // The size the image is displayed at, so that it can be decoded no larger than needed.
+    // An empty size means the image is decoded at its natural size.
+    virtual Gfx::IntSize display_size() const { return {}; }
+
+    virtual void resource_did_decode() { }
+
 protected:
     ImageResource* resource() { return static_cast<ImageResource*>(ResourceClient::resource()); }
     const ImageResource* resource() const { return static_cast<const ImageResource*>(ResourceClient::resource()); }
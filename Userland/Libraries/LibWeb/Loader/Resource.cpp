@@ -65,13 +65,40 @@ static String mime_type_from_content_type(const String& content_type)
     return content_type;
 }
 
+void Resource::did_receive_response(Badge<ResourceLoader>, const HashMap<String, String, CaseInsensitiveStringTraits>& headers, Optional<u32> status_code)
+{
+    VERIFY(!m_loaded);
+    set_response(headers, status_code);
+
+    for_each_client([](auto& client) {
+        client.resource_did_receive_response();
+    });
+}
+
+void Resource::did_receive_data(Badge<ResourceLoader>, ReadonlyBytes data)
+{
+    VERIFY(!m_loaded);
+    for_each_client([&](auto& client) {
+        client.resource_did_receive_data(data);
+    });
+}
+
 void Resource::did_load(Badge<ResourceLoader>, ReadonlyBytes data, const HashMap<String, String, CaseInsensitiveStringTraits>& headers, Optional<u32> status_code)
 {
     VERIFY(!m_loaded);
     m_encoded_data = ByteBuffer::copy(data);
+    set_response(headers, status_code);
+    m_loaded = true;
+
+    for_each_client([](auto& client) {
+        client.resource_did_load();
+    });
+}
+
+void Resource::set_response(const HashMap<String, String, CaseInsensitiveStringTraits>& headers, Optional<u32> status_code)
+{
     m_response_headers = headers;
     m_status_code = move(status_code);
-    m_loaded = true;
 
     auto content_type = headers.get("Content-Type");
     if (content_type.has_value()) {
@@ -91,10 +118,6 @@ void Resource::did_load(Badge<ResourceLoader>, ReadonlyBytes data, const HashMap
         m_encoding = "utf-8"; // FIXME: This doesn't seem nice.
         m_mime_type = Core::guess_mime_type_based_on_filename(url().path());
     }
-
-    for_each_client([](auto& client) {
-        client.resource_did_load();
-    });
 }
 
 void Resource::did_fail(Badge<ResourceLoader>, const String& error, Optional<u32> status_code)
@@ -48,6 +48,7 @@ public:
     const ByteBuffer& encoded_data() const { return m_encoded_data; }
 
     const HashMap<String, String, CaseInsensitiveStringTraits>& response_headers() const { return m_response_headers; }
+    const Optional<u32>& status_code() const { return m_status_code; }
 
     void register_client(Badge<ResourceClient>, ResourceClient&);
     void unregister_client(Badge<ResourceClient>, ResourceClient&);
@@ -57,6 +58,10 @@ public:
 
     void for_each_client(Function<void(ResourceClient&)>);
 
+    // These are only called for resources whose data is streamed in as it arrives, before did_load().
+    void did_receive_response(Badge<ResourceLoader>, const HashMap<String, String, CaseInsensitiveStringTraits>& headers, Optional<u32> status_code);
+    void did_receive_data(Badge<ResourceLoader>, ReadonlyBytes data);
+
     void did_load(Badge<ResourceLoader>, ReadonlyBytes data, const HashMap<String, String, CaseInsensitiveStringTraits>& headers, Optional<u32> status_code);
     void did_fail(Badge<ResourceLoader>, const String& error, Optional<u32> status_code);
 
@@ -64,6 +69,8 @@ protected:
     explicit Resource(Type, const LoadRequest&);
 
 private:
+    void set_response(const HashMap<String, String, CaseInsensitiveStringTraits>& headers, Optional<u32> status_code);
+
     LoadRequest m_request;
     ByteBuffer m_encoded_data;
     Type m_type { Type::Generic };
@@ -81,6 +88,8 @@ class ResourceClient : public Weakable<ResourceClient> {
 public:
     virtual ~ResourceClient();
 
+    virtual void resource_did_receive_response() { }
+    virtual void resource_did_receive_data(ReadonlyBytes) { }
     virtual void resource_did_load() { }
     virtual void resource_did_fail() { }
 
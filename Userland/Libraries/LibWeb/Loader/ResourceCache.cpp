@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <LibCore/DateTime.h>
+#include <LibWeb/Cookie/ParsedCookie.h>
+#include <LibWeb/Loader/ResourceCache.h>
+
+namespace Web {
+
+struct CacheControl {
+    bool no_store { false };
+    bool no_cache { false };
+    Optional<time_t> max_age;
+};
+
+static CacheControl parse_cache_control(const ResourceCache::Headers& headers)
+{
+    // https://tools.ietf.org/html/rfc7234#section-5.2
+    CacheControl cache_control;
+    auto value = headers.get("Cache-Control");
+    if (!value.has_value()) {
+        // https://tools.ietf.org/html/rfc7234#section-5.4
+        if (auto pragma = headers.get("Pragma"); pragma.has_value() && pragma->trim_whitespace().equals_ignoring_case("no-cache"))
+            cache_control.no_cache = true;
+        return cache_control;
+    }
+
+    for (auto directive : value->split_view(',')) {
+        directive = directive.trim_whitespace();
+        if (directive.equals_ignoring_case("no-store")) {
+            cache_control.no_store = true;
+        } else if (directive.equals_ignoring_case("no-cache")) {
+            cache_control.no_cache = true;
+        } else if (directive.starts_with("max-age=", CaseSensitivity::CaseInsensitive)) {
+            auto seconds = directive.substring_view(8).to_uint();
+            // A malformed max-age means the response is stale.
+            cache_control.max_age = seconds.value_or(0);
+        }
+    }
+    return cache_control;
+}
+
+static Optional<time_t> parse_date_header(const ResourceCache::Headers& headers, const String& name)
+{
+    auto value = headers.get(name);
+    if (!value.has_value())
+        return {};
+    auto date_time = Cookie::parse_date_time(*value);
+    if (!date_time.has_value())
+        return {};
+    return date_time->timestamp();
+}
+
+static bool is_cacheable_status_code(Optional<u32> status_code)
+{
+    // Resources that didn't come from HTTP (e.g data: URLs) don't change.
+    if (!status_code.has_value())
+        return true;
+
+    // https://tools.ietf.org/html/rfc7231#section-6.1
+    switch (*status_code) {
+    case 200:
+    case 203:
+    case 204:
+    case 300:
+    case 301:
+    case 404:
+    case 405:
+    case 410:
+    case 414:
+    case 501:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static time_t explicit_or_heuristic_freshness_lifetime(const ResourceCache::Headers& headers, const CacheControl& cache_control, time_t response_time)
+{
+    // https://tools.ietf.org/html/rfc7234#section-4.2.1
+    if (cache_control.max_age.has_value())
+        return *cache_control.max_age;
+
+    // https://tools.ietf.org/html/rfc7231#section-7.1.1.2
+    // Without a Date header, the time the response was received is used instead.
+    auto date = parse_date_header(headers, "Date").value_or(response_time);
+
+    if (headers.contains("Expires")) {
+        // An invalid Expires date means the response is already stale.
+        auto expires = parse_date_header(headers, "Expires");
+        if (!expires.has_value() || *expires <= date)
+            return 0;
+        return *expires - date;
+    }
+
+    // https://tools.ietf.org/html/rfc7234#section-4.2.2
+    // Without explicit freshness, use 10% of the time since the response was last modified, up to a day.
+    auto last_modified = parse_date_header(headers, "Last-Modified");
+    if (last_modified.has_value() && date > *last_modified)
+        return min((date - *last_modified) / 10, static_cast<time_t>(24 * 60 * 60));
+
+    return 0;
+}
+
+bool ResourceCache::is_storable(const Headers& headers, Optional<u32> status_code)
+{
+    return !parse_cache_control(headers).no_store && is_cacheable_status_code(status_code);
+}
+
+time_t ResourceCache::freshness_lifetime(const Headers& headers, Optional<u32> status_code, time_t response_time)
+{
+    if (!status_code.has_value())
+        return NumericLimits<time_t>::max();
+
+    auto cache_control = parse_cache_control(headers);
+    if (cache_control.no_cache)
+        return 0;
+
+    auto lifetime = explicit_or_heuristic_freshness_lifetime(headers, cache_control, response_time);
+
+    // https://tools.ietf.org/html/rfc7234#section-4.2.3
+    // The time the response already spent in other caches counts against its lifetime.
+    if (auto age = headers.get("Age"); age.has_value())
+        lifetime = max(lifetime - static_cast<time_t>(age->to_uint().value_or(0)), static_cast<time_t>(0));
+
+    return lifetime;
+}
+
+ResourceCache& ResourceCache::the()
+{
+    static ResourceCache* cache = new ResourceCache;
+    return *cache;
+}
+
+ResourceCache::ResourceCache()
+{
+}
+
+ResourceCache::~ResourceCache()
+{
+}
+
+ResourceCache::Entry* ResourceCache::get(const LoadRequest& request)
+{
+    auto it = m_entries.find(request);
+    if (it == m_entries.end())
+        return nullptr;
+    it->value.last_use = ++m_use_counter;
+    return &it->value;
+}
+
+void ResourceCache::set(const LoadRequest& request, NonnullRefPtr<Resource> resource)
+{
+    remove(request);
+    m_entries.set(request, Entry { move(resource), 0, 0, 0, ++m_use_counter });
+}
+
+void ResourceCache::remove(const LoadRequest& request)
+{
+    auto it = m_entries.find(request);
+    if (it == m_entries.end())
+        return;
+    m_size_in_bytes -= it->value.size_in_bytes;
+    m_entries.remove(it);
+}
+
+void ResourceCache::clear()
+{
+    dbgln("Clearing {} items from ResourceLoader cache", m_entries.size());
+    m_entries.clear();
+    m_size_in_bytes = 0;
+}
+
+void ResourceCache::did_load(const LoadRequest& request, const Resource& resource)
+{
+    did_receive_response(request, resource, resource.response_headers(), resource.status_code(), resource.encoded_data().size(), time(nullptr));
+}
+
+void ResourceCache::did_receive_response(const LoadRequest& request, const Resource& resource, const Headers& headers, Optional<u32> status_code, size_t size_in_bytes, time_t response_time)
+{
+    auto it = m_entries.find(request);
+    if (it == m_entries.end() || it->value.resource.ptr() != &resource)
+        return;
+
+    if (!is_storable(headers, status_code)) {
+        dbgln_if(CACHE_DEBUG, "Not caching {}", request.url());
+        m_size_in_bytes -= it->value.size_in_bytes;
+        m_entries.remove(it);
+        return;
+    }
+
+    auto& entry = it->value;
+    entry.response_time = response_time;
+    entry.freshness_lifetime = freshness_lifetime(headers, status_code, response_time);
+
+    m_size_in_bytes -= entry.size_in_bytes;
+    entry.size_in_bytes = size_in_bytes;
+    m_size_in_bytes += entry.size_in_bytes;
+
+    dbgln_if(CACHE_DEBUG, "Cached {} ({} bytes, fresh for {}s), cache is now {} bytes", request.url(), entry.size_in_bytes, entry.freshness_lifetime, m_size_in_bytes);
+    evict_if_needed();
+}
+
+void ResourceCache::did_fail(const LoadRequest& request, const Resource& resource)
+{
+    // The request may have been loaded again in the meantime, in which case the entry isn't ours to remove.
+    auto it = m_entries.find(request);
+    if (it == m_entries.end() || it->value.resource.ptr() != &resource)
+        return;
+    m_size_in_bytes -= it->value.size_in_bytes;
+    m_entries.remove(it);
+}
+
+bool ResourceCache::is_fresh(const Entry& entry, time_t now) const
+{
+    if (entry.freshness_lifetime == NumericLimits<time_t>::max())
+        return true;
+    return now - entry.response_time < entry.freshness_lifetime;
+}
+
+bool ResourceCache::has_validators(const Headers& headers)
+{
+    return headers.contains("ETag") || headers.contains("Last-Modified");
+}
+
+void ResourceCache::add_validators_to_request(LoadRequest& request, const Headers& headers)
+{
+    // https://tools.ietf.org/html/rfc7232#section-3
+    if (auto etag = headers.get("ETag"); etag.has_value())
+        request.set_header("If-None-Match", *etag);
+    if (auto last_modified = headers.get("Last-Modified"); last_modified.has_value())
+        request.set_header("If-Modified-Since", *last_modified);
+}
+
+ResourceCache::Headers ResourceCache::headers_after_revalidation(const Headers& stored_headers, const Headers& not_modified_headers)
+{
+    // https://tools.ietf.org/html/rfc7234#section-4.3.4
+    auto headers = stored_headers;
+    for (auto& it : not_modified_headers)
+        headers.set(it.key, it.value);
+    return headers;
+}
+
+void ResourceCache::set_size_limit_in_bytes(size_t limit)
+{
+    m_size_limit_in_bytes = limit;
+    evict_if_needed();
+}
+
+void ResourceCache::evict_if_needed()
+{
+    while (m_size_in_bytes > m_size_limit_in_bytes) {
+        auto least_recently_used = m_entries.end();
+        for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+            // Resources that are still loading don't take up any space yet.
+            if (it->value.size_in_bytes == 0)
+                continue;
+            if (least_recently_used == m_entries.end() || it->value.last_use < least_recently_used->value.last_use)
+                least_recently_used = it;
+        }
+        if (least_recently_used == m_entries.end())
+            break;
+        dbgln_if(CACHE_DEBUG, "Evicting {} ({} bytes) from the cache", least_recently_used->key.url(), least_recently_used->value.size_in_bytes);
+        m_size_in_bytes -= least_recently_used->value.size_in_bytes;
+        m_entries.remove(least_recently_used);
+    }
+}
+
+}
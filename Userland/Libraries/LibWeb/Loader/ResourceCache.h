@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/NonnullRefPtr.h>
+#include <LibWeb/Loader/LoadRequest.h>
+#include <LibWeb/Loader/Resource.h>
+#include <time.h>
+
+namespace Web {
+
+// An in-memory HTTP cache (RFC 7234) for resources loaded through ResourceLoader.
+// Responses are reused while they are fresh, revalidated with their validators (ETag / Last-Modified)
+// once they have gone stale, and the least recently used ones are evicted when the cache gets too big.
+class ResourceCache {
+public:
+    using Headers = HashMap<String, String, CaseInsensitiveStringTraits>;
+
+    static ResourceCache& the();
+
+    struct Entry {
+        NonnullRefPtr<Resource> resource;
+        time_t response_time { 0 };
+        time_t freshness_lifetime { 0 };
+        size_t size_in_bytes { 0 };
+        u64 last_use { 0 };
+    };
+
+    Entry* get(const LoadRequest&);
+    void set(const LoadRequest&, NonnullRefPtr<Resource>);
+    void remove(const LoadRequest&);
+    void clear();
+
+    // Must be called when the resource cached for the request has finished loading, or failed to load.
+    void did_load(const LoadRequest&, const Resource&);
+    void did_fail(const LoadRequest&, const Resource&);
+
+    // Stores (or drops) the entry for the resource cached for the request, given the response it was loaded with
+    // and the time that response was received. did_load() calls this with the resource's own response.
+    void did_receive_response(const LoadRequest&, const Resource&, const Headers&, Optional<u32> status_code, size_t size_in_bytes, time_t response_time);
+
+    bool is_fresh(const Entry& entry) const { return is_fresh(entry, time(nullptr)); }
+    bool is_fresh(const Entry&, time_t now) const;
+
+    static bool is_storable(const Headers&, Optional<u32> status_code);
+    static time_t freshness_lifetime(const Headers&, Optional<u32> status_code, time_t response_time);
+
+    static bool has_validators(const Headers&);
+    static void add_validators_to_request(LoadRequest&, const Headers&);
+    // The headers a stored response has after being revalidated with a 304 (Not Modified) response.
+    static Headers headers_after_revalidation(const Headers& stored_headers, const Headers& not_modified_headers);
+
+    size_t entry_count() const { return m_entries.size(); }
+    size_t size_in_bytes() const { return m_size_in_bytes; }
+    void set_size_limit_in_bytes(size_t limit);
+
+private:
+    ResourceCache();
+    ~ResourceCache();
+
+    void evict_if_needed();
+
+    HashMap<LoadRequest, Entry> m_entries;
+    size_t m_size_in_bytes { 0 };
+    size_t m_size_limit_in_bytes { 32 * MiB };
+    u64 m_use_counter { 0 };
+};
+
+}
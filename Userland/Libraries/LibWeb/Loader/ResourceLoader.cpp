@@ -14,6 +14,7 @@
 #include <LibWeb/Loader/ContentFilter.h>
 #include <LibWeb/Loader/LoadRequest.h>
 #include <LibWeb/Loader/Resource.h>
+#include <LibWeb/Loader/ResourceCache.h>
 #include <LibWeb/Loader/ResourceLoader.h>
 
 namespace Web {
@@ -51,7 +52,40 @@ void ResourceLoader::load_sync(const LoadRequest& request, Function<void(Readonl
     loop.exec();
 }
 
-static HashMap<LoadRequest, NonnullRefPtr<Resource>> s_resource_cache;
+class SyncResourceClient final : public ResourceClient {
+public:
+    SyncResourceClient(Resource& resource, Core::EventLoop& loop)
+        : m_type(resource.type())
+        , m_loop(loop)
+    {
+        set_resource(&resource);
+    }
+
+    virtual ~SyncResourceClient() override
+    {
+        set_resource(nullptr);
+    }
+
+private:
+    virtual Resource::Type client_type() const override { return m_type; }
+    virtual void resource_did_load() override { m_loop.quit(0); }
+    virtual void resource_did_fail() override { m_loop.quit(0); }
+
+    Resource::Type m_type;
+    Core::EventLoop& m_loop;
+};
+
+RefPtr<Resource> ResourceLoader::load_resource_sync(Resource::Type type, const LoadRequest& request)
+{
+    auto resource = load_resource(type, request);
+    if (!resource || resource->is_loaded() || resource->is_failed())
+        return resource;
+
+    Core::EventLoop loop;
+    SyncResourceClient client(*resource, loop);
+    loop.exec();
+    return resource;
+}
 
 RefPtr<Resource> ResourceLoader::load_resource(Resource::Type type, const LoadRequest& request)
 {
@@ -59,15 +93,26 @@ RefPtr<Resource> ResourceLoader::load_resource(Resource::Type type, const LoadRe
         return nullptr;
 
     bool use_cache = request.url().protocol() != "file";
+    auto& cache = ResourceCache::the();
+
+    // A stale response that can be validated is loaded again with a conditional request.
+    // If the server says it hasn't changed (304 Not Modified), the cached response is used.
+    RefPtr<Resource> stale_resource;
 
     if (use_cache) {
-        auto it = s_resource_cache.find(request);
-        if (it != s_resource_cache.end()) {
-            if (it->value->type() != type) {
+        if (auto* entry = cache.get(request)) {
+            auto& cached_resource = entry->resource;
+            if (cached_resource->type() != type) {
                 dbgln("FIXME: Not using cached resource for {} since there's a type mismatch.", request.url());
-            } else {
+            } else if (!cached_resource->is_loaded() && !cached_resource->is_failed()) {
+                dbgln_if(CACHE_DEBUG, "Reusing pending resource for: {}", request.url());
+                return cached_resource;
+            } else if (cached_resource->is_loaded() && cache.is_fresh(*entry)) {
                 dbgln_if(CACHE_DEBUG, "Reusing cached resource for: {}", request.url());
-                return it->value;
+                return cached_resource;
+            } else if (cached_resource->is_loaded() && ResourceCache::has_validators(cached_resource->response_headers())) {
+                dbgln_if(CACHE_DEBUG, "Revalidating cached resource for: {}", request.url());
+                stale_resource = cached_resource;
             }
         }
     }
@@ -75,21 +120,41 @@ RefPtr<Resource> ResourceLoader::load_resource(Resource::Type type, const LoadRe
     auto resource = Resource::create({}, type, request);
 
     if (use_cache)
-        s_resource_cache.set(request, resource);
+        cache.set(request, resource);
 
-    load(
-        request,
+    auto request_to_load = request;
+    if (stale_resource)
+        ResourceCache::add_validators_to_request(request_to_load, stale_resource->response_headers());
+
+    // A revalidated response may just be a 304, so only fresh loads are streamed.
+    start_load(
+        request_to_load,
+        stale_resource ? nullptr : RefPtr<Resource>(resource),
         [=](auto data, auto& headers, auto status_code) {
-            const_cast<Resource&>(*resource).did_load({}, data, headers, status_code);
+            if (stale_resource && status_code.has_value() && *status_code == 304) {
+                auto updated_headers = ResourceCache::headers_after_revalidation(stale_resource->response_headers(), headers);
+                const_cast<Resource&>(*resource).did_load({}, stale_resource->encoded_data(), updated_headers, stale_resource->status_code());
+            } else {
+                const_cast<Resource&>(*resource).did_load({}, data, headers, status_code);
+            }
+            if (use_cache)
+                ResourceCache::the().did_load(request, *resource);
         },
         [=](auto& error, auto status_code) {
             const_cast<Resource&>(*resource).did_fail({}, error, status_code);
+            if (use_cache)
+                ResourceCache::the().did_fail(request, *resource);
         });
 
     return resource;
 }
 
 void ResourceLoader::load(const LoadRequest& request, Function<void(ReadonlyBytes, const HashMap<String, String, CaseInsensitiveStringTraits>& response_headers, Optional<u32> status_code)> success_callback, Function<void(const String&, Optional<u32> status_code)> error_callback)
+{
+    start_load(request, nullptr, move(success_callback), move(error_callback));
+}
+
+void ResourceLoader::start_load(const LoadRequest& request, RefPtr<Resource> streaming_resource, Function<void(ReadonlyBytes, const HashMap<String, String, CaseInsensitiveStringTraits>& response_headers, Optional<u32> status_code)> success_callback, Function<void(const String&, Optional<u32> status_code)> error_callback)
 {
     auto& url = request.url();
 
@@ -162,6 +227,14 @@ void ResourceLoader::load(const LoadRequest& request, Function<void(ReadonlyByte
                 error_callback("Failed to initiate load", {});
             return;
         }
+        if (streaming_resource) {
+            protocol_request->on_headers_received = [streaming_resource](auto& response_headers, auto status_code) {
+                const_cast<Resource&>(*streaming_resource).did_receive_response({}, response_headers, status_code);
+            };
+            protocol_request->on_data_received = [streaming_resource](auto data) {
+                const_cast<Resource&>(*streaming_resource).did_receive_data({}, data);
+            };
+        }
         protocol_request->on_buffered_request_finish = [this, success_callback = move(success_callback), error_callback = move(error_callback), protocol_request](bool success, auto, auto& response_headers, auto status_code, ReadonlyBytes payload) {
             --m_pending_loads;
             if (on_load_counter_change)
@@ -213,8 +286,7 @@ bool ResourceLoader::is_port_blocked(int port)
 
 void ResourceLoader::clear_cache()
 {
-    dbgln("Clearing {} items from ResourceLoader cache", s_resource_cache.size());
-    s_resource_cache.clear();
+    ResourceCache::the().clear();
 }
 
 }
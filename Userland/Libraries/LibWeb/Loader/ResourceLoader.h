@@ -25,6 +25,7 @@ public:
     static ResourceLoader& the();
 
     RefPtr<Resource> load_resource(Resource::Type, const LoadRequest&);
+    RefPtr<Resource> load_resource_sync(Resource::Type, const LoadRequest&);
 
     void load(const LoadRequest&, Function<void(ReadonlyBytes, const HashMap<String, String, CaseInsensitiveStringTraits>& response_headers, Optional<u32> status_code)> success_callback, Function<void(const String&, Optional<u32> status_code)> error_callback = nullptr);
     void load(const URL&, Function<void(ReadonlyBytes, const HashMap<String, String, CaseInsensitiveStringTraits>& response_headers, Optional<u32> status_code)> success_callback, Function<void(const String&, Optional<u32> status_code)> error_callback = nullptr);
@@ -45,6 +46,9 @@ private:
     ResourceLoader();
     static bool is_port_blocked(int port);
 
+    // If a streaming resource is given, it's told about the response and each chunk of data as soon as they arrive.
+    void start_load(const LoadRequest&, RefPtr<Resource> streaming_resource, Function<void(ReadonlyBytes, const HashMap<String, String, CaseInsensitiveStringTraits>& response_headers, Optional<u32> status_code)> success_callback, Function<void(const String&, Optional<u32> status_code)> error_callback);
+
     int m_pending_loads { 0 };
 
     RefPtr<Protocol::RequestClient> m_protocol_client;
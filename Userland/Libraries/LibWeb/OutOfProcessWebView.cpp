@@ -195,15 +195,24 @@ void OutOfProcessWebView::screen_rect_change_event(GUI::ScreenRectChangeEvent& e
     client().post_message(Messages::WebContentServer::UpdateScreenRect(event.rect()));
 }
 
-void OutOfProcessWebView::notify_server_did_paint(Badge<WebContentClient>, i32 bitmap_id)
+void OutOfProcessWebView::notify_server_did_paint(Badge<WebContentClient>, const Gfx::IntRect& content_rect, i32 bitmap_id, const Vector<Gfx::IntRect>& painted_content_rects)
 {
     if (m_client_state.back_bitmap_id == bitmap_id) {
+        bool had_usable_bitmap = m_client_state.has_usable_bitmap;
         m_client_state.has_usable_bitmap = true;
         swap(m_client_state.back_bitmap, m_client_state.front_bitmap);
         swap(m_client_state.back_bitmap_id, m_client_state.front_bitmap_id);
         // We don't need the backup bitmap anymore, so drop it.
         m_backup_bitmap = nullptr;
-        update();
+
+        if (!had_usable_bitmap) {
+            update();
+            return;
+        }
+
+        // The rest of the new front bitmap is the same as the old one, so only the painted parts need updating.
+        for (auto& rect : painted_content_rects)
+            update(rect.translated(-content_rect.location()).translated(frame_thickness(), frame_thickness()));
     }
 }
 
@@ -339,6 +348,12 @@ void OutOfProcessWebView::notify_server_did_js_console_output(const String& meth
         on_js_console_output(method, line);
 }
 
+void OutOfProcessWebView::notify_server_did_get_js_profile(const String& profile)
+{
+    if (on_get_js_profile)
+        on_get_js_profile(profile);
+}
+
 void OutOfProcessWebView::notify_server_did_change_favicon(const Gfx::Bitmap& favicon)
 {
     if (on_favicon_change)
@@ -35,7 +35,7 @@ public:
     void js_console_input(const String& js_source);
 
     void notify_server_did_layout(Badge<WebContentClient>, const Gfx::IntSize& content_size);
-    void notify_server_did_paint(Badge<WebContentClient>, i32 bitmap_id);
+    void notify_server_did_paint(Badge<WebContentClient>, const Gfx::IntRect& content_rect, i32 bitmap_id, const Vector<Gfx::IntRect>& painted_content_rects);
     void notify_server_did_invalidate_content_rect(Badge<WebContentClient>, const Gfx::IntRect&);
     void notify_server_did_change_selection(Badge<WebContentClient>);
     void notify_server_did_request_cursor_change(Badge<WebContentClient>, Gfx::StandardCursor cursor);
@@ -58,6 +58,7 @@ public:
     String notify_server_did_request_prompt(Badge<WebContentClient>, const String& message, const String& default_);
     void notify_server_did_get_source(const URL& url, const String& source);
     void notify_server_did_js_console_output(const String& method, const String& line);
+    void notify_server_did_get_js_profile(const String& profile);
     void notify_server_did_change_favicon(const Gfx::Bitmap& favicon);
     String notify_server_did_request_cookie(Badge<WebContentClient>, const URL& url, Cookie::Source source);
     void notify_server_did_set_cookie(Badge<WebContentClient>, const URL& url, const Cookie::ParsedCookie& cookie, Cookie::Source source);
@@ -91,10 +91,8 @@ void EditEventHandler::handle_insert(DOM::Position position, u32 code_point)
         node.invalidate_style();
     }
 
-    // FIXME: When nodes are removed from the DOM, the associated layout nodes become stale and still
-    //        remain in the layout tree. This has to be fixed, this just causes everything to be recomputed
-    //        which really hurts performance.
-    m_frame.document()->force_layout();
+    // Inserting text doesn't remove any nodes, so only the edited text has to be laid out again.
+    m_frame.document()->update_layout();
 
     m_frame.did_edit({});
 }
@@ -41,6 +41,10 @@ public:
     bool has_focus() const { return m_focus; }
     void set_has_focus(bool focus) { m_focus = focus; }
 
+    // When replaying a display list, each node is painted on its own, without its descendants.
+    bool should_paint_descendants() const { return m_should_paint_descendants; }
+    void set_should_paint_descendants(bool value) { m_should_paint_descendants = value; }
+
 private:
     Gfx::Painter& m_painter;
     Palette m_palette;
@@ -49,6 +53,7 @@ private:
     Gfx::IntPoint m_scroll_offset;
     bool m_should_show_line_box_borders { false };
     bool m_focus { false };
+    bool m_should_paint_descendants { true };
 };
 
 }
@@ -6,9 +6,12 @@
 
 #include <AK/QuickSort.h>
 #include <AK/StringBuilder.h>
+#include <LibGfx/Painter.h>
 #include <LibWeb/DOM/Node.h>
+#include <LibWeb/Layout/BlockBox.h>
 #include <LibWeb/Layout/Box.h>
 #include <LibWeb/Layout/InitialContainingBlockBox.h>
+#include <LibWeb/Layout/SVGBox.h>
 #include <LibWeb/Painting/StackingContext.h>
 
 namespace Web::Layout {
@@ -28,15 +31,85 @@ StackingContext::StackingContext(Box& box, StackingContext* parent)
     }
 }
 
+static Gfx::IntRect bounding_rect_of_painted_area(const Box& box)
+{
+    auto margin_box = box.box_model().margin_box();
+    auto rect = box.bordered_rect();
+    rect.set_x(rect.x() - margin_box.left);
+    rect.set_y(rect.y() - margin_box.top);
+    rect.set_width(rect.width() + margin_box.left + margin_box.right);
+    rect.set_height(rect.height() + margin_box.top + margin_box.bottom);
+
+    // Inline content can overflow the box, unless it's clipped to it.
+    if (is<BlockBox>(box) && box.children_are_inline() && !downcast<BlockBox>(box).should_clip_overflow()) {
+        for (auto& line_box : box.line_boxes()) {
+            for (auto& fragment : line_box.fragments())
+                rect = rect.united(fragment.absolute_rect());
+        }
+    }
+
+    // Leave some room for things like underlines that are painted just outside of the fragments.
+    return enclosing_int_rect(rect).inflated(4, 4);
+}
+
+void StackingContext::record_display_list_items(Node& node)
+{
+    if (!node.is_visible())
+        return;
+
+    if (is<Box>(node)) {
+        auto& box = downcast<Box>(node);
+        if (is<SVGBox>(box) || box.is_fixed_position()) {
+            m_display_list.append({ &box, true, {} });
+            return;
+        }
+        m_display_list.append({ &box, false, bounding_rect_of_painted_area(box) });
+    }
+
+    node.for_each_child_in_paint_order([&](auto& child) {
+        record_display_list_items(child);
+    });
+}
+
+void StackingContext::record_display_list()
+{
+    m_display_list.clear();
+    record_display_list_items(m_box);
+    m_has_display_list = true;
+}
+
+void StackingContext::invalidate_display_list()
+{
+    m_display_list.clear();
+    m_has_display_list = false;
+    for (auto* child : m_children)
+        child->invalidate_display_list();
+}
+
 void StackingContext::paint(PaintContext& context, PaintPhase phase)
 {
-    if (!is<InitialContainingBlockBox>(m_box)) {
-        m_box.paint(context, phase);
-    } else {
-        // NOTE: InitialContainingBlockBox::paint() merely calls StackingContext::paint()
-        //       so we call its base class instead.
-        downcast<InitialContainingBlockBox>(m_box).BlockBox::paint(context, phase);
+    if (!m_has_display_list)
+        record_display_list();
+
+    // The painter is already translated by the scroll offset, so the display list can be replayed as is.
+    auto& painter = context.painter();
+    auto visible_rect = painter.clip_rect().translated(-painter.translation());
+
+    bool should_paint_descendants = context.should_paint_descendants();
+    for (auto& item : m_display_list) {
+        if (!item.paints_descendants && !visible_rect.intersects(item.bounding_rect))
+            continue;
+        context.set_should_paint_descendants(item.paints_descendants);
+        if (is<InitialContainingBlockBox>(*item.box)) {
+            // NOTE: InitialContainingBlockBox::paint() merely calls StackingContext::paint()
+            //       so we call its base class instead.
+            downcast<InitialContainingBlockBox>(*item.box).BlockBox::paint(context, phase);
+        } else {
+            item.box->paint(context, phase);
+        }
     }
+    context.set_should_paint_descendants(should_paint_descendants);
+
     for (auto* child : m_children) {
         child->paint(context, phase);
     }
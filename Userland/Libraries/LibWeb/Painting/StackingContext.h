@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/Vector.h>
+#include <LibGfx/Rect.h>
 #include <LibWeb/Layout/Node.h>
 
 namespace Web::Layout {
@@ -21,12 +22,32 @@ public:
     void paint(PaintContext&, PaintPhase);
     HitTestResult hit_test(const Gfx::IntPoint&, HitTestType) const;
 
+    // Must be called whenever boxes in this stacking context (or its descendants) move or are added.
+    void invalidate_display_list();
+
     void dump(int indent = 0) const;
 
 private:
+    // The display list holds the boxes painted by this stacking context, in paint order.
+    // Replaying it doesn't need to walk the layout tree, and boxes outside of the area
+    // being painted can be skipped altogether.
+    struct DisplayListItem {
+        Box* box { nullptr };
+        // Some boxes set up state for their descendants while painting (e.g SVG), so they
+        // have to paint their whole subtree at once. These are never culled.
+        bool paints_descendants { false };
+        Gfx::IntRect bounding_rect;
+    };
+
+    void record_display_list();
+    void record_display_list_items(Node&);
+
     Box& m_box;
     StackingContext* const m_parent { nullptr };
     Vector<StackingContext*> m_children;
+
+    Vector<DisplayListItem> m_display_list;
+    bool m_has_display_list { false };
 };
 
 }
@@ -0,0 +1,90 @@
+loadPage("file:///res/html/misc/blank.html");
+
+afterInitialPageLoad(() => {
+    test("Collections stay live across appendChild and removeChild", () => {
+        const container = document.createElement("div");
+        document.body.appendChild(container);
+
+        const paragraphs = container.getElementsByTagName("p");
+        expect(paragraphs.length).toBe(0);
+        expect(paragraphs.item(0)).toBeNull();
+
+        const first = document.createElement("p");
+        container.appendChild(first);
+        expect(paragraphs.length).toBe(1);
+        expect(paragraphs.item(0)).toBe(first);
+
+        const second = document.createElement("p");
+        container.insertBefore(second, first);
+        expect(paragraphs.length).toBe(2);
+        expect(paragraphs[0]).toBe(second);
+        expect(paragraphs[1]).toBe(first);
+
+        // Elements deeper in the subtree are part of the collection too.
+        const wrapper = document.createElement("div");
+        const nested = document.createElement("p");
+        wrapper.appendChild(nested);
+        container.appendChild(wrapper);
+        expect(paragraphs.length).toBe(3);
+        expect(paragraphs[2]).toBe(nested);
+
+        container.removeChild(second);
+        expect(paragraphs.length).toBe(2);
+        expect(paragraphs[0]).toBe(first);
+        expect(paragraphs[1]).toBe(nested);
+
+        container.removeChild(wrapper);
+        expect(paragraphs.length).toBe(1);
+        expect(paragraphs[0]).toBe(first);
+
+        document.body.removeChild(container);
+    });
+
+    test("Collections stay live across setAttribute", () => {
+        const container = document.createElement("div");
+        document.body.appendChild(container);
+
+        const element = document.createElement("span");
+        container.appendChild(element);
+
+        const matches = container.getElementsByClassName("match");
+        expect(matches.length).toBe(0);
+
+        element.setAttribute("class", "match");
+        expect(matches.length).toBe(1);
+        expect(matches[0]).toBe(element);
+
+        element.setAttribute("class", "other");
+        expect(matches.length).toBe(0);
+
+        element.className = "other match";
+        expect(matches.length).toBe(1);
+
+        element.removeAttribute("class");
+        expect(matches.length).toBe(0);
+
+        const named = document.getElementsByName("field");
+        expect(named.length).toBe(0);
+
+        element.setAttribute("name", "field");
+        expect(named.length).toBe(1);
+        expect(named[0]).toBe(element);
+        expect(container.getElementsByTagName("span").namedItem("field")).toBe(element);
+
+        document.body.removeChild(container);
+        expect(named.length).toBe(0);
+    });
+
+    test("Document collections see changes anywhere in the document", () => {
+        const sections = document.getElementsByTagName("section");
+        const initialLength = sections.length;
+
+        const section = document.createElement("section");
+        document.body.appendChild(section);
+        expect(sections.length).toBe(initialLength + 1);
+        expect(sections[initialLength]).toBe(section);
+
+        document.body.removeChild(section);
+        expect(sections.length).toBe(initialLength);
+    });
+});
@@ -0,0 +1,89 @@
+loadPage("file:///res/html/misc/blank.html");
+
+afterInitialPageLoad(() => {
+    const createElementWithId = (tagName, id) => {
+        const element = document.createElement(tagName);
+        element.id = id;
+        return element;
+    };
+
+    test("Duplicate ids return the first element in tree order", () => {
+        const first = createElementWithId("div", "duplicate");
+        const second = createElementWithId("span", "duplicate");
+        document.body.appendChild(second);
+        expect(document.getElementById("duplicate")).toBe(second);
+
+        // Inserting an element before the current match makes it the new match.
+        document.body.insertBefore(first, second);
+        expect(document.getElementById("duplicate")).toBe(first);
+
+        document.body.removeChild(first);
+        expect(document.getElementById("duplicate")).toBe(second);
+
+        document.body.removeChild(second);
+        expect(document.getElementById("duplicate")).toBeNull();
+    });
+
+    test("Changing an id updates the lookup", () => {
+        const element = createElementWithId("div", "before");
+        document.body.appendChild(element);
+        expect(document.getElementById("before")).toBe(element);
+
+        element.id = "after";
+        expect(document.getElementById("before")).toBeNull();
+        expect(document.getElementById("after")).toBe(element);
+
+        element.setAttribute("id", "again");
+        expect(document.getElementById("after")).toBeNull();
+        expect(document.getElementById("again")).toBe(element);
+
+        element.removeAttribute("id");
+        expect(document.getElementById("again")).toBeNull();
+
+        document.body.removeChild(element);
+    });
+
+    test("Elements outside the document are not found", () => {
+        const element = createElementWithId("div", "detached");
+        expect(document.getElementById("detached")).toBeNull();
+
+        const container = document.createElement("div");
+        container.appendChild(element);
+        expect(document.getElementById("detached")).toBeNull();
+
+        document.body.appendChild(container);
+        expect(document.getElementById("detached")).toBe(element);
+
+        // Changing the id of an element that has been removed must not bring it back.
+        document.body.removeChild(container);
+        element.id = "still-detached";
+        expect(document.getElementById("detached")).toBeNull();
+        expect(document.getElementById("still-detached")).toBeNull();
+    });
+
+    test("Removing a subtree removes all of its ids", () => {
+        const outer = createElementWithId("div", "outer");
+        const middle = createElementWithId("div", "middle");
+        const inner = createElementWithId("span", "inner");
+        middle.appendChild(inner);
+        outer.appendChild(middle);
+        document.body.appendChild(outer);
+
+        expect(document.getElementById("outer")).toBe(outer);
+        expect(document.getElementById("middle")).toBe(middle);
+        expect(document.getElementById("inner")).toBe(inner);
+
+        outer.removeChild(middle);
+        expect(document.getElementById("outer")).toBe(outer);
+        expect(document.getElementById("middle")).toBeNull();
+        expect(document.getElementById("inner")).toBeNull();
+
+        outer.appendChild(middle);
+        expect(document.getElementById("inner")).toBe(inner);
+
+        document.body.removeChild(outer);
+        expect(document.getElementById("outer")).toBeNull();
+        expect(document.getElementById("middle")).toBeNull();
+        expect(document.getElementById("inner")).toBeNull();
+    });
+});
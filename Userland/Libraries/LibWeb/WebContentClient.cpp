@@ -31,7 +31,7 @@ void WebContentClient::handshake()
 
 void WebContentClient::handle(const Messages::WebContentClient::DidPaint& message)
 {
-    m_view.notify_server_did_paint({}, message.bitmap_id());
+    m_view.notify_server_did_paint({}, message.content_rect(), message.bitmap_id(), message.painted_content_rects());
 }
 
 void WebContentClient::handle([[maybe_unused]] const Messages::WebContentClient::DidFinishLoading& message)
@@ -151,6 +151,11 @@ void WebContentClient::handle(const Messages::WebContentClient::DidJSConsoleOutp
     m_view.notify_server_did_js_console_output(message.method(), message.line());
 }
 
+void WebContentClient::handle(const Messages::WebContentClient::DidGetJSProfile& message)
+{
+    m_view.notify_server_did_get_js_profile(message.profile());
+}
+
 OwnPtr<Messages::WebContentClient::DidRequestAlertResponse> WebContentClient::handle(const Messages::WebContentClient::DidRequestAlert& message)
 {
     m_view.notify_server_did_request_alert({}, message.message());
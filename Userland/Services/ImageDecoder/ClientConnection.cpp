@@ -35,9 +35,27 @@ OwnPtr<Messages::ImageDecoderServer::GreetResponse> ClientConnection::handle(con
     return make<Messages::ImageDecoderServer::GreetResponse>();
 }
 
-OwnPtr<Messages::ImageDecoderServer::DecodeImageResponse> ClientConnection::handle(const Messages::ImageDecoderServer::DecodeImage& message)
+struct DecodeResult {
+    Gfx::IntSize size;
+    bool is_animated { false };
+    u32 loop_count { 0 };
+    Vector<Gfx::ShareableBitmap> bitmaps;
+    Vector<u32> durations;
+};
+
+// Picks the largest factor the decoders support that still decodes the image at least as big as it's displayed.
+static int downscale_factor_for(const Gfx::IntSize& natural_size, const Gfx::IntSize& ideal_size)
+{
+    if (ideal_size.is_empty())
+        return 1;
+    int factor = 1;
+    while (factor < 8 && natural_size.width() / (factor * 2) >= ideal_size.width() && natural_size.height() / (factor * 2) >= ideal_size.height())
+        factor *= 2;
+    return factor;
+}
+
+static Optional<DecodeResult> decode_image(const Core::AnonymousBuffer& encoded_buffer, const Gfx::IntSize& ideal_size)
 {
-    auto encoded_buffer = message.data();
     if (!encoded_buffer.is_valid()) {
         dbgln_if(IMAGE_DECODER_DEBUG, "Encoded data is invalid");
         return {};
@@ -45,13 +63,20 @@ OwnPtr<Messages::ImageDecoderServer::DecodeImageResponse> ClientConnection::hand
 
     auto decoder = Gfx::ImageDecoder::create(encoded_buffer.data<u8>(), encoded_buffer.size());
 
+    DecodeResult result;
+    result.size = decoder->size();
+    if (auto factor = downscale_factor_for(result.size, ideal_size); factor > 1) {
+        bool did_downscale = decoder->set_downscale_factor(factor);
+        dbgln_if(IMAGE_DECODER_DEBUG, "Decoding {} image for {}, downscale factor {} {}", result.size, ideal_size, factor, did_downscale ? "accepted" : "rejected");
+    }
+
     if (!decoder->frame_count()) {
         dbgln_if(IMAGE_DECODER_DEBUG, "Could not decode image from encoded data");
-        return make<Messages::ImageDecoderServer::DecodeImageResponse>(false, 0, Vector<Gfx::ShareableBitmap> {}, Vector<u32> {});
+        return {};
     }
 
-    Vector<Gfx::ShareableBitmap> bitmaps;
-    Vector<u32> durations;
+    result.is_animated = decoder->is_animated();
+    result.loop_count = decoder->loop_count();
     for (size_t i = 0; i < decoder->frame_count(); ++i) {
         // FIXME: All image decoder plugins should be rewritten to return frame() instead of bitmap().
         //        Non-animated images can simply return 1 frame.
@@ -62,13 +87,37 @@ OwnPtr<Messages::ImageDecoderServer::DecodeImageResponse> ClientConnection::hand
             frame.image = decoder->bitmap();
         }
         if (frame.image)
-            bitmaps.append(frame.image->to_shareable_bitmap());
+            result.bitmaps.append(frame.image->to_shareable_bitmap());
         else
-            bitmaps.append(Gfx::ShareableBitmap {});
-        durations.append(frame.duration);
+            result.bitmaps.append(Gfx::ShareableBitmap {});
+        result.durations.append(frame.duration);
     }
+    return result;
+}
 
-    return make<Messages::ImageDecoderServer::DecodeImageResponse>(decoder->is_animated(), decoder->loop_count(), bitmaps, durations);
+OwnPtr<Messages::ImageDecoderServer::DecodeImageResponse> ClientConnection::handle(const Messages::ImageDecoderServer::DecodeImage& message)
+{
+    auto encoded_buffer = message.data();
+    if (!encoded_buffer.is_valid()) {
+        dbgln_if(IMAGE_DECODER_DEBUG, "Encoded data is invalid");
+        return {};
+    }
+
+    auto result = decode_image(encoded_buffer, {});
+    if (!result.has_value())
+        return make<Messages::ImageDecoderServer::DecodeImageResponse>(false, 0, Vector<Gfx::ShareableBitmap> {}, Vector<u32> {});
+
+    return make<Messages::ImageDecoderServer::DecodeImageResponse>(result->is_animated, result->loop_count, result->bitmaps, result->durations);
+}
+
+void ClientConnection::handle(const Messages::ImageDecoderServer::StartDecodingImage& message)
+{
+    auto result = decode_image(message.data(), message.ideal_size());
+    if (!result.has_value()) {
+        post_message(Messages::ImageDecoderClient::DidDecodeImage(message.image_id(), false, {}, false, 0, {}, {}));
+        return;
+    }
+    post_message(Messages::ImageDecoderClient::DidDecodeImage(message.image_id(), true, result->size, result->is_animated, result->loop_count, move(result->bitmaps), move(result->durations)));
 }
 
 }
@@ -12,6 +12,7 @@
 #include <LibJS/Heap/Heap.h>
 #include <LibJS/Interpreter.h>
 #include <LibJS/Parser.h>
+#include <LibJS/Profiler.h>
 #include <LibJS/Runtime/VM.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
 #include <LibWeb/Cookie/ParsedCookie.h>
@@ -68,6 +69,7 @@ void ClientConnection::handle(const Messages::WebContentServer::UpdateSystemThem
     Gfx::set_system_theme(message.theme_buffer());
     auto impl = Gfx::PaletteImpl::create_with_anonymous_buffer(message.theme_buffer());
     m_page_host->set_palette_impl(*impl);
+    invalidate_all_backing_stores();
 }
 
 void ClientConnection::handle(const Messages::WebContentServer::UpdateScreenRect& message)
@@ -104,7 +106,7 @@ void ClientConnection::handle(const Messages::WebContentServer::SetViewportRect&
 
 void ClientConnection::handle(const Messages::WebContentServer::AddBackingStore& message)
 {
-    m_backing_stores.set(message.backing_store_id(), *message.bitmap().bitmap());
+    m_backing_stores.set(message.backing_store_id(), BackingStore { *message.bitmap().bitmap(), {}, {} });
 }
 
 void ClientConnection::handle(const Messages::WebContentServer::RemoveBackingStore& message)
@@ -127,16 +129,59 @@ void ClientConnection::handle(const Messages::WebContentServer::Paint& message)
         return;
     }
 
-    auto& bitmap = *it->value;
+    auto& bitmap = *it->value.bitmap;
     m_pending_paint_requests.append({ message.content_rect(), bitmap, message.backing_store_id() });
     m_paint_flush_timer->start();
 }
 
+void ClientConnection::did_invalidate_content_rect(const Gfx::IntRect& content_rect)
+{
+    for (auto& it : m_backing_stores) {
+        auto& damage = it.value.damaged_content_rects;
+        damage.add(content_rect);
+
+        // Lots of small rects cost more to paint one by one than their bounding rect does.
+        if (damage.size() > 16) {
+            Gfx::IntRect bounding_rect;
+            for (auto& rect : damage.rects())
+                bounding_rect = bounding_rect.is_empty() ? rect : bounding_rect.united(rect);
+            damage = Gfx::DisjointRectSet(bounding_rect);
+        }
+    }
+}
+
+void ClientConnection::invalidate_all_backing_stores()
+{
+    for (auto& it : m_backing_stores) {
+        it.value.painted_content_rect = {};
+        it.value.damaged_content_rects.clear();
+    }
+}
+
 void ClientConnection::flush_pending_paint_requests()
 {
     for (auto& pending_paint : m_pending_paint_requests) {
-        m_page_host->paint(pending_paint.content_rect, *pending_paint.bitmap);
-        post_message(Messages::WebContentClient::DidPaint(pending_paint.content_rect, pending_paint.bitmap_id));
+        auto it = m_backing_stores.find(pending_paint.bitmap_id);
+        if (it == m_backing_stores.end())
+            continue;
+        auto& backing_store = it->value;
+
+        // Only what changed since this bitmap was last painted needs to be painted again,
+        // unless we're now painting a different part of the page (e.g after scrolling).
+        Gfx::DisjointRectSet rects_to_paint;
+        if (backing_store.painted_content_rect == pending_paint.content_rect)
+            rects_to_paint = backing_store.damaged_content_rects.intersected(pending_paint.content_rect);
+        else
+            rects_to_paint.add(pending_paint.content_rect);
+        backing_store.painted_content_rect = pending_paint.content_rect;
+        backing_store.damaged_content_rects.clear();
+
+        if (!rects_to_paint.is_empty())
+            m_page_host->paint(pending_paint.content_rect, *pending_paint.bitmap, rects_to_paint);
+
+        Vector<Gfx::IntRect> painted_content_rects;
+        painted_content_rects.append(rects_to_paint.rects().data(), rects_to_paint.size());
+        post_message(Messages::WebContentClient::DidPaint(pending_paint.content_rect, pending_paint.bitmap_id, painted_content_rects));
     }
     m_pending_paint_requests.clear();
 }
@@ -198,6 +243,20 @@ void ClientConnection::handle(const Messages::WebContentServer::DebugRequest& me
         page().main_frame().set_needs_display(page().main_frame().viewport_rect());
     }
 
+    if (message.request() == "js-profiling") {
+        auto& vm = Web::Bindings::main_thread_vm();
+        if (message.argument() == "on") {
+            vm.set_profiler(make<JS::Profiler>(vm));
+            vm.profiler()->start();
+        } else if (auto* profiler = vm.profiler()) {
+            profiler->stop();
+            dbgln("JavaScript function statistics:\n{}", profiler->to_statistics_table());
+            // We can't write files from here, so the client gets to save the profile.
+            post_message(Messages::WebContentClient::DidGetJSProfile(profiler->to_perfcore_json()));
+            vm.set_profiler({});
+        }
+    }
+
     if (message.request() == "clear-cache") {
         Web::ResourceLoader::the().clear_cache();
     }
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/HashMap.h>
+#include <LibGfx/DisjointRectSet.h>
 #include <LibIPC/ClientConnection.h>
 #include <LibJS/Forward.h>
 #include <LibWeb/Cookie/ParsedCookie.h>
@@ -29,6 +30,9 @@ public:
 
     virtual void die() override;
 
+    void did_invalidate_content_rect(const Gfx::IntRect&);
+    void invalidate_all_backing_stores();
+
 private:
     Web::Page& page();
     const Web::Page& page() const;
@@ -63,7 +67,14 @@ private:
     Vector<PaintRequest> m_pending_paint_requests;
     RefPtr<Core::Timer> m_paint_flush_timer;
 
-    HashMap<i32, NonnullRefPtr<Gfx::Bitmap>> m_backing_stores;
+    struct BackingStore {
+        NonnullRefPtr<Gfx::Bitmap> bitmap;
+        // The content rect that was last painted into the bitmap, and what has changed since then.
+        // Both bitmaps need to catch up on all damage, so each one keeps track of its own.
+        Gfx::IntRect painted_content_rect;
+        Gfx::DisjointRectSet damaged_content_rects;
+    };
+    HashMap<i32, BackingStore> m_backing_stores;
 
     WeakPtr<JS::Interpreter> m_interpreter;
     OwnPtr<WebContentConsoleClient> m_console_client;
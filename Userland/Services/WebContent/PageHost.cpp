@@ -54,7 +54,7 @@ Web::Layout::InitialContainingBlockBox* PageHost::layout_root()
     return document->layout_node();
 }
 
-void PageHost::paint(const Gfx::IntRect& content_rect, Gfx::Bitmap& target)
+void PageHost::paint(const Gfx::IntRect& content_rect, Gfx::Bitmap& target, const Gfx::DisjointRectSet& content_rects_to_paint)
 {
     Gfx::Painter painter(target);
     Gfx::IntRect bitmap_rect { {}, content_rect.size() };
@@ -68,7 +68,13 @@ void PageHost::paint(const Gfx::IntRect& content_rect, Gfx::Bitmap& target)
     Web::PaintContext context(painter, palette(), content_rect.top_left());
     context.set_should_show_line_box_borders(m_should_show_line_box_borders);
     context.set_viewport_rect(content_rect);
-    layout_root->paint_all_phases(context);
+
+    // Everything outside of the rects to paint is left as it is in the target bitmap.
+    for (auto& rect : content_rects_to_paint.rects()) {
+        Gfx::PainterStateSaver saver(painter);
+        painter.add_clip_rect(rect.translated(-content_rect.location()));
+        layout_root->paint_all_phases(context);
+    }
 }
 
 void PageHost::set_viewport_rect(const Gfx::IntRect& rect)
@@ -78,11 +84,14 @@ void PageHost::set_viewport_rect(const Gfx::IntRect& rect)
 
 void PageHost::page_did_invalidate(const Gfx::IntRect& content_rect)
 {
+    m_client.did_invalidate_content_rect(content_rect);
     m_client.post_message(Messages::WebContentClient::DidInvalidateContentRect(content_rect));
 }
 
 void PageHost::page_did_change_selection()
 {
+    // FIXME: Only invalidate the parts of the page where the selection changed.
+    m_client.invalidate_all_backing_stores();
     m_client.post_message(Messages::WebContentClient::DidChangeSelection());
 }
 
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <LibGfx/DisjointRectSet.h>
 #include <LibGfx/Rect.h>
 #include <LibWeb/Page/Page.h>
 
@@ -24,7 +25,7 @@ public:
     Web::Page& page() { return *m_page; }
     const Web::Page& page() const { return *m_page; }
 
-    void paint(const Gfx::IntRect& content_rect, Gfx::Bitmap&);
+    void paint(const Gfx::IntRect& content_rect, Gfx::Bitmap&, const Gfx::DisjointRectSet& content_rects_to_paint);
 
     void set_palette_impl(const Gfx::PaletteImpl&);
     void set_viewport_rect(const Gfx::IntRect&);
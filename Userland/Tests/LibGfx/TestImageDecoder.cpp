@@ -6,6 +6,7 @@
  */
 
 #include <AK/String.h>
+#include <LibCore/File.h>
 #include <LibGfx/BMPLoader.h>
 #include <LibGfx/GIFLoader.h>
 #include <LibGfx/ICOLoader.h>
@@ -79,6 +80,25 @@ TEST_CASE(test_jpg)
     EXPECT(frame.duration == 0);
 }
 
+TEST_CASE(test_jpg_downscaled)
+{
+    auto file = Core::File::open("/res/html/misc/jpgsuite_files/oh-lena.jpg", Core::IODevice::ReadOnly);
+    EXPECT(!file.is_error());
+    if (file.is_error())
+        return;
+
+    auto data = file.value()->read_all();
+    auto decoder = Gfx::ImageDecoder::create(data);
+    EXPECT(decoder->set_downscale_factor(4));
+    auto bitmap = decoder->bitmap();
+    EXPECT(bitmap);
+    if (!bitmap)
+        return;
+
+    EXPECT(decoder->size() == Gfx::IntSize(1200, 822));
+    EXPECT(bitmap->size() == Gfx::IntSize(300, 206));
+}
+
 TEST_CASE(test_pbm)
 {
     auto image = Gfx::load_pbm("/res/html/misc/pbmsuite_files/buggie-raw.pbm");
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/StringBuilder.h>
+#include <LibCore/File.h>
+#include <LibWeb/HTML/Parser/HTMLTokenizer.h>
+
+static constexpr size_t target_input_size = 4 * MiB;
+
+static size_t tokenize(const StringView& input)
+{
+    Web::HTML::HTMLTokenizer tokenizer(input, "utf-8");
+    size_t token_count = 0;
+    for (;;) {
+        auto token = tokenizer.next_token();
+        if (!token.has_value() || token->is_end_of_file())
+            break;
+        ++token_count;
+    }
+    return token_count;
+}
+
+static String repeat_until_large_enough(const StringView& chunk)
+{
+    VERIFY(!chunk.is_empty());
+    StringBuilder builder;
+    while (builder.length() < target_input_size)
+        builder.append(chunk);
+    return builder.to_string();
+}
+
+static String load_real_world_pages()
+{
+    StringBuilder builder;
+    for (auto* path : { "/res/html/misc/acid2.html", "/res/html/misc/bmpsuite.html", "/res/html/misc/cursor.html", "/res/html/misc/welcome.html" }) {
+        auto file = Core::File::open(path, Core::IODevice::ReadOnly);
+        if (file.is_error()) {
+            warnln("Failed to open {}: {}", path, file.error());
+            continue;
+        }
+        builder.append(StringView { file.value()->read_all() });
+    }
+    return builder.to_string();
+}
+
+BENCHMARK_CASE(real_world_pages)
+{
+    auto pages = load_real_world_pages();
+    if (pages.is_empty()) {
+        FAIL("None of the pages to tokenize could be loaded");
+        return;
+    }
+    auto input = repeat_until_large_enough(pages);
+    EXPECT(tokenize(input) > 0);
+}
+
+BENCHMARK_CASE(long_text_runs)
+{
+    auto input = repeat_until_large_enough(
+        "<p>Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua. "
+        "Ut enim ad minim veniam, quis nostrud exercitation ullamco laboris nisi ut aliquip ex ea commodo consequat &amp; "
+        "duis aute irure dolor in reprehenderit in voluptate velit esse cillum dolore eu fugiat nulla pariatur.</p>\n");
+    EXPECT(tokenize(input) > 0);
+}
+
+BENCHMARK_CASE(attribute_heavy_markup)
+{
+    auto input = repeat_until_large_enough(
+        "<a href=\"https://www.example.com/articles/2021/04/some-fairly-long-article-title?utm_source=feed&amp;utm_medium=rss\" "
+        "class='link link-primary link-with-icon' data-tracking-id=\"nav-item-12345\" title=\"Read the full article\">Read</a>\n");
+    EXPECT(tokenize(input) > 0);
+}
+
+BENCHMARK_CASE(comments)
+{
+    auto input = repeat_until_large_enough(
+        "<!-- This comment was left behind by a content management system and nobody ever removed it. -->\n"
+        "<!--[if lt IE 9]><script src=\"html5shiv.js\"></script><![endif]-->\n");
+    EXPECT(tokenize(input) > 0);
+}
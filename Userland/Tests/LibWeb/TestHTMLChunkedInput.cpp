@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/StringBuilder.h>
+#include <AK/URL.h>
+#include <AK/Utf8View.h>
+#include <LibCore/EventLoop.h>
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/Dump.h>
+#include <LibWeb/HTML/Parser/HTMLDocumentParser.h>
+#include <LibWeb/HTML/Parser/HTMLTokenizer.h>
+
+// Covers states that keep information across tokens or look ahead: tags with attributes in all three
+// quoting styles, character references (also inside attributes), comments, a doctype, raw text and
+// script data (also double escaped), foreign content, and characters that take more than one byte in UTF-8.
+static constexpr const char* test_document = "<!DOCTYPE html>\n"
+                                             "<html lang=en><head><title>Caf&eacute; &amp; co&#x2014;&#8364;</title>\n"
+                                             "<style>p > a { color: red } /* </p> */</style>\n"
+                                             "<script>if (a < b && c </s) { x = '<!--'; }</script></head>\n"
+                                             "<script><!--<SCRIPT>document.write('</script>')</script>--></script>\n"
+                                             "<body class='main page' data-x=\"1 &lt; 2\" hidden id=b>\n"
+                                             "<!-- a comment -- with dashes --><p>Caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80 &notin &notit; &#0; &#x110000;</p>\n"
+                                             "<textarea>\n<b>not bold</b></textarea><br/><img src=a.png alt=\"\">\n"
+                                             "<svg><circle r=1 /></svg>\n"
+                                             "<table><tr><td>cell</table>text after</body></html>\n";
+
+// Tokens for the same text may be split differently depending on where the input was cut, so runs of
+// character tokens are merged before comparing.
+static String tokenize(const Vector<StringView>& chunks)
+{
+    Web::HTML::HTMLTokenizer tokenizer;
+    StringBuilder tokens;
+    StringBuilder text;
+
+    auto flush_text = [&] {
+        if (text.is_empty())
+            return;
+        tokens.appendff("Text {{ '{}' }}\n", text.string_view());
+        text.clear();
+    };
+
+    auto drain = [&] {
+        for (;;) {
+            auto token = tokenizer.next_token();
+            if (!token.has_value())
+                return;
+            if (token->is_character()) {
+                // to_string() gives us "Character { data: '...' }".
+                auto string = token->to_string();
+                text.append(string.substring_view(19, string.length() - 19 - 3));
+                continue;
+            }
+            flush_text();
+            tokens.append(token->to_string());
+            if (token->is_start_tag() && token->is_self_closing())
+                tokens.append(" (self-closing)");
+            tokens.append('\n');
+            if (token->is_end_of_file())
+                return;
+        }
+    };
+
+    for (auto& chunk : chunks) {
+        tokenizer.append_to_input(chunk);
+        drain();
+    }
+    tokenizer.insert_eof();
+    drain();
+    flush_text();
+    return tokens.to_string();
+}
+
+// The tokenizer only ever gets decoded input, so it's split between code points rather than bytes.
+static Vector<size_t> code_point_offsets(const StringView& input)
+{
+    Vector<size_t> offsets;
+    Utf8View view(input);
+    for (auto it = view.begin(); it != view.end(); ++it)
+        offsets.append(view.byte_offset_of(it));
+    offsets.append(input.length());
+    return offsets;
+}
+
+TEST_CASE(tokenizer_input_split_in_two)
+{
+    StringView input { test_document };
+    auto expected = tokenize({ input });
+    EXPECT(expected.contains("EndOfFile"));
+
+    for (auto offset : code_point_offsets(input)) {
+        auto tokens = tokenize({ input.substring_view(0, offset), input.substring_view(offset) });
+        if (tokens != expected) {
+            warnln("Tokens differ when splitting the input at offset {}", offset);
+            EXPECT_EQ(tokens, expected);
+            return;
+        }
+    }
+}
+
+TEST_CASE(tokenizer_input_one_code_point_at_a_time)
+{
+    StringView input { test_document };
+    auto offsets = code_point_offsets(input);
+    Vector<StringView> chunks;
+    for (size_t i = 0; i + 1 < offsets.size(); ++i)
+        chunks.append(input.substring_view(offsets[i], offsets[i + 1] - offsets[i]));
+    EXPECT_EQ(tokenize(chunks), tokenize({ input }));
+}
+
+static String parse(const Vector<ReadonlyBytes>& chunks)
+{
+    URL url("about:blank");
+    auto document = Web::DOM::Document::create(url);
+    Web::HTML::HTMLDocumentParser parser(document, "utf-8");
+    for (auto& chunk : chunks) {
+        parser.append_to_input(chunk);
+        parser.run(url);
+    }
+    parser.insert_eof();
+    parser.run(url);
+    EXPECT(parser.has_finished());
+
+    StringBuilder builder;
+    Web::dump_tree(builder, *document);
+    return builder.to_string();
+}
+
+TEST_CASE(parser_input_split_at_every_byte)
+{
+    // Parsing may need an event loop to queue tasks on once the document has finished.
+    Core::EventLoop event_loop;
+
+    StringView input { test_document };
+    auto expected_document = Web::HTML::parse_html_document(input, URL("about:blank"), "utf-8");
+    StringBuilder expected_builder;
+    Web::dump_tree(expected_builder, *expected_document);
+    auto expected = expected_builder.to_string();
+    EXPECT(expected.contains("cell"));
+
+    auto bytes = input.bytes();
+    for (size_t offset = 0; offset <= bytes.size(); ++offset) {
+        auto tree = parse({ bytes.slice(0, offset), bytes.slice(offset) });
+        if (tree != expected) {
+            warnln("Trees differ when splitting the input at byte {}", offset);
+            EXPECT_EQ(tree, expected);
+            return;
+        }
+    }
+
+    Vector<ReadonlyBytes> single_bytes;
+    for (size_t offset = 0; offset < bytes.size(); ++offset)
+        single_bytes.append(bytes.slice(offset, 1));
+    EXPECT_EQ(parse(single_bytes), expected);
+}
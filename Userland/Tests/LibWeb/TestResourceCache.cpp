@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <LibCore/DateTime.h>
+#include <LibWeb/Loader/Resource.h>
+#include <LibWeb/Loader/ResourceCache.h>
+
+using Web::ResourceCache;
+using Headers = ResourceCache::Headers;
+
+// Resources normally only come from ResourceLoader. These never load anything, the tests give the cache
+// the response directly.
+class TestResource final : public Web::Resource {
+public:
+    static NonnullRefPtr<TestResource> create(const Web::LoadRequest& request) { return adopt_ref(*new TestResource(request)); }
+
+private:
+    explicit TestResource(const Web::LoadRequest& request)
+        : Resource(Type::Generic, request)
+    {
+    }
+};
+
+static Web::LoadRequest make_request(const StringView& path)
+{
+    Web::LoadRequest request;
+    request.set_url(URL(String::formatted("http://www.example.com/{}", path)));
+    return request;
+}
+
+// Dates are parsed as local time, so this has to be as well.
+static time_t april_20th_2021_at(unsigned hour, unsigned minute, unsigned second)
+{
+    return Core::DateTime::create(2021, 4, 20, hour, minute, second).timestamp();
+}
+
+static constexpr time_t one_day = 24 * 60 * 60;
+static time_t const now = april_20th_2021_at(12, 0, 0);
+static constexpr auto date = "Tue, 20 Apr 2021 12:00:00 GMT";
+
+TEST_CASE(max_age)
+{
+    EXPECT_EQ(ResourceCache::freshness_lifetime(Headers({ { "Cache-Control", "max-age=60" } }), 200, now), 60);
+    EXPECT_EQ(ResourceCache::freshness_lifetime(Headers({ { "cache-control", "public, MAX-AGE=120" } }), 200, now), 120);
+
+    // A malformed max-age makes the response stale.
+    EXPECT_EQ(ResourceCache::freshness_lifetime(Headers({ { "Cache-Control", "max-age=soon" } }), 200, now), 0);
+    EXPECT_EQ(ResourceCache::freshness_lifetime(Headers({ { "Cache-Control", "max-age=-5" } }), 200, now), 0);
+
+    // max-age wins over Expires.
+    auto headers = Headers({ { "Cache-Control", "max-age=60" }, { "Date", date }, { "Expires", "Tue, 20 Apr 2021 13:00:00 GMT" } });
+    EXPECT_EQ(ResourceCache::freshness_lifetime(headers, 200, now), 60);
+}
+
+TEST_CASE(expires)
+{
+    auto headers = Headers({ { "Date", date }, { "Expires", "Tue, 20 Apr 2021 13:00:00 GMT" } });
+    EXPECT_EQ(ResourceCache::freshness_lifetime(headers, 200, now), 60 * 60);
+
+    // The lifetime is relative to Date, not to when the response was received.
+    EXPECT_EQ(ResourceCache::freshness_lifetime(headers, 200, now + 30), 60 * 60);
+
+    headers = Headers({ { "Date", date }, { "Expires", "Tue, 20 Apr 2021 11:00:00 GMT" } });
+    EXPECT_EQ(ResourceCache::freshness_lifetime(headers, 200, now), 0);
+
+    // An invalid Expires date means the response is already stale.
+    headers = Headers({ { "Date", date }, { "Expires", "0" } });
+    EXPECT_EQ(ResourceCache::freshness_lifetime(headers, 200, now), 0);
+}
+
+TEST_CASE(expires_without_date)
+{
+    // Without a Date header, the time the response was received stands in for it.
+    auto headers = Headers({ { "Expires", "Tue, 20 Apr 2021 12:10:00 GMT" } });
+    EXPECT_EQ(ResourceCache::freshness_lifetime(headers, 200, now), 10 * 60);
+    EXPECT_EQ(ResourceCache::freshness_lifetime(headers, 200, april_20th_2021_at(12, 5, 0)), 5 * 60);
+    EXPECT_EQ(ResourceCache::freshness_lifetime(headers, 200, april_20th_2021_at(12, 15, 0)), 0);
+}
+
+TEST_CASE(last_modified_heuristic)
+{
+    // 10% of the time since the response was last modified...
+    auto headers = Headers({ { "Date", date }, { "Last-Modified", "Tue, 20 Apr 2021 10:00:00 GMT" } });
+    EXPECT_EQ(ResourceCache::freshness_lifetime(headers, 200, now), 12 * 60);
+
+    // ...but no more than a day.
+    headers = Headers({ { "Date", date }, { "Last-Modified", "Mon, 01 Jan 2018 00:00:00 GMT" } });
+    EXPECT_EQ(ResourceCache::freshness_lifetime(headers, 200, now), one_day);
+
+    // A Last-Modified in the future doesn't make the response fresh.
+    headers = Headers({ { "Date", date }, { "Last-Modified", "Tue, 20 Apr 2021 13:00:00 GMT" } });
+    EXPECT_EQ(ResourceCache::freshness_lifetime(headers, 200, now), 0);
+
+    // Without Date, the time since Last-Modified is measured from when the response was received.
+    headers = Headers({ { "Last-Modified", "Tue, 20 Apr 2021 11:00:00 GMT" } });
+    EXPECT_EQ(ResourceCache::freshness_lifetime(headers, 200, now), 6 * 60);
+
+    // Explicit freshness wins over the heuristic.
+    headers = Headers({ { "Date", date }, { "Last-Modified", "Mon, 01 Jan 2018 00:00:00 GMT" }, { "Expires", "Tue, 20 Apr 2021 12:01:00 GMT" } });
+    EXPECT_EQ(ResourceCache::freshness_lifetime(headers, 200, now), 60);
+
+    // Without any information, responses are stale straight away.
+    EXPECT_EQ(ResourceCache::freshness_lifetime({}, 200, now), 0);
+}
+
+TEST_CASE(age)
+{
+    EXPECT_EQ(ResourceCache::freshness_lifetime(Headers({ { "Cache-Control", "max-age=100" }, { "Age", "30" } }), 200, now), 70);
+    EXPECT_EQ(ResourceCache::freshness_lifetime(Headers({ { "Cache-Control", "max-age=100" }, { "Age", "300" } }), 200, now), 0);
+    EXPECT_EQ(ResourceCache::freshness_lifetime(Headers({ { "Cache-Control", "max-age=100" }, { "Age", "old" } }), 200, now), 100);
+
+    auto headers = Headers({ { "Date", date }, { "Expires", "Tue, 20 Apr 2021 13:00:00 GMT" }, { "Age", "600" } });
+    EXPECT_EQ(ResourceCache::freshness_lifetime(headers, 200, now), 50 * 60);
+}
+
+TEST_CASE(no_store_no_cache_and_pragma)
+{
+    EXPECT(!ResourceCache::is_storable(Headers({ { "Cache-Control", "no-store" } }), 200));
+    EXPECT(!ResourceCache::is_storable(Headers({ { "Cache-Control", "max-age=60, No-Store" } }), 200));
+
+    // no-cache responses may be stored, but have to be revalidated before every use.
+    auto headers = Headers({ { "Cache-Control", "no-cache, max-age=60" } });
+    EXPECT(ResourceCache::is_storable(headers, 200));
+    EXPECT_EQ(ResourceCache::freshness_lifetime(headers, 200, now), 0);
+
+    headers = Headers({ { "Pragma", "no-cache" }, { "Date", date }, { "Expires", "Tue, 20 Apr 2021 13:00:00 GMT" } });
+    EXPECT(ResourceCache::is_storable(headers, 200));
+    EXPECT_EQ(ResourceCache::freshness_lifetime(headers, 200, now), 0);
+
+    // Pragma is only looked at if there is no Cache-Control.
+    headers = Headers({ { "Pragma", "no-cache" }, { "Cache-Control", "max-age=60" } });
+    EXPECT_EQ(ResourceCache::freshness_lifetime(headers, 200, now), 60);
+}
+
+TEST_CASE(cacheable_status_codes)
+{
+    for (u32 status_code : { 200, 203, 204, 300, 301, 404, 405, 410, 414, 501 })
+        EXPECT(ResourceCache::is_storable({}, status_code));
+    for (u32 status_code : { 201, 206, 302, 304, 307, 400, 403, 500, 503 })
+        EXPECT(!ResourceCache::is_storable({}, status_code));
+
+    // Resources that didn't come from HTTP (like data: URLs) never change.
+    EXPECT(ResourceCache::is_storable({}, {}));
+    EXPECT_EQ(ResourceCache::freshness_lifetime({}, {}, now), NumericLimits<time_t>::max());
+}
+
+TEST_CASE(storing_responses)
+{
+    auto& cache = ResourceCache::the();
+    cache.clear();
+
+    auto request = make_request("page.html");
+    auto resource = TestResource::create(request);
+    cache.set(request, resource);
+    cache.did_receive_response(request, resource, Headers({ { "Cache-Control", "max-age=60" } }), 200, 100, now);
+
+    auto* entry = cache.get(request);
+    EXPECT(entry);
+    EXPECT_EQ(entry->resource.ptr(), resource.ptr());
+    EXPECT_EQ(entry->freshness_lifetime, 60);
+    EXPECT_EQ(cache.size_in_bytes(), 100u);
+    EXPECT(cache.is_fresh(*entry, now));
+    EXPECT(cache.is_fresh(*entry, now + 59));
+    EXPECT(!cache.is_fresh(*entry, now + 60));
+
+    // A response that may not be stored takes its entry with it.
+    auto uncacheable_request = make_request("uncacheable.html");
+    auto uncacheable_resource = TestResource::create(uncacheable_request);
+    cache.set(uncacheable_request, uncacheable_resource);
+    cache.did_receive_response(uncacheable_request, uncacheable_resource, Headers({ { "Cache-Control", "no-store" } }), 200, 100, now);
+    EXPECT(!cache.get(uncacheable_request));
+    EXPECT_EQ(cache.entry_count(), 1u);
+    EXPECT_EQ(cache.size_in_bytes(), 100u);
+
+    // Responses for resources that have been replaced in the meantime are ignored.
+    auto replaced_resource = TestResource::create(request);
+    cache.did_receive_response(request, replaced_resource, Headers({ { "Cache-Control", "max-age=0" } }), 200, 500, now);
+    EXPECT_EQ(cache.get(request)->freshness_lifetime, 60);
+    EXPECT_EQ(cache.size_in_bytes(), 100u);
+
+    cache.clear();
+}
+
+TEST_CASE(revalidation)
+{
+    auto stored_headers = Headers({ { "Content-Type", "text/html" }, { "ETag", "\"v1\"" }, { "Last-Modified", "Mon, 19 Apr 2021 12:00:00 GMT" }, { "Cache-Control", "max-age=0" } });
+    EXPECT(ResourceCache::has_validators(stored_headers));
+    EXPECT(!ResourceCache::has_validators(Headers({ { "Content-Type", "text/html" } })));
+
+    auto request = make_request("page.html");
+    ResourceCache::add_validators_to_request(request, stored_headers);
+    EXPECT_EQ(request.header("If-None-Match"), "\"v1\"");
+    EXPECT_EQ(request.header("If-Modified-Since"), "Mon, 19 Apr 2021 12:00:00 GMT");
+
+    // A 304 updates the headers it has, and keeps the rest (including the body) of the stored response.
+    auto not_modified_headers = Headers({ { "Cache-Control", "max-age=300" }, { "Date", date } });
+    auto headers = ResourceCache::headers_after_revalidation(stored_headers, not_modified_headers);
+    EXPECT_EQ(headers.get("Content-Type").value(), "text/html");
+    EXPECT_EQ(headers.get("ETag").value(), "\"v1\"");
+    EXPECT_EQ(headers.get("Cache-Control").value(), "max-age=300");
+    EXPECT_EQ(headers.get("Date").value(), date);
+
+    // The revalidated response is fresh again, for as long as the 304 says.
+    auto& cache = ResourceCache::the();
+    cache.clear();
+    auto resource = TestResource::create(make_request("page.html"));
+    cache.set(make_request("page.html"), resource);
+    cache.did_receive_response(make_request("page.html"), resource, stored_headers, 200, 10, now);
+    EXPECT(!cache.is_fresh(*cache.get(make_request("page.html")), now));
+
+    auto revalidated_resource = TestResource::create(make_request("page.html"));
+    cache.set(make_request("page.html"), revalidated_resource);
+    cache.did_receive_response(make_request("page.html"), revalidated_resource, headers, 200, 10, now + 10);
+    auto* entry = cache.get(make_request("page.html"));
+    EXPECT_EQ(entry->resource.ptr(), revalidated_resource.ptr());
+    EXPECT(cache.is_fresh(*entry, now + 10 + 299));
+    EXPECT(!cache.is_fresh(*entry, now + 10 + 300));
+    EXPECT_EQ(cache.size_in_bytes(), 10u);
+
+    cache.clear();
+}
+
+TEST_CASE(least_recently_used_eviction)
+{
+    auto& cache = ResourceCache::the();
+    cache.clear();
+    cache.set_size_limit_in_bytes(100);
+
+    auto store = [&](const StringView& path) {
+        auto request = make_request(path);
+        auto resource = TestResource::create(request);
+        cache.set(request, resource);
+        cache.did_receive_response(request, resource, Headers({ { "Cache-Control", "max-age=60" } }), 200, 40, now);
+    };
+
+    store("a");
+    store("b");
+    EXPECT_EQ(cache.entry_count(), 2u);
+    EXPECT_EQ(cache.size_in_bytes(), 80u);
+
+    // Using "a" makes "b" the least recently used one.
+    EXPECT(cache.get(make_request("a")));
+    store("c");
+    EXPECT_EQ(cache.entry_count(), 2u);
+    EXPECT_EQ(cache.size_in_bytes(), 80u);
+    EXPECT(cache.get(make_request("a")));
+    EXPECT(!cache.get(make_request("b")));
+    EXPECT(cache.get(make_request("c")));
+
+    // Resources that are still loading don't count, and aren't evicted.
+    auto loading_request = make_request("loading");
+    cache.set(loading_request, TestResource::create(loading_request));
+    cache.set_size_limit_in_bytes(40);
+    EXPECT_EQ(cache.size_in_bytes(), 40u);
+    EXPECT(cache.get(loading_request));
+    EXPECT(cache.get(make_request("c")));
+    EXPECT(!cache.get(make_request("a")));
+
+    cache.set_size_limit_in_bytes(32 * MiB);
+    cache.clear();
+}
@@ -16,6 +16,7 @@
 #include <LibJS/Console.h>
 #include <LibJS/Interpreter.h>
 #include <LibJS/Parser.h>
+#include <LibJS/Profiler.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/ArrayBuffer.h>
 #include <LibJS/Runtime/BooleanObject.h>
@@ -466,6 +467,23 @@ static bool write_to_file(const String& path)
     return true;
 }
 
+static void write_profile(const char* profile_path)
+{
+    auto& profiler = *vm->profiler();
+    profiler.stop();
+
+    auto file_or_error = Core::File::open(profile_path, Core::IODevice::WriteOnly);
+    if (file_or_error.is_error()) {
+        warnln("Failed to open {}: {}", profile_path, file_or_error.error());
+    } else if (!file_or_error.value()->write(profiler.to_perfcore_json())) {
+        warnln("Failed to write {}: {}", profile_path, file_or_error.value()->error_string());
+    } else {
+        warnln("Wrote {} samples to {}", profiler.sample_count(), profile_path);
+    }
+
+    warn("{}", profiler.to_statistics_table());
+}
+
 static bool parse_and_run(JS::Interpreter& interpreter, const StringView& source)
 {
     auto parser = JS::Parser(JS::Lexer(source));
@@ -713,15 +731,19 @@ public:
 int main(int argc, char** argv)
 {
     bool gc_on_every_allocation = false;
+    bool print_gc_statistics = false;
     bool disable_syntax_highlight = false;
     const char* script_path = nullptr;
+    const char* profile_path = nullptr;
 
     Core::ArgsParser args_parser;
     args_parser.set_general_help("This is a JavaScript interpreter.");
     args_parser.add_option(s_dump_ast, "Dump the AST", "dump-ast", 'A');
     args_parser.add_option(s_print_last_result, "Print last result", "print-last-result", 'l');
     args_parser.add_option(gc_on_every_allocation, "GC on every allocation", "gc-on-every-allocation", 'g');
+    args_parser.add_option(print_gc_statistics, "Print GC statistics on exit", "gc-statistics", 'G');
     args_parser.add_option(disable_syntax_highlight, "Disable live syntax highlighting", "no-syntax-highlight", 's');
+    args_parser.add_option(profile_path, "Profile the script and write the samples to the given file", "profile", 'p', "path");
     args_parser.add_positional_argument(script_path, "Path to script file", "script", Core::ArgsParser::Required::No);
     args_parser.parse(argc, argv);
 
@@ -750,6 +772,11 @@ int main(int argc, char** argv)
     };
     OwnPtr<JS::Interpreter> interpreter;
 
+    if (profile_path) {
+        vm->set_profiler(make<JS::Profiler>(*vm));
+        vm->profiler()->start();
+    }
+
     interrupt_interpreter = [&] {
         auto error = JS::Error::create(interpreter->global_object(), "Received SIGINT");
         vm->throw_exception(interpreter->global_object(), error);
@@ -958,6 +985,8 @@ int main(int argc, char** argv)
         s_editor->on_tab_complete = move(complete);
         repl(*interpreter);
         s_editor->save_history(s_history_path);
+        if (profile_path)
+            write_profile(profile_path);
     } else {
         interpreter = JS::Interpreter::create<JS::GlobalObject>(*vm);
         ReplConsoleClient console_client(interpreter->global_object().console());
@@ -982,9 +1011,17 @@ int main(int argc, char** argv)
             source = file_contents;
         }
 
-        if (!parse_and_run(*interpreter, source))
+        bool success = parse_and_run(*interpreter, source);
+        if (profile_path)
+            write_profile(profile_path);
+        if (print_gc_statistics)
+            interpreter->heap().dump_statistics();
+        if (!success)
             return 1;
+        return 0;
     }
 
+    if (print_gc_statistics)
+        interpreter->heap().dump_statistics();
     return 0;
 }
@@ -16,7 +16,9 @@
 #include <LibJS/Interpreter.h>
 #include <LibJS/Lexer.h>
 #include <LibJS/Parser.h>
+#include <LibJS/Profiler.h>
 #include <LibJS/Runtime/Array.h>
+#include <LibJS/Runtime/Error.h>
 #include <LibJS/Runtime/GlobalObject.h>
 #include <LibJS/Runtime/JSONObject.h>
 #include <LibTest/Results.h>
@@ -30,6 +32,7 @@
 RefPtr<JS::VM> vm;
 
 static bool collect_on_every_allocation = false;
+static bool lazy_function_parsing = false;
 static String currently_running_test;
 
 struct ParserError {
@@ -61,6 +64,8 @@ private:
     JS_DECLARE_NATIVE_FUNCTION(is_strict_mode);
     JS_DECLARE_NATIVE_FUNCTION(can_parse_source);
     JS_DECLARE_NATIVE_FUNCTION(run_queued_promise_jobs);
+    JS_DECLARE_NATIVE_FUNCTION(evaluate_with_lazy_function_parsing);
+    JS_DECLARE_NATIVE_FUNCTION(profile);
 };
 
 class TestRunner {
@@ -82,6 +87,7 @@ public:
     virtual ~TestRunner() = default;
 
     void run();
+    void run_parse_benchmark() const;
 
     const Test::Counts& counts() const { return m_counts; }
 
@@ -122,10 +128,14 @@ void TestRunnerGlobalObject::initialize_global_object()
     static FlyString is_strict_mode_property_name { "isStrictMode" };
     static FlyString can_parse_source_property_name { "canParseSource" };
     static FlyString run_queued_promise_jobs_property_name { "runQueuedPromiseJobs" };
+    static FlyString evaluate_with_lazy_function_parsing_property_name { "evaluateWithLazyFunctionParsing" };
+    static FlyString profile_property_name { "profile" };
     define_property(global_property_name, this, JS::Attribute::Enumerable);
     define_native_function(is_strict_mode_property_name, is_strict_mode);
     define_native_function(can_parse_source_property_name, can_parse_source);
     define_native_function(run_queued_promise_jobs_property_name, run_queued_promise_jobs);
+    define_native_function(evaluate_with_lazy_function_parsing_property_name, evaluate_with_lazy_function_parsing);
+    define_native_function(profile_property_name, profile, 1);
 }
 
 JS_DEFINE_NATIVE_FUNCTION(TestRunnerGlobalObject::is_strict_mode)
@@ -149,6 +159,57 @@ JS_DEFINE_NATIVE_FUNCTION(TestRunnerGlobalObject::run_queued_promise_jobs)
     return JS::js_undefined();
 }
 
+JS_DEFINE_NATIVE_FUNCTION(TestRunnerGlobalObject::evaluate_with_lazy_function_parsing)
+{
+    auto source = vm.argument(0).to_string(global_object);
+    if (vm.exception())
+        return {};
+    auto parser = JS::Parser(JS::Lexer(source));
+    parser.set_lazy_function_parsing_enabled(true);
+    auto program = parser.parse_program();
+    if (parser.has_errors()) {
+        vm.throw_exception<JS::SyntaxError>(global_object, parser.errors()[0].to_string());
+        return {};
+    }
+    vm.interpreter().run(global_object, *program);
+    if (vm.exception())
+        return {};
+    return vm.last_value();
+}
+
+// Calls the given function with the profiler running, and returns the function statistics it recorded.
+JS_DEFINE_NATIVE_FUNCTION(TestRunnerGlobalObject::profile)
+{
+    auto callback = vm.argument(0);
+    if (!callback.is_function()) {
+        vm.throw_exception<JS::TypeError>(global_object, JS::ErrorType::NotAFunction, callback.to_string_without_side_effects());
+        return {};
+    }
+    if (vm.profiler()) {
+        vm.throw_exception<JS::Error>(global_object, "The profiler is already running");
+        return {};
+    }
+
+    vm.set_profiler(make<JS::Profiler>(vm));
+    vm.profiler()->start();
+    (void)vm.call(callback.as_function(), JS::js_undefined());
+    vm.profiler()->stop();
+    if (vm.exception()) {
+        vm.set_profiler({});
+        return {};
+    }
+
+    auto* result = JS::Array::create(global_object);
+    vm.profiler()->for_each_function_statistics([&](auto& name, auto call_count) {
+        auto* entry = JS::Object::create_empty(global_object);
+        entry->define_property("name", JS::js_string(vm, name));
+        entry->define_property("callCount", JS::Value(static_cast<double>(call_count)));
+        result->indexed_properties().append(entry);
+    });
+    vm.set_profiler({});
+    return result;
+}
+
 static void cleanup_and_exit()
 {
     // Clear the taskbar progress.
@@ -190,8 +251,12 @@ Vector<String> TestRunner::get_test_paths() const
 {
     Vector<String> paths;
     iterate_directory_recursively(m_test_root, [&](const String& file_path) {
-        if (!file_path.ends_with("test-common.js"))
-            paths.append(file_path);
+        if (file_path.ends_with("test-common.js"))
+            return;
+        // Benchmarks are standalone scripts meant to be run with js(1), not tests.
+        if (file_path.contains("/benchmarks/"))
+            return;
+        paths.append(file_path);
     });
     quick_sort(paths);
     return paths;
@@ -214,7 +279,7 @@ void TestRunner::run()
     print_test_results();
 }
 
-static Result<NonnullRefPtr<JS::Program>, ParserError> parse_file(const String& file_path)
+static String read_file(const String& file_path)
 {
     auto file = Core::File::construct(file_path);
     auto result = file->open(Core::IODevice::ReadOnly);
@@ -224,10 +289,15 @@ static Result<NonnullRefPtr<JS::Program>, ParserError> parse_file(const String&
     }
 
     auto contents = file->read_all();
-    String test_file_string(reinterpret_cast<const char*>(contents.data()), contents.size());
     file->close();
+    return String(reinterpret_cast<const char*>(contents.data()), contents.size());
+}
 
+static Result<NonnullRefPtr<JS::Program>, ParserError> parse_file(const String& file_path)
+{
+    auto test_file_string = read_file(file_path);
     auto parser = JS::Parser(JS::Lexer(test_file_string));
+    parser.set_lazy_function_parsing_enabled(lazy_function_parsing);
     auto program = parser.parse_program();
 
     if (parser.has_errors()) {
@@ -238,6 +308,40 @@ static Result<NonnullRefPtr<JS::Program>, ParserError> parse_file(const String&
     return Result<NonnullRefPtr<JS::Program>, ParserError>(program);
 }
 
+void TestRunner::run_parse_benchmark() const
+{
+    constexpr int iterations = 10;
+
+    auto time_parse = [&](const String& source, bool lazy_function_parsing) {
+        double start_time = get_time_in_ms();
+        for (int i = 0; i < iterations; ++i) {
+            auto parser = JS::Parser(JS::Lexer(source));
+            parser.set_lazy_function_parsing_enabled(lazy_function_parsing);
+            parser.parse_program();
+        }
+        return (get_time_in_ms() - start_time) / iterations;
+    };
+
+    double total_eager_time = 0;
+    double total_lazy_time = 0;
+    size_t total_size = 0;
+    auto test_paths = get_test_paths();
+    for (auto& path : test_paths) {
+        auto source = read_file(path);
+        auto eager_time = time_parse(source, false);
+        auto lazy_time = time_parse(source, true);
+        if (m_print_times)
+            outln("{}: {:.3}ms eager, {:.3}ms lazy", path.substring_view(m_test_root.length() + 1), eager_time, lazy_time);
+        total_eager_time += eager_time;
+        total_lazy_time += lazy_time;
+        total_size += source.length();
+    }
+
+    outln("Parsed {} files ({} bytes), average of {} runs each", test_paths.size(), total_size, iterations);
+    outln("Eager function parsing: {:.3}ms", total_eager_time);
+    outln("Lazy function parsing:  {:.3}ms", total_lazy_time);
+}
+
 static Optional<JsonValue> get_test_results(JS::Interpreter& interpreter)
 {
     auto result = vm->get_variable("__TestResults__", interpreter.global_object());
@@ -677,6 +781,7 @@ int main(int argc, char** argv)
         false;
 #endif
     bool test262_parser_tests = false;
+    bool parse_benchmark = false;
     const char* specified_test_root = nullptr;
 
     Core::ArgsParser args_parser;
@@ -697,7 +802,9 @@ int main(int argc, char** argv)
         },
     });
     args_parser.add_option(collect_on_every_allocation, "Collect garbage after every allocation", "collect-often", 'g');
+    args_parser.add_option(lazy_function_parsing, "Parse function bodies of the test files lazily", "lazy-function-parsing", 'l');
     args_parser.add_option(test262_parser_tests, "Run test262 parser tests", "test262-parser-tests", 0);
+    args_parser.add_option(parse_benchmark, "Measure parse times of the test files with eager and lazy function parsing", "parse-benchmark", 0);
     args_parser.add_positional_argument(specified_test_root, "Tests root directory", "path", Core::ArgsParser::Required::No);
     args_parser.parse(argc, argv);
 
@@ -706,6 +813,10 @@ int main(int argc, char** argv)
             warnln("--collect-often and --test262-parser-tests options must not be used together");
             return 1;
         }
+        if (lazy_function_parsing) {
+            warnln("--lazy-function-parsing and --test262-parser-tests options must not be used together");
+            return 1;
+        }
         if (!specified_test_root) {
             warnln("Test root is required with --test262-parser-tests");
             return 1;
@@ -739,6 +850,11 @@ int main(int argc, char** argv)
 
     vm = JS::VM::create();
 
+    if (parse_benchmark) {
+        TestRunner(test_root, print_times, print_progress).run_parse_benchmark();
+        return 0;
+    }
+
     if (test262_parser_tests)
         Test262ParserTestRunner(test_root, print_times, print_progress).run();
     else